@@ -55,6 +55,7 @@ int main(int argc, char *argv[])
     hwAlarmInit();
     hwRadioInit();
     hwRandomInit();
+    hwSettingsInit();
 
     otInit();
     sCliServer.Start();
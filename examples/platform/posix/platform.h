@@ -59,6 +59,12 @@ void hwRadioInit(void);
  */
 void hwRandomInit(void);
 
+/**
+ * This method initializes the settings service used by OpenThread.
+ *
+ */
+void hwSettingsInit(void);
+
 /**
  * This method puts the thread executing OpenThread to sleep.
  *
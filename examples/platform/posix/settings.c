@@ -0,0 +1,263 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the settings service with a file per node.
+ *
+ *   Settings are kept in RAM as a sequence of records, each made of a 16-bit key, a 16-bit value length and the
+ *   value, and the whole sequence is written back to the file on every change.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <platform/posix/cmdline.h>
+
+#include <common/code_utils.hpp>
+#include <platform/settings.h>
+
+#define SETTINGS_DIRECTORY    "tmp"
+#define SETTINGS_BUFFER_SIZE  8192
+
+extern struct gengetopt_args_info args_info;
+
+struct settings_record
+{
+    uint16_t key;
+    uint16_t length;
+};
+
+static uint8_t s_settings[SETTINGS_BUFFER_SIZE];
+static uint16_t s_settings_length = 0;
+static char s_file_name[64];
+
+static void write_settings(void)
+{
+    char temp_name[sizeof(s_file_name) + 4];
+    FILE *file;
+    bool ok;
+
+    VerifyOrExit(s_file_name[0] != '\0', ;);
+
+    snprintf(temp_name, sizeof(temp_name), "%s.new", s_file_name);
+    VerifyOrExit((file = fopen(temp_name, "wb")) != NULL, ;);
+
+    ok = fwrite(s_settings, 1, s_settings_length, file) == s_settings_length;
+    ok = (fclose(file) == 0) && ok;
+
+    if (ok)
+    {
+        rename(temp_name, s_file_name);
+    }
+
+exit:
+    return;
+}
+
+static int find_setting(uint16_t key, int index)
+{
+    struct settings_record record;
+    int offset = 0;
+
+    while (offset < s_settings_length)
+    {
+        memcpy(&record, s_settings + offset, sizeof(record));
+
+        if (record.key == key && index-- == 0)
+        {
+            return offset;
+        }
+
+        offset += sizeof(record) + record.length;
+    }
+
+    return -1;
+}
+
+static void remove_setting(int offset)
+{
+    struct settings_record record;
+    int length;
+
+    memcpy(&record, s_settings + offset, sizeof(record));
+    length = sizeof(record) + record.length;
+
+    memmove(s_settings + offset, s_settings + offset + length, s_settings_length - offset - length);
+    s_settings_length -= length;
+}
+
+static ThreadError add_setting(uint16_t key, const uint8_t *value, uint16_t value_length)
+{
+    ThreadError error = kThreadError_None;
+    struct settings_record record;
+
+    VerifyOrExit(s_settings_length + sizeof(record) + value_length <= sizeof(s_settings), error = kThreadError_NoBufs);
+
+    record.key = key;
+    record.length = value_length;
+    memcpy(s_settings + s_settings_length, &record, sizeof(record));
+    memcpy(s_settings + s_settings_length + sizeof(record), value, value_length);
+    s_settings_length += sizeof(record) + value_length;
+
+exit:
+    return error;
+}
+
+void hwSettingsInit(void)
+{
+    struct settings_record record;
+    FILE *file;
+    size_t length;
+    int offset = 0;
+
+    VerifyOrExit(mkdir(SETTINGS_DIRECTORY, 0777) == 0 || errno == EEXIST, ;);
+
+    snprintf(s_file_name, sizeof(s_file_name), SETTINGS_DIRECTORY "/%d.settings", args_info.nodeid_arg);
+    VerifyOrExit((file = fopen(s_file_name, "rb")) != NULL, ;);
+
+    length = fread(s_settings, 1, sizeof(s_settings), file);
+    fclose(file);
+
+    // keep the complete records only
+    while (offset + sizeof(record) <= length)
+    {
+        memcpy(&record, s_settings + offset, sizeof(record));
+
+        if (offset + sizeof(record) + record.length > length)
+        {
+            break;
+        }
+
+        offset += sizeof(record) + record.length;
+    }
+
+    s_settings_length = offset;
+
+exit:
+    return;
+}
+
+ThreadError otPlatSettingsGet(uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength)
+{
+    ThreadError error = kThreadError_None;
+    struct settings_record record;
+    int offset;
+
+    VerifyOrExit((offset = find_setting(aKey, aIndex)) >= 0, error = kThreadError_NotFound);
+
+    memcpy(&record, s_settings + offset, sizeof(record));
+
+    if (aValue != NULL)
+    {
+        memcpy(aValue, s_settings + offset + sizeof(record),
+               record.length < *aValueLength ? record.length : *aValueLength);
+    }
+
+    *aValueLength = record.length;
+
+exit:
+    return error;
+}
+
+ThreadError otPlatSettingsSet(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    ThreadError error = kThreadError_None;
+    struct settings_record record;
+    int replaced_length = 0;
+    int index = 0;
+    int offset;
+
+    // the old values are only removed once the new value is known to fit
+    while ((offset = find_setting(aKey, index++)) >= 0)
+    {
+        memcpy(&record, s_settings + offset, sizeof(record));
+        replaced_length += sizeof(record) + record.length;
+    }
+
+    VerifyOrExit(s_settings_length - replaced_length + sizeof(record) + aValueLength <= sizeof(s_settings),
+                 error = kThreadError_NoBufs);
+
+    while ((offset = find_setting(aKey, 0)) >= 0)
+    {
+        remove_setting(offset);
+    }
+
+    SuccessOrExit(error = add_setting(aKey, aValue, aValueLength));
+    write_settings();
+
+exit:
+    return error;
+}
+
+ThreadError otPlatSettingsAdd(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+{
+    ThreadError error;
+
+    SuccessOrExit(error = add_setting(aKey, aValue, aValueLength));
+    write_settings();
+
+exit:
+    return error;
+}
+
+ThreadError otPlatSettingsDelete(uint16_t aKey, int aIndex)
+{
+    ThreadError error = kThreadError_None;
+    int offset;
+
+    if (aIndex < 0)
+    {
+        VerifyOrExit(find_setting(aKey, 0) >= 0, error = kThreadError_NotFound);
+
+        while ((offset = find_setting(aKey, 0)) >= 0)
+        {
+            remove_setting(offset);
+        }
+    }
+    else
+    {
+        VerifyOrExit((offset = find_setting(aKey, aIndex)) >= 0, error = kThreadError_NotFound);
+
+        remove_setting(offset);
+    }
+
+    write_settings();
+
+exit:
+    return error;
+}
+
+void otPlatSettingsWipe(void)
+{
+    s_settings_length = 0;
+    write_settings();
+}
@@ -62,6 +62,7 @@ typedef enum ThreadError
     kThreadError_NotImplemented = 13,
     kThreadError_InvalidState = 14,
     kThreadError_NoTasklets = 15,
+    kThreadError_NotFound = 16,
     kThreadError_Error = 255,
 } ThreadError;
 
@@ -108,6 +109,53 @@ typedef struct otActiveScanResult
     bool           mIsJoinable : 1;  ///< Joining Permitted flag
 } otActiveScanResult;
 
+/**
+ * This structure represents the link quality estimate for a neighbor.
+ *
+ */
+typedef struct otLinkQualityInfo
+{
+    uint8_t        mAverageLinkMargin;  ///< Exponentially weighted average of the received link margin (dB)
+    uint8_t        mLinkQualityIn;      ///< Link quality in (0-3)
+    uint16_t       mTxFailureRate;      ///< Average MAC ACK failure rate (0xffff when every transmission fails)
+    uint16_t       mLinkMarginSamples;  ///< Number of received frames sampled
+    uint16_t       mTxAttempts;         ///< Number of transmissions that requested a MAC ACK
+    uint16_t       mTxFailures;         ///< Number of transmissions that were not acknowledged
+} otLinkQualityInfo;
+
+/**
+ * This structure represents the Data Poll counters of a sleepy end device.
+ *
+ */
+typedef struct otDataPollCounters
+{
+    uint32_t       mPolls;        ///< Number of Data Polls sent
+    uint32_t       mWastedPolls;  ///< Number of Data Polls that were not followed by any frame from the parent
+} otDataPollCounters;
+
+/**
+ * This structure represents the Leader's Server Data registration counters.
+ *
+ */
+typedef struct otNetworkDataCounters
+{
+    uint32_t       mRegistrations;           ///< Number of registrations that changed the Network Data
+    uint32_t       mVersionBumps;            ///< Number of Network Data version increments
+    uint32_t       mSuppressedVersionBumps;  ///< Number of version increments skipped for unchanged Network Data
+} otNetworkDataCounters;
+
+/**
+ * This structure represents the MPL forwarding counters.
+ *
+ */
+typedef struct otMplCounters
+{
+    uint32_t       mReceivedMessages;  ///< Number of new MPL Data Messages accepted for delivery and forwarding
+    uint32_t       mRetransmissions;   ///< Number of trickle retransmissions of buffered MPL Data Messages
+    uint32_t       mDuplicateDrops;    ///< Number of MPL Data Messages dropped as duplicates
+    uint32_t       mSeedSetEvictions;  ///< Number of live MPL Seed Set entries evicted for a new seed
+} otMplCounters;
+
 /**
  * @addtogroup config  Configuration
  *
@@ -109,6 +109,9 @@ extern "C" {
 
 /**
  * Initialize the OpenThread library.
+ *
+ * Network information saved in non-volatile memory by a previous run is restored, so that the next call to
+ * otEnable() resumes the previous role.  Configuration set after this call takes precedence.
  */
 void otInit();
 
@@ -160,6 +163,17 @@ ThreadError otEnable(void);
  */
 ThreadError otDisable(void);
 
+/**
+ * Erase the network information saved in non-volatile memory.
+ *
+ * The configuration in use is kept until the next restart, which then starts from factory settings.
+ *
+ * @retval kThreadError_None          Successfully erased the network information.
+ * @retval kThreadError_InvalidState  The Thread interface is enabled.
+ *
+ */
+ThreadError otErasePersistentInfo(void);
+
 /**
  * This function pointer is called during an IEEE 802.15.4 Active Scan when an IEEE 802.15.4 Beacon is received or
  * the scan completes.
@@ -251,6 +265,28 @@ uint32_t otGetChildTimeout(void);
  */
 void otSetChildTimeout(uint32_t aTimeout);
 
+/**
+ * Get the fast Data Poll period used by a sleepy end device.
+ *
+ * @returns The fast Data Poll period in milliseconds.
+ *
+ * @sa otSetFastPollPeriod
+ */
+uint32_t otGetFastPollPeriod(void);
+
+/**
+ * Set the fast Data Poll period used by a sleepy end device.
+ *
+ * After a frame is sent, the parent is polled at this period and the period doubles after every poll that
+ * brings no data until it reaches the regular Data Poll period.  Polling returns to the regular Data Poll period as
+ * soon as a frame without the Frame Pending bit is received.
+ *
+ * @param[in]  aPeriod  The fast Data Poll period in milliseconds, zero always polls at the regular Data Poll period.
+ *
+ * @sa otGetFastPollPeriod
+ */
+void otSetFastPollPeriod(uint32_t aPeriod);
+
 /**
  * Get the IEEE 802.15.4 Extended Address.
  *
@@ -421,6 +457,37 @@ uint8_t otGetLocalLeaderWeight(void);
  */
 void otSetLocalLeaderWeight(uint8_t aWeight);
 
+/**
+ * Get the window during which the Leader coalesces Server Data registrations.
+ *
+ * @returns The coalescing window in milliseconds.
+ *
+ * @sa otSetNetworkDataCoalesceWindow
+ */
+uint32_t otGetNetworkDataCoalesceWindow(void);
+
+/**
+ * Set the window during which the Leader coalesces Server Data registrations.
+ *
+ * Registrations received within the window are applied with a single Network Data version increment.
+ *
+ * @param[in]  aWindow  The coalescing window in milliseconds (0 applies each registration immediately).
+ *
+ * @sa otGetNetworkDataCoalesceWindow
+ */
+void otSetNetworkDataCoalesceWindow(uint32_t aWindow);
+
+/**
+ * Get the Leader's Server Data registration counters.
+ *
+ * The number of registrations per version increment shows how well the coalescing window batches registrations.
+ *
+ * @param[out]  aCounters  A pointer to where the registration counters are placed.
+ *
+ * @sa otSetNetworkDataCoalesceWindow
+ */
+void otGetNetworkDataCounters(otNetworkDataCounters *aCounters);
+
 /**
  * @}
  */
@@ -789,6 +856,31 @@ uint8_t otGetRouterIdSequence();
  */
 uint8_t otGetStableNetworkDataVersion();
 
+/**
+ * Get the link quality estimate for a neighbor.
+ *
+ * @param[in]   aExtAddr      A pointer to the IEEE 802.15.4 Extended Address of the neighbor.
+ * @param[out]  aLinkQuality  A pointer to where the link quality estimate is placed.
+ *
+ * @retval kThreadError_None         Successfully retrieved the link quality estimate.
+ * @retval kThreadError_InvalidArgs  @p aExtAddr is not a neighbor.
+ */
+ThreadError otGetNeighborLinkQuality(const uint8_t *aExtAddr, otLinkQualityInfo *aLinkQuality);
+
+/**
+ * Get the Data Poll counters.
+ *
+ * @param[out]  aCounters  A pointer to where the Data Poll counters are placed.
+ */
+void otGetDataPollCounters(otDataPollCounters *aCounters);
+
+/**
+ * Get the MPL forwarding counters.
+ *
+ * @param[out]  aCounters  A pointer to where the MPL counters are placed.
+ */
+void otGetMplCounters(otMplCounters *aCounters);
+
 /**
  * @}
  *
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   This file includes the platform abstraction for non-volatile storage of settings.
+ */
+
+#ifndef SETTINGS_H_
+#define SETTINGS_H_
+
+#include <stdint.h>
+
+#include <openthread-types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup settings Settings
+ * @ingroup platform
+ *
+ * @brief
+ *   This module includes the platform abstraction for non-volatile storage of settings.
+ *
+ * Settings are opaque values identified by a 16-bit key.  A key may hold more than one value, in which case the
+ * values are addressed by their index in the order they were added.  Settings must survive a reset of the device.
+ *
+ * @{
+ *
+ */
+
+/**
+ * Get the value of a setting.
+ *
+ * @param[in]     aKey          The key of the setting.
+ * @param[in]     aIndex        The index of the value to get, for keys that hold more than one value.
+ * @param[out]    aValue        A pointer to where the value is copied.  May be NULL to only get the length.
+ * @param[inout]  aValueLength  On entry, the size of the @p aValue buffer.  On exit, the length of the value, which
+ *                              may be larger than the number of bytes copied.
+ *
+ * @retval kThreadError_None      Successfully retrieved the value.
+ * @retval kThreadError_NotFound  The key does not hold a value at @p aIndex.
+ *
+ */
+ThreadError otPlatSettingsGet(uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength);
+
+/**
+ * Set the value of a setting, replacing all values held by the key.
+ *
+ * @param[in]  aKey          The key of the setting.
+ * @param[in]  aValue        A pointer to the value.
+ * @param[in]  aValueLength  The length of the value in bytes.
+ *
+ * @retval kThreadError_None    Successfully stored the value.
+ * @retval kThreadError_NoBufs  Not enough space to store the value.  The values held by the key are kept.
+ *
+ */
+ThreadError otPlatSettingsSet(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength);
+
+/**
+ * Add a value to a setting, keeping the values already held by the key.
+ *
+ * @param[in]  aKey          The key of the setting.
+ * @param[in]  aValue        A pointer to the value.
+ * @param[in]  aValueLength  The length of the value in bytes.
+ *
+ * @retval kThreadError_None    Successfully stored the value.
+ * @retval kThreadError_NoBufs  Not enough space to store the value.
+ *
+ */
+ThreadError otPlatSettingsAdd(uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength);
+
+/**
+ * Delete a value of a setting.
+ *
+ * The index of the values added after the deleted value decreases by one.
+ *
+ * @param[in]  aKey    The key of the setting.
+ * @param[in]  aIndex  The index of the value to delete, or -1 to delete all values held by the key.
+ *
+ * @retval kThreadError_None      Successfully deleted the value.
+ * @retval kThreadError_NotFound  The key does not hold a value at @p aIndex.
+ *
+ */
+ThreadError otPlatSettingsDelete(uint16_t aKey, int aIndex);
+
+/**
+ * Delete all settings.
+ *
+ */
+void otPlatSettingsWipe(void);
+
+/**
+ * @}
+ *
+ */
+
+#ifdef __cplusplus
+}  // end of extern "C"
+#endif
+
+#endif  // SETTINGS_H_
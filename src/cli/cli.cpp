@@ -54,16 +54,23 @@ const struct Command Interpreter::sCommands[] =
     { "contextreusedelay", &ProcessContextIdReuseDelay },
     { "extaddr", &ProcessExtAddress },
     { "extpanid", &ProcessExtPanId },
+    { "factoryreset", &ProcessFactoryReset },
+    { "fastpollperiod", &ProcessFastPollPeriod },
     { "ipaddr", &ProcessIpAddr },
     { "keysequence", &ProcessKeySequence },
     { "leaderweight", &ProcessLeaderWeight },
+    { "linkquality", &ProcessLinkQuality },
     { "masterkey", &ProcessMasterKey },
     { "mode", &ProcessMode },
+    { "mplcounters", &ProcessMplCounters },
+    { "netdatacoalesce", &ProcessNetworkDataCoalesce },
+    { "netdatacounters", &ProcessNetworkDataCounters },
     { "netdataregister", &ProcessNetworkDataRegister },
     { "networkidtimeout", &ProcessNetworkIdTimeout },
     { "networkname", &ProcessNetworkName },
     { "panid", &ProcessPanId },
     { "ping", &ProcessPing },
+    { "pollcounters", &ProcessPollCounters },
     { "prefix", &ProcessPrefix },
     { "releaserouterid", &ProcessReleaseRouterId },
     { "rloc16", &ProcessRloc16 },
@@ -244,6 +251,16 @@ exit:
     return;
 }
 
+void Interpreter::ProcessFactoryReset(int argc, char *argv[])
+{
+    SuccessOrExit(otDisable());
+    SuccessOrExit(otErasePersistentInfo());
+    sResponse.Append("Done\r\n");
+
+exit:
+    return;
+}
+
 ThreadError Interpreter::ProcessIpAddrAdd(int argc, char *argv[])
 {
     ThreadError error;
@@ -275,6 +292,26 @@ exit:
     return error;
 }
 
+void Interpreter::ProcessFastPollPeriod(int argc, char *argv[])
+{
+    long value;
+
+    if (argc == 0)
+    {
+        sResponse.Append("%d\r\n", otGetFastPollPeriod());
+    }
+    else
+    {
+        SuccessOrExit(ParseLong(argv[0], value));
+        otSetFastPollPeriod(value);
+    }
+
+    sResponse.Append("Done\r\n");
+
+exit:
+    return;
+}
+
 void Interpreter::ProcessIpAddr(int argc, char *argv[])
 {
     if (argc == 0)
@@ -346,6 +383,26 @@ exit:
     return;
 }
 
+void Interpreter::ProcessLinkQuality(int argc, char *argv[])
+{
+    uint8_t extAddr[8];
+    otLinkQualityInfo linkQuality;
+
+    VerifyOrExit(argc > 0, ;);
+    VerifyOrExit(Hex2Bin(argv[0], extAddr, sizeof(extAddr)) == sizeof(extAddr), ;);
+    SuccessOrExit(otGetNeighborLinkQuality(extAddr, &linkQuality));
+
+    sResponse.Append("Link Quality In: %d\r\n", linkQuality.mLinkQualityIn);
+    sResponse.Append("Average Link Margin: %d dB (%d samples)\r\n", linkQuality.mAverageLinkMargin,
+                     linkQuality.mLinkMarginSamples);
+    sResponse.Append("Tx Failures: %d of %d (average rate %d/65535)\r\n", linkQuality.mTxFailures,
+                     linkQuality.mTxAttempts, linkQuality.mTxFailureRate);
+    sResponse.Append("Done\r\n");
+
+exit:
+    return;
+}
+
 void Interpreter::ProcessMasterKey(int argc, char *argv[])
 {
     uint8_t keyLength;
@@ -441,6 +498,57 @@ exit:
     return;
 }
 
+void Interpreter::ProcessMplCounters(int argc, char *argv[])
+{
+    otMplCounters counters;
+
+    otGetMplCounters(&counters);
+    sResponse.Append("Received: %d\r\n", counters.mReceivedMessages);
+    sResponse.Append("Retransmissions: %d\r\n", counters.mRetransmissions);
+    sResponse.Append("Duplicate Drops: %d\r\n", counters.mDuplicateDrops);
+    sResponse.Append("Seed Set Evictions: %d\r\n", counters.mSeedSetEvictions);
+    sResponse.Append("Done\r\n");
+}
+
+void Interpreter::ProcessNetworkDataCoalesce(int argc, char *argv[])
+{
+    long value;
+
+    if (argc == 0)
+    {
+        sResponse.Append("%d\r\n", otGetNetworkDataCoalesceWindow());
+    }
+    else
+    {
+        SuccessOrExit(ParseLong(argv[0], value));
+        otSetNetworkDataCoalesceWindow(value);
+    }
+
+    sResponse.Append("Done\r\n");
+
+exit:
+    return;
+}
+
+void Interpreter::ProcessNetworkDataCounters(int argc, char *argv[])
+{
+    otNetworkDataCounters counters;
+    uint32_t perBump = 0;
+
+    otGetNetworkDataCounters(&counters);
+
+    if (counters.mVersionBumps > 0)
+    {
+        perBump = counters.mRegistrations * 100 / counters.mVersionBumps;
+    }
+
+    sResponse.Append("Registrations: %d\r\n", counters.mRegistrations);
+    sResponse.Append("Version Bumps: %d\r\n", counters.mVersionBumps);
+    sResponse.Append("Suppressed Version Bumps: %d\r\n", counters.mSuppressedVersionBumps);
+    sResponse.Append("Registrations per Bump: %d.%02d\r\n", perBump / 100, perBump % 100);
+    sResponse.Append("Done\r\n");
+}
+
 void Interpreter::ProcessNetworkDataRegister(int argc, char *argv[])
 {
     SuccessOrExit(otSendServerData());
@@ -548,6 +656,16 @@ exit:
     return;
 }
 
+void Interpreter::ProcessPollCounters(int argc, char *argv[])
+{
+    otDataPollCounters counters;
+
+    otGetDataPollCounters(&counters);
+    sResponse.Append("Polls: %d\r\n", counters.mPolls);
+    sResponse.Append("Wasted Polls: %d\r\n", counters.mWastedPolls);
+    sResponse.Append("Done\r\n");
+}
+
 ThreadError Interpreter::ProcessPrefixAdd(int argc, char *argv[])
 {
     ThreadError error = kThreadError_None;
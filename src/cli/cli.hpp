@@ -138,18 +138,25 @@ private:
     static void ProcessContextIdReuseDelay(int argc, char *argv[]);
     static void ProcessExtAddress(int argc, char *argv[]);
     static void ProcessExtPanId(int argc, char *argv[]);
+    static void ProcessFactoryReset(int argc, char *argv[]);
+    static void ProcessFastPollPeriod(int argc, char *argv[]);
     static void ProcessIpAddr(int argc, char *argv[]);
     static ThreadError ProcessIpAddrAdd(int argc, char *argv[]);
     static ThreadError ProcessIpAddrDel(int argc, char *argv[]);
     static void ProcessKeySequence(int argc, char *argv[]);
     static void ProcessLeaderWeight(int argc, char *argv[]);
+    static void ProcessLinkQuality(int argc, char *argv[]);
     static void ProcessMasterKey(int argc, char *argv[]);
     static void ProcessMode(int argc, char *argv[]);
+    static void ProcessMplCounters(int argc, char *argv[]);
+    static void ProcessNetworkDataCoalesce(int argc, char *argv[]);
+    static void ProcessNetworkDataCounters(int argc, char *argv[]);
     static void ProcessNetworkDataRegister(int argc, char *argv[]);
     static void ProcessNetworkIdTimeout(int argc, char *argv[]);
     static void ProcessNetworkName(int argc, char *argv[]);
     static void ProcessPanId(int argc, char *argv[]);
     static void ProcessPing(int argc, char *argv[]);
+    static void ProcessPollCounters(int argc, char *argv[]);
     static void ProcessPrefix(int argc, char *argv[]);
     static ThreadError ProcessPrefixAdd(int argc, char *argv[]);
     static ThreadError ProcessPrefixRemove(int argc, char *argv[]);
@@ -47,6 +47,18 @@ static Buffer sBuffers[kNumBuffers];
 static Buffer *sFreeBuffers;
 static MessageList sAll;
 
+#if OPENTHREAD_CONFIG_MAX_CHILDREN > 64
+enum
+{
+    kNumChildMasks    = OPENTHREAD_CONFIG_NUM_CHILD_MASKS,
+    kChildSetNone     = 0,       ///< No child is scheduled.
+    kChildSetMaskFlag = 0x8000,  ///< The low bits hold a child mask index, otherwise the child index + 1.
+};
+
+static uint8_t sChildMasks[kNumChildMasks][kChildMaskSize];
+static bool sChildMaskAllocated[kNumChildMasks];
+#endif  // OPENTHREAD_CONFIG_MAX_CHILDREN > 64
+
 Buffer *NewBuffer(void)
 {
     Buffer *buffer = NULL;
@@ -95,6 +107,10 @@ ThreadError Message::Init(void)
     sBuffers[kNumBuffers - 1].SetNextBuffer(NULL);
     sNumFreeBuffers = kNumBuffers;
 
+#if OPENTHREAD_CONFIG_MAX_CHILDREN > 64
+    memset(sChildMaskAllocated, 0, sizeof(sChildMaskAllocated));
+#endif
+
     return kThreadError_None;
 }
 
@@ -118,9 +134,24 @@ ThreadError Message::Free(Message &aMessage)
 {
     assert(aMessage.GetMessageList(MessageInfo::kListAll).mList == NULL &&
            aMessage.GetMessageList(MessageInfo::kListInterface).mList == NULL);
+
+#if OPENTHREAD_CONFIG_MAX_CHILDREN > 64
+
+    if (aMessage.mInfo.mChildSet & kChildSetMaskFlag)
+    {
+        sChildMaskAllocated[aMessage.mInfo.mChildSet & ~kChildSetMaskFlag] = false;
+    }
+
+#endif
+
     return FreeBuffers(reinterpret_cast<Buffer *>(&aMessage));
 }
 
+int Message::GetFreeBufferCount(void)
+{
+    return sNumFreeBuffers;
+}
+
 ThreadError Message::ResizeMessage(uint16_t aLength)
 {
     // add buffers
@@ -449,22 +480,25 @@ void Message::SetTimeout(uint8_t aTimeout)
     mInfo.mTimeout = aTimeout;
 }
 
-bool Message::GetChildMask(uint8_t aChildIndex) const
+#if OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+
+bool Message::GetChildMask(uint16_t aChildIndex) const
 {
-    assert(aChildIndex < sizeof(mInfo.mChildMask) * 8);
+    assert(aChildIndex < OPENTHREAD_CONFIG_MAX_CHILDREN);
     return (mInfo.mChildMask[aChildIndex / 8] & (0x80 >> (aChildIndex % 8))) != 0;
 }
 
-void Message::ClearChildMask(uint8_t aChildIndex)
+void Message::ClearChildMask(uint16_t aChildIndex)
 {
-    assert(aChildIndex < sizeof(mInfo.mChildMask) * 8);
+    assert(aChildIndex < OPENTHREAD_CONFIG_MAX_CHILDREN);
     mInfo.mChildMask[aChildIndex / 8] &= ~(0x80 >> (aChildIndex % 8));
 }
 
-void Message::SetChildMask(uint8_t aChildIndex)
+ThreadError Message::SetChildMask(uint16_t aChildIndex)
 {
-    assert(aChildIndex < sizeof(mInfo.mChildMask) * 8);
+    assert(aChildIndex < OPENTHREAD_CONFIG_MAX_CHILDREN);
     mInfo.mChildMask[aChildIndex / 8] |= 0x80 >> (aChildIndex % 8);
+    return kThreadError_None;
 }
 
 bool Message::IsChildPending(void) const
@@ -483,6 +517,109 @@ exit:
     return rval;
 }
 
+#else  // OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+
+bool Message::GetChildMask(uint16_t aChildIndex) const
+{
+    const uint8_t *mask;
+
+    assert(aChildIndex < OPENTHREAD_CONFIG_MAX_CHILDREN);
+
+    if ((mInfo.mChildSet & kChildSetMaskFlag) == 0)
+    {
+        return mInfo.mChildSet == aChildIndex + 1;
+    }
+
+    mask = sChildMasks[mInfo.mChildSet & ~kChildSetMaskFlag];
+    return (mask[aChildIndex / 8] & (0x80 >> (aChildIndex % 8))) != 0;
+}
+
+void Message::ClearChildMask(uint16_t aChildIndex)
+{
+    uint8_t maskIndex;
+    uint8_t *mask;
+
+    assert(aChildIndex < OPENTHREAD_CONFIG_MAX_CHILDREN);
+
+    if ((mInfo.mChildSet & kChildSetMaskFlag) == 0)
+    {
+        if (mInfo.mChildSet == aChildIndex + 1)
+        {
+            mInfo.mChildSet = kChildSetNone;
+        }
+
+        ExitNow();
+    }
+
+    maskIndex = mInfo.mChildSet & ~kChildSetMaskFlag;
+    mask = sChildMasks[maskIndex];
+    mask[aChildIndex / 8] &= ~(0x80 >> (aChildIndex % 8));
+
+    for (int i = 0; i < kChildMaskSize; i++)
+    {
+        VerifyOrExit(mask[i] == 0, ;);
+    }
+
+    sChildMaskAllocated[maskIndex] = false;
+    mInfo.mChildSet = kChildSetNone;
+
+exit:
+    return;
+}
+
+ThreadError Message::SetChildMask(uint16_t aChildIndex)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t childIndex;
+    uint8_t maskIndex;
+    uint8_t *mask;
+
+    assert(aChildIndex < OPENTHREAD_CONFIG_MAX_CHILDREN);
+
+    if (mInfo.mChildSet == kChildSetNone)
+    {
+        mInfo.mChildSet = aChildIndex + 1;
+        ExitNow();
+    }
+
+    if ((mInfo.mChildSet & kChildSetMaskFlag) == 0)
+    {
+        // a second child needs a mask from the pool
+        VerifyOrExit(mInfo.mChildSet != aChildIndex + 1, ;);
+
+        for (maskIndex = 0; maskIndex < kNumChildMasks; maskIndex++)
+        {
+            if (!sChildMaskAllocated[maskIndex])
+            {
+                break;
+            }
+        }
+
+        VerifyOrExit(maskIndex < kNumChildMasks, error = kThreadError_NoBufs);
+
+        childIndex = mInfo.mChildSet - 1;
+        mask = sChildMasks[maskIndex];
+        memset(mask, 0, kChildMaskSize);
+        mask[childIndex / 8] |= 0x80 >> (childIndex % 8);
+
+        sChildMaskAllocated[maskIndex] = true;
+        mInfo.mChildSet = kChildSetMaskFlag | maskIndex;
+    }
+
+    mask = sChildMasks[mInfo.mChildSet & ~kChildSetMaskFlag];
+    mask[aChildIndex / 8] |= 0x80 >> (aChildIndex % 8);
+
+exit:
+    return error;
+}
+
+bool Message::IsChildPending(void) const
+{
+    return mInfo.mChildSet != kChildSetNone;
+}
+
+#endif  // OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+
 bool Message::GetDirectTransmission(void) const
 {
     return mInfo.mDirectTx;
@@ -56,8 +56,9 @@ namespace Thread {
 
 enum
 {
-    kNumBuffers = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS,
-    kBufferSize = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE,
+    kNumBuffers    = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS,
+    kBufferSize    = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE,
+    kChildMaskSize = (OPENTHREAD_CONFIG_MAX_CHILDREN + 7) / 8,
 };
 
 class Message;
@@ -110,7 +111,11 @@ struct MessageInfo
     uint16_t         mDatagramTag;   ///< The datagram tag used for 6LoWPAN fragmentation.
     uint8_t          mTimeout;       ///< Seconds remaining before dropping the message.
 
-    uint8_t          mChildMask[8];  ///< A bit-vector to indicate which sleepy children need to receive this message.
+#if OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+    uint8_t          mChildMask[kChildMaskSize];  ///< A bit-vector to indicate which sleepy children need to receive this message.
+#else
+    uint16_t         mChildSet;      ///< The sleepy child, or pooled child mask, scheduled to receive this message.
+#endif
 
     uint8_t          mType : 2;      ///< Identifies the type of message.
     bool             mDirectTx : 1;  ///< Used to indicate whether a direct transmission is required.
@@ -375,7 +380,7 @@ public:
      * @retval FALSE  If the message is not scheduled to be forwarded to the child.
      *
      */
-    bool GetChildMask(uint8_t aChildIndex) const;
+    bool GetChildMask(uint16_t aChildIndex) const;
 
     /**
      * This method unschedules forwarding of the message to the child.
@@ -383,15 +388,23 @@ public:
      * @param[in]  aChildIndex  The index into the child table.
      *
      */
-    void ClearChildMask(uint8_t aChildIndex);
+    void ClearChildMask(uint16_t aChildIndex);
 
     /**
      * This method schedules forwarding of the message to the child.
      *
+     * When OPENTHREAD_CONFIG_MAX_CHILDREN is 64 or less, the message holds a mask of every child and this method
+     * always succeeds.  Otherwise, a message scheduled for a single child records the child inline, and scheduling a
+     * message for more than one child requires a child mask from a shared pool of OPENTHREAD_CONFIG_NUM_CHILD_MASKS
+     * entries.
+     *
      * @param[in]  aChildIndex  The index into the child table.
      *
+     * @retval kThreadError_None    Successfully scheduled forwarding to the child.
+     * @retval kThreadError_NoBufs  No child mask was available.
+     *
      */
-    void SetChildMask(uint8_t aChildIndex);
+    ThreadError SetChildMask(uint16_t aChildIndex);
 
     /**
      * This method returns whether or not the message forwarding is scheduled for at least one child.
@@ -463,6 +476,14 @@ public:
      */
     static ThreadError Free(Message &aMessage);
 
+    /**
+     * This static method returns the number of free buffers in the buffer pool.
+     *
+     * @returns The number of free message buffers.
+     *
+     */
+    static int GetFreeBufferCount(void);
+
 private:
     /**
      * This method returns a reference to a message list.
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the keys of the settings stored in non-volatile memory.
+ */
+
+#ifndef SETTINGS_HPP_
+#define SETTINGS_HPP_
+
+#include <stdint.h>
+
+namespace Thread {
+namespace Settings {
+
+/**
+ * @addtogroup core-settings
+ *
+ * @brief
+ *   This module includes definitions for the keys of the settings stored in non-volatile memory.
+ *
+ * @{
+ *
+ */
+
+/**
+ * Keys of the settings stored in non-volatile memory.
+ *
+ */
+enum Key
+{
+    kKeyNetworkInfo      = 0x0001,  ///< Network information: state, addresses, credentials and frame counters.
+    kKeyParentInfo       = 0x0002,  ///< Parent information, stored while attached as a child.
+    kKeyChildInfo        = 0x0003,  ///< Child information, one value per attached child.
+    kKeyParentCandidates = 0x0004,  ///< Previous parents, tried first when re-attaching.
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Settings
+}  // namespace Thread
+
+#endif  // SETTINGS_HPP_
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file implements the single-pass TLV index.
+ */
+
+#include <common/code_utils.hpp>
+#include <common/encoding.hpp>
+#include <common/tlv_index.hpp>
+
+using Thread::Encoding::BigEndian::HostSwap16;
+
+namespace Thread {
+
+void TlvIndex::Init(const Message &aMessage)
+{
+    Format format = {false, 0};
+
+    Init(aMessage, format);
+}
+
+void TlvIndex::Init(const Message &aMessage, uint8_t aExtendedType)
+{
+    Format format = {true, aExtendedType};
+
+    Init(aMessage, format);
+}
+
+void TlvIndex::Init(const Message &aMessage, const Format &aFormat)
+{
+    uint16_t offset = aMessage.GetOffset();
+    uint8_t type;
+    uint16_t valueOffset;
+    uint16_t length;
+    uint8_t i;
+
+    mMessage = &aMessage;
+    mFormat = aFormat;
+    mNumEntries = 0;
+
+    while (Parse(aMessage, aFormat, offset, type, valueOffset, length) == kThreadError_None)
+    {
+        for (i = 0; i < mNumEntries; i++)
+        {
+            if (mEntries[i].mType == type)
+            {
+                break;
+            }
+        }
+
+        if (i == mNumEntries)
+        {
+            // remaining TLVs are located by scanning from mEndOffset
+            VerifyOrExit(mNumEntries < kMaxEntries, ;);
+
+            mEntries[i].mOffset = offset;
+            mEntries[i].mValueOffset = valueOffset;
+            mEntries[i].mLength = length;
+            mEntries[i].mType = type;
+            mNumEntries++;
+        }
+
+        offset = valueOffset + length;
+    }
+
+exit:
+    mEndOffset = offset;
+}
+
+ThreadError TlvIndex::Find(uint8_t aType, uint16_t &aOffset, uint16_t &aValueOffset, uint16_t &aLength) const
+{
+    for (uint8_t i = 0; i < mNumEntries; i++)
+    {
+        if (mEntries[i].mType == aType)
+        {
+            aOffset = mEntries[i].mOffset;
+            aValueOffset = mEntries[i].mValueOffset;
+            aLength = mEntries[i].mLength;
+            return kThreadError_None;
+        }
+    }
+
+    return Scan(*mMessage, mFormat, mEndOffset, aType, aOffset, aValueOffset, aLength);
+}
+
+ThreadError TlvIndex::Find(const Message &aMessage, uint8_t aType, uint16_t &aOffset, uint16_t &aValueOffset,
+                           uint16_t &aLength)
+{
+    Format format = {false, 0};
+
+    return Scan(aMessage, format, aMessage.GetOffset(), aType, aOffset, aValueOffset, aLength);
+}
+
+ThreadError TlvIndex::Find(const Message &aMessage, uint8_t aType, uint8_t aExtendedType, uint16_t &aOffset,
+                           uint16_t &aValueOffset, uint16_t &aLength)
+{
+    Format format = {true, aExtendedType};
+
+    return Scan(aMessage, format, aMessage.GetOffset(), aType, aOffset, aValueOffset, aLength);
+}
+
+ThreadError TlvIndex::Scan(const Message &aMessage, const Format &aFormat, uint16_t aOffset, uint8_t aType,
+                           uint16_t &aTlvOffset, uint16_t &aValueOffset, uint16_t &aLength)
+{
+    ThreadError error;
+    uint8_t type;
+
+    while ((error = Parse(aMessage, aFormat, aOffset, type, aValueOffset, aLength)) == kThreadError_None)
+    {
+        if (type == aType)
+        {
+            aTlvOffset = aOffset;
+            break;
+        }
+
+        aOffset = aValueOffset + aLength;
+    }
+
+    return error;
+}
+
+ThreadError TlvIndex::Parse(const Message &aMessage, const Format &aFormat, uint16_t aOffset, uint8_t &aType,
+                            uint16_t &aValueOffset, uint16_t &aLength)
+{
+    ThreadError error = kThreadError_Parse;
+    uint8_t header[2];
+    uint16_t end = aMessage.GetLength();
+
+    VerifyOrExit(aMessage.Read(aOffset, sizeof(header), header) == sizeof(header), ;);
+
+    aType = header[0];
+    aLength = header[1];
+    aValueOffset = aOffset + sizeof(header);
+
+    if (aLength == kExtendedLength && aFormat.mExtended && aType == aFormat.mExtendedType)
+    {
+        VerifyOrExit(aMessage.Read(aValueOffset, sizeof(aLength), &aLength) == sizeof(aLength), ;);
+        aLength = HostSwap16(aLength);
+        aValueOffset += sizeof(aLength);
+    }
+
+    VerifyOrExit(aValueOffset <= end && aLength <= end - aValueOffset, ;);
+    error = kThreadError_None;
+
+exit:
+    return error;
+}
+
+}  // namespace Thread
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * @file
+ *   This file includes definitions for indexing the TLVs contained in a message.
+ */
+
+#ifndef TLV_INDEX_HPP_
+#define TLV_INDEX_HPP_
+
+#include <openthread-types.h>
+#include <common/message.hpp>
+
+namespace Thread {
+
+/**
+ * @addtogroup core-tlv-index
+ *
+ * @brief
+ *   This module includes definitions for indexing the TLVs contained in a message.
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements a single-pass index of the TLVs contained in a message.
+ *
+ * The index maps each TLV Type to the first TLV of that Type, starting at the message offset.  It supports the
+ * one-byte Type and Length format shared by MLE and Thread Network Layer TLVs.  Optionally, TLVs of a single Type may
+ * use the extended Length format, where a Length of 255 is followed by a 16-bit Length.
+ *
+ */
+class TlvIndex
+{
+public:
+    /**
+     * This method indexes the TLVs in @p aMessage, from the message offset to the end of the message.
+     *
+     * The message must not be modified while the index is in use.  A Length of 255 is a one-byte Length.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     *
+     */
+    void Init(const Message &aMessage);
+
+    /**
+     * This method indexes the TLVs in @p aMessage, allowing TLVs of Type @p aExtendedType to use the extended Length
+     * format.
+     *
+     * The message must not be modified while the index is in use.
+     *
+     * @param[in]  aMessage       A reference to the message.
+     * @param[in]  aExtendedType  The Type value whose Length of 255 is followed by a 16-bit Length.
+     *
+     */
+    void Init(const Message &aMessage, uint8_t aExtendedType);
+
+    /**
+     * This method returns a reference to the indexed message.
+     *
+     * @returns A reference to the indexed message.
+     *
+     */
+    const Message &GetMessage(void) const { return *mMessage; }
+
+    /**
+     * This method locates the first TLV with Type @p aType.
+     *
+     * @param[in]   aType         The Type value to search for.
+     * @param[out]  aOffset       The offset of the TLV in the message.
+     * @param[out]  aValueOffset  The offset of the TLV Value in the message.
+     * @param[out]  aLength       The length of the TLV Value in bytes.
+     *
+     * @retval kThreadError_None   Successfully located the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    ThreadError Find(uint8_t aType, uint16_t &aOffset, uint16_t &aValueOffset, uint16_t &aLength) const;
+
+    /**
+     * This static method locates the first TLV with Type @p aType in @p aMessage without building an index.
+     *
+     * @param[in]   aMessage      A reference to the message.
+     * @param[in]   aType         The Type value to search for.
+     * @param[out]  aOffset       The offset of the TLV in the message.
+     * @param[out]  aValueOffset  The offset of the TLV Value in the message.
+     * @param[out]  aLength       The length of the TLV Value in bytes.
+     *
+     * @retval kThreadError_None   Successfully located the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    static ThreadError Find(const Message &aMessage, uint8_t aType, uint16_t &aOffset, uint16_t &aValueOffset,
+                            uint16_t &aLength);
+
+    /**
+     * This static method locates the first TLV with Type @p aType in @p aMessage without building an index, allowing
+     * TLVs of Type @p aExtendedType to use the extended Length format.
+     *
+     * @param[in]   aMessage       A reference to the message.
+     * @param[in]   aType          The Type value to search for.
+     * @param[in]   aExtendedType  The Type value whose Length of 255 is followed by a 16-bit Length.
+     * @param[out]  aOffset        The offset of the TLV in the message.
+     * @param[out]  aValueOffset   The offset of the TLV Value in the message.
+     * @param[out]  aLength        The length of the TLV Value in bytes.
+     *
+     * @retval kThreadError_None   Successfully located the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    static ThreadError Find(const Message &aMessage, uint8_t aType, uint8_t aExtendedType, uint16_t &aOffset,
+                            uint16_t &aValueOffset, uint16_t &aLength);
+
+private:
+    enum
+    {
+        kMaxEntries     = 16,
+        kExtendedLength = 255,
+    };
+
+    struct Format
+    {
+        bool mExtended;         ///< TRUE if TLVs of mExtendedType may use the extended Length format.
+        uint8_t mExtendedType;  ///< The Type value allowed to use the extended Length format.
+    };
+
+    struct Entry
+    {
+        uint16_t mOffset;
+        uint16_t mValueOffset;
+        uint16_t mLength;
+        uint8_t  mType;
+    };
+
+    void Init(const Message &aMessage, const Format &aFormat);
+    static ThreadError Parse(const Message &aMessage, const Format &aFormat, uint16_t aOffset, uint8_t &aType,
+                             uint16_t &aValueOffset, uint16_t &aLength);
+    static ThreadError Scan(const Message &aMessage, const Format &aFormat, uint16_t aOffset, uint8_t aType,
+                            uint16_t &aTlvOffset, uint16_t &aValueOffset, uint16_t &aLength);
+
+    const Message *mMessage;
+    Format mFormat;
+    Entry mEntries[kMaxEntries];
+    uint8_t mNumEntries;
+    uint16_t mEndOffset;
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Thread
+
+#endif  // TLV_INDEX_HPP_
@@ -248,6 +248,17 @@ const ExtAddress *Mac::GetExtAddress(void) const
     return &mExtAddress;
 }
 
+ThreadError Mac::SetExtAddress(const ExtAddress &aExtAddress)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(mState == kStateDisabled, error = kThreadError_InvalidState);
+    mExtAddress = aExtAddress;
+
+exit:
+    return error;
+}
+
 ShortAddress Mac::GetShortAddress(void) const
 {
     return mShortAddress;
@@ -441,8 +452,9 @@ void Mac::HandleBeginTransmit(void *aContext)
     obj->HandleBeginTransmit();
 }
 
-void Mac::ProcessTransmitSecurity(void)
+ThreadError Mac::ProcessTransmitSecurity(void)
 {
+    ThreadError error = kThreadError_None;
     uint8_t securityLevel;
     uint8_t nonce[kNonceSize];
     uint8_t tagLength;
@@ -453,6 +465,8 @@ void Mac::ProcessTransmitSecurity(void)
         ExitNow();
     }
 
+    SuccessOrExit(error = mKeyManager.CheckMacFrameCounter());
+
     mSendFrame.GetSecurityLevel(securityLevel);
     mSendFrame.SetFrameCounter(mKeyManager.GetMacFrameCounter());
 
@@ -473,7 +487,7 @@ void Mac::ProcessTransmitSecurity(void)
     mKeyManager.IncrementMacFrameCounter();
 
 exit:
-    {}
+    return error;
 }
 
 void Mac::HandleBeginTransmit(void)
@@ -512,7 +526,24 @@ void Mac::HandleBeginTransmit(void)
     }
 
     // Security Processing
-    ProcessTransmitSecurity();
+    if (ProcessTransmitSecurity() != kThreadError_None)
+    {
+        // the frame counter is not reserved yet, try again once the frame counters are saved
+        if (mCsmaAttempts < kMaxCSMABackoffs)
+        {
+            mCsmaAttempts++;
+            StartCsmaBackoff();
+        }
+        else
+        {
+            otLogWarnMac("Dropped frame, frame counters could not be saved\n");
+            mCsmaAttempts = 0;
+            HandleSentData();
+        }
+
+        NextOperation();
+        ExitNow();
+    }
 
     SuccessOrExit(error = otPlatRadioTransmit(&mSendFrame));
 
@@ -652,7 +683,6 @@ void Mac::SentFrame(bool aAcked)
 {
     Address destination;
     Neighbor *neighbor;
-    Sender *sender;
 
     switch (mState)
     {
@@ -665,39 +695,37 @@ void Mac::SentFrame(bool aAcked)
         break;
 
     case kStateTransmitData:
-        if (mSendFrame.GetAckRequest() && !aAcked)
+        if (mSendFrame.GetAckRequest())
         {
-            otDumpDebgMac("NO ACK", mSendFrame.GetHeader(), 16);
+            mSendFrame.GetDstAddr(destination);
 
-            if (mCsmaAttempts < kMaxCSMABackoffs)
+            if ((neighbor = mMle.GetNeighbor(destination)) != NULL)
             {
-                mCsmaAttempts++;
-                StartCsmaBackoff();
-                ExitNow();
+                neighbor->mLinkInfo.AddTxResult(aAcked);
             }
 
-            mSendFrame.GetDstAddr(destination);
-
-            if ((neighbor = mMle.GetNeighbor(destination)) != NULL)
+            if (!aAcked)
             {
-                neighbor->mState = Neighbor::kStateInvalid;
+                otDumpDebgMac("NO ACK", mSendFrame.GetHeader(), 16);
+
+                if (mCsmaAttempts < kMaxCSMABackoffs)
+                {
+                    mCsmaAttempts++;
+                    StartCsmaBackoff();
+                    ExitNow();
+                }
+
+                if (neighbor != NULL)
+                {
+                    neighbor->mState = Neighbor::kStateInvalid;
+                    mMle.SetRouteTlvDirty();
+                }
             }
         }
 
         mCsmaAttempts = 0;
-
-        sender = mSendHead;
-        mSendHead = mSendHead->mNext;
-
-        if (mSendHead == NULL)
-        {
-            mSendTail = NULL;
-        }
-
         mDataSequence++;
-        sender->HandleSentFrame(mSendFrame);
-
-        ScheduleNextTransmission();
+        HandleSentData();
         break;
 
     default:
@@ -709,6 +737,22 @@ exit:
     {}
 }
 
+void Mac::HandleSentData(void)
+{
+    Sender *sender = mSendHead;
+
+    mSendHead = mSendHead->mNext;
+
+    if (mSendHead == NULL)
+    {
+        mSendTail = NULL;
+    }
+
+    sender->HandleSentFrame(mSendFrame);
+
+    ScheduleNextTransmission();
+}
+
 ThreadError Mac::ProcessReceiveSecurity(const Address &aSrcAddr, Neighbor *aNeighbor)
 {
     ThreadError error = kThreadError_None;
@@ -878,6 +922,11 @@ void Mac::ReceiveDoneTask(void)
     // Security Processing
     SuccessOrExit(ProcessReceiveSecurity(srcaddr, neighbor));
 
+    if (neighbor != NULL)
+    {
+        neighbor->mLinkInfo.AddRss(mReceiveFrame.GetPower());
+    }
+
     switch (mState)
     {
     case kStateActiveScan:
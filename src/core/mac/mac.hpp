@@ -271,6 +271,19 @@ public:
      */
     const ExtAddress *GetExtAddress(void) const;
 
+    /**
+     * This method sets the IEEE 802.15.4 Extended Address.
+     *
+     * The address is passed to the radio when the MAC is started.
+     *
+     * @param[in]  aExtAddress  A reference to the IEEE 802.15.4 Extended Address.
+     *
+     * @retval kThreadError_None          Successfully set the IEEE 802.15.4 Extended Address.
+     * @retval kThreadError_InvalidState  The MAC is not disabled.
+     *
+     */
+    ThreadError SetExtAddress(const ExtAddress &aExtAddress);
+
     /**
      * This method returns the IEEE 802.15.4 Short Address.
      *
@@ -394,10 +407,11 @@ public:
 private:
     void GenerateNonce(const ExtAddress &aAddress, uint32_t aFrameCounter, uint8_t aSecurityLevel, uint8_t *aNonce);
     void NextOperation(void);
-    void ProcessTransmitSecurity(void);
+    ThreadError ProcessTransmitSecurity(void);
     ThreadError ProcessReceiveSecurity(const Address &aSrcAddr, Neighbor *aNeighbor);
     void ScheduleNextTransmission(void);
     void SentFrame(bool aAcked);
+    void HandleSentData(void);
     void SendBeaconRequest(Frame &aFrame);
     void SendBeacon(Frame &aFrame);
     void StartBackoff(void);
@@ -99,6 +99,16 @@ void Ip6::SetNcpReceivedHandler(NcpReceivedDatagramHandler handler, void *contex
     sNcpReceivedHandlerContext = context;
 }
 
+void Ip6::SetMplTimerExpirations(uint8_t timerExpirations)
+{
+    sMpl.SetTimerExpirations(timerExpirations);
+}
+
+const Mpl &Ip6::GetMpl(void)
+{
+    return sMpl;
+}
+
 ThreadError AddMplOption(Message &message, Header &header, IpProto nextHeader, uint16_t payloadLength)
 {
     ThreadError error = kThreadError_None;
@@ -409,6 +419,13 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, uint8_t interfac
         {
             hopLimit = header.GetHopLimit();
             message.Write(Header::GetHopLimitOffset(), Header::GetHopLimitSize(), &hopLimit);
+
+            if (header.GetDestination().IsMulticast())
+            {
+                // schedule MPL retransmissions
+                sMpl.AddBufferedMessage(message, messageInfo.mInterfaceId);
+            }
+
             SuccessOrExit(ForwardMessage(message, messageInfo));
             ExitNow(error = kThreadError_None);
         }
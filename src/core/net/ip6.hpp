@@ -461,6 +461,8 @@ private:
     uint32_t mIdentification;
 } __attribute__((packed));
 
+class Mpl;
+
 /**
  * This class implements the core IPv6 message processing.
  *
@@ -580,6 +582,23 @@ public:
      */
     static void SetNcpReceivedHandler(NcpReceivedDatagramHandler aHandler, void *aContext);
 
+    /**
+     * This static method sets the number of trickle intervals over which forwarded MPL Data Messages are
+     * retransmitted.
+     *
+     * @param[in]  aTimerExpirations  The number of trickle timer expirations, zero disables retransmissions.
+     *
+     */
+    static void SetMplTimerExpirations(uint8_t aTimerExpirations);
+
+    /**
+     * This static method returns a reference to the MPL object.
+     *
+     * @returns A reference to the MPL object.
+     *
+     */
+    static const Mpl &GetMpl(void);
+
 };
 
 /**
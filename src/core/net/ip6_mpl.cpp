@@ -34,15 +34,35 @@
 #include <common/code_utils.hpp>
 #include <common/message.hpp>
 #include <net/ip6_mpl.hpp>
+#include <net/netif.hpp>
+#include <platform/random.h>
 
 namespace Thread {
 namespace Ip6 {
 
 Mpl::Mpl():
-    mTimer(&HandleTimer, this)
+    mRetransmissionTimer(&HandleRetransmissionTimer, this)
 {
     memset(mEntries, 0, sizeof(mEntries));
+    memset(mBuckets, kInvalidIndex, sizeof(mBuckets));
+
+    // all entries start out unused on the LRU list
+    for (int i = 0; i < kNumEntries; i++)
+    {
+        mEntries[i].mNext = kInvalidIndex;
+        mEntries[i].mLruPrev = (i > 0) ? i - 1 : kInvalidIndex;
+        mEntries[i].mLruNext = (i < kNumEntries - 1) ? i + 1 : kInvalidIndex;
+    }
+
+    mLruHead = 0;
+    mLruTail = kNumEntries - 1;
     mSequence = 0;
+    mTimerExpirations = 0;
+    mNumBufferedMessages = 0;
+    mSeedSetEvictions = 0;
+    mDuplicateDrops = 0;
+    mReceivedMessages = 0;
+    mRetransmissions = 0;
 }
 
 void Mpl::InitOption(OptionMpl &aOption, uint16_t aSeed)
@@ -56,68 +76,375 @@ void Mpl::InitOption(OptionMpl &aOption, uint16_t aSeed)
 ThreadError Mpl::ProcessOption(const Message &aMessage)
 {
     ThreadError error = kThreadError_None;
+    uint32_t now = Timer::GetNow();
     OptionMpl option;
-    MplEntry *entry = NULL;
+    MplEntry *entry;
+    uint8_t index;
     int8_t diff;
 
     VerifyOrExit(aMessage.Read(aMessage.GetOffset(), sizeof(option), &option) == sizeof(option) &&
                  option.GetLength() == sizeof(OptionMpl) - sizeof(OptionHeader),
                  error = kThreadError_Drop);
 
-    for (int i = 0; i < kNumEntries; i++)
+    index = FindEntry(option.GetSeed());
+
+    if (index == kInvalidIndex)
+    {
+        index = NewEntry(option.GetSeed());
+    }
+    else if (now - mEntries[index].mTimestamp < Timer::SecToMsec(kLifetime))
+    {
+        entry = &mEntries[index];
+        diff = option.GetSequence() - entry->mSequence;
+
+        if (diff <= 0)
+        {
+            if (diff == 0)
+            {
+                HandleConsistentMessage(entry->mSeed, entry->mSequence);
+            }
+
+            mDuplicateDrops++;
+            ExitNow(error = kThreadError_Drop);
+        }
+    }
+
+    // a new or expired entry accepts any sequence from the seed
+    entry = &mEntries[index];
+    entry->mSequence = option.GetSequence();
+    entry->mTimestamp = now;
+    MoveToLruHead(index);
+    mReceivedMessages++;
+
+exit:
+    return error;
+}
+
+uint8_t Mpl::FindEntry(uint16_t aSeed) const
+{
+    uint8_t index;
+
+    for (index = mBuckets[GetBucket(aSeed)]; index != kInvalidIndex; index = mEntries[index].mNext)
     {
-        if (mEntries[i].mLifetime == 0)
+        if (mEntries[index].mSeed == aSeed)
         {
-            entry = &mEntries[i];
+            break;
         }
-        else if (mEntries[i].mSeed == option.GetSeed())
+    }
+
+    return index;
+}
+
+uint8_t Mpl::NewEntry(uint16_t aSeed)
+{
+    uint8_t index = mLruTail;
+    MplEntry *entry = &mEntries[index];
+    uint8_t bucket = GetBucket(aSeed);
+
+    // reuse the least recently heard entry
+    if (entry->mValid)
+    {
+        if (Timer::GetNow() - entry->mTimestamp < Timer::SecToMsec(kLifetime))
         {
-            entry = &mEntries[i];
-            diff = option.GetSequence() - entry->mSequence;
+            mSeedSetEvictions++;
+        }
+
+        RemoveFromBucket(index);
+    }
+
+    entry->mSeed = aSeed;
+    entry->mValid = true;
+    entry->mNext = mBuckets[bucket];
+    mBuckets[bucket] = index;
+
+    return index;
+}
 
-            if (diff <= 0)
+void Mpl::RemoveFromBucket(uint8_t aIndex)
+{
+    uint8_t *link = &mBuckets[GetBucket(mEntries[aIndex].mSeed)];
+
+    while (*link != aIndex)
+    {
+        link = &mEntries[*link].mNext;
+    }
+
+    *link = mEntries[aIndex].mNext;
+    mEntries[aIndex].mNext = kInvalidIndex;
+    mEntries[aIndex].mValid = false;
+}
+
+void Mpl::MoveToLruHead(uint8_t aIndex)
+{
+    MplEntry *entry = &mEntries[aIndex];
+
+    VerifyOrExit(aIndex != mLruHead, ;);
+
+    // unlink
+    mEntries[entry->mLruPrev].mLruNext = entry->mLruNext;
+
+    if (entry->mLruNext != kInvalidIndex)
+    {
+        mEntries[entry->mLruNext].mLruPrev = entry->mLruPrev;
+    }
+    else
+    {
+        mLruTail = entry->mLruPrev;
+    }
+
+    // insert at head
+    entry->mLruPrev = kInvalidIndex;
+    entry->mLruNext = mLruHead;
+    mEntries[mLruHead].mLruPrev = aIndex;
+    mLruHead = aIndex;
+
+exit:
+    return;
+}
+
+ThreadError Mpl::AddBufferedMessage(Message &aMessage, uint8_t aInterfaceId)
+{
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
+    OptionMpl option;
+    BufferedMessageMetadata metadata;
+    uint16_t length = aMessage.GetLength();
+
+    VerifyOrExit(mTimerExpirations > 0, error = kThreadError_Drop);
+    SuccessOrExit(error = FindOption(aMessage, option));
+
+    if (mNumBufferedMessages >= kNumBufferedMessages)
+    {
+        // evict the oldest buffered message
+        RemoveBufferedMessage(*mBufferedMessageSet.GetHead());
+    }
+
+    // leave enough buffers in the pool for regular traffic
+    VerifyOrExit(Message::GetFreeBufferCount() >= kMinFreeBuffers, error = kThreadError_NoBufs);
+
+    VerifyOrExit((message = Message::New(Message::kTypeIp6, 0)) != NULL, error = kThreadError_NoBufs);
+    SuccessOrExit(error = message->SetLength(length + sizeof(metadata)));
+    aMessage.CopyTo(0, 0, length, *message);
+
+    memset(&metadata, 0, sizeof(metadata));
+    metadata.mSeed = option.GetSeed();
+    metadata.mSequence = option.GetSequence();
+    metadata.mInterfaceId = aInterfaceId;
+    metadata.mInterval = kDataMessageIntervalMin;
+    StartInterval(metadata, Timer::GetNow());
+
+    // the datagram is transmitted as it is forwarded, covering the first interval
+    metadata.mTransmissionPending = false;
+
+    WriteMetadata(*message, metadata);
+    mBufferedMessageSet.Enqueue(*message);
+    mNumBufferedMessages++;
+
+    ScheduleRetransmissionTimer();
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        Message::Free(*message);
+    }
+
+    return error;
+}
+
+ThreadError Mpl::FindOption(const Message &aMessage, OptionMpl &aOption)
+{
+    ThreadError error = kThreadError_None;
+    Header header;
+    HopByHopHeader hbhHeader;
+    OptionHeader optionHeader;
+    uint16_t offset;
+    uint16_t endOffset;
+
+    VerifyOrExit(aMessage.Read(0, sizeof(header), &header) == sizeof(header) &&
+                 header.GetNextHeader() == kProtoHopOpts, error = kThreadError_Drop);
+
+    offset = sizeof(header);
+    VerifyOrExit(aMessage.Read(offset, sizeof(hbhHeader), &hbhHeader) == sizeof(hbhHeader),
+                 error = kThreadError_Drop);
+    endOffset = offset + (hbhHeader.GetLength() + 1) * 8;
+    offset += sizeof(hbhHeader);
+
+    while (offset < endOffset)
+    {
+        VerifyOrExit(aMessage.Read(offset, sizeof(optionHeader), &optionHeader) == sizeof(optionHeader),
+                     error = kThreadError_Drop);
+
+        if (optionHeader.GetType() == OptionMpl::kType)
+        {
+            VerifyOrExit(aMessage.Read(offset, sizeof(aOption), &aOption) == sizeof(aOption),
+                         error = kThreadError_Drop);
+            ExitNow();
+        }
+
+        offset += sizeof(optionHeader) + optionHeader.GetLength();
+    }
+
+    ExitNow(error = kThreadError_Drop);
+
+exit:
+    return error;
+}
+
+void Mpl::ReadMetadata(const Message &aMessage, BufferedMessageMetadata &aMetadata)
+{
+    aMessage.Read(aMessage.GetLength() - sizeof(aMetadata), sizeof(aMetadata), &aMetadata);
+}
+
+void Mpl::WriteMetadata(Message &aMessage, const BufferedMessageMetadata &aMetadata)
+{
+    aMessage.Write(aMessage.GetLength() - sizeof(aMetadata), sizeof(aMetadata), &aMetadata);
+}
+
+void Mpl::StartInterval(BufferedMessageMetadata &aMetadata, uint32_t aNow)
+{
+    // transmit at a random time within the second half of the interval
+    aMetadata.mIntervalEnd = aNow + aMetadata.mInterval;
+    aMetadata.mTransmissionTime = aNow + aMetadata.mInterval / 2 +
+                                  otPlatRandomGet() % (aMetadata.mInterval / 2 + 1);
+    aMetadata.mCounter = 0;
+    aMetadata.mTransmissionPending = true;
+}
+
+void Mpl::HandleConsistentMessage(uint16_t aSeed, uint8_t aSequence)
+{
+    BufferedMessageMetadata metadata;
+
+    for (Message *message = mBufferedMessageSet.GetHead(); message; message = message->GetNext())
+    {
+        ReadMetadata(*message, metadata);
+
+        if (metadata.mSeed == aSeed && metadata.mSequence == aSequence)
+        {
+            if (metadata.mCounter < 0xff)
             {
-                error = kThreadError_Drop;
+                metadata.mCounter++;
             }
 
+            WriteMetadata(*message, metadata);
             break;
         }
     }
+}
 
-    VerifyOrExit(entry != NULL, error = kThreadError_Drop);
+void Mpl::RemoveBufferedMessage(Message &aMessage)
+{
+    mBufferedMessageSet.Dequeue(aMessage);
+    Message::Free(aMessage);
+    mNumBufferedMessages--;
+}
 
-    entry->mSeed = option.GetSeed();
-    entry->mSequence = option.GetSequence();
-    entry->mLifetime = kLifetime;
-    mTimer.Start(1000);
+void Mpl::TransmitBufferedMessage(Message &aMessage, const BufferedMessageMetadata &aMetadata)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t length = aMessage.GetLength() - sizeof(aMetadata);
+    Message *message = NULL;
+    Netif *netif;
+
+    VerifyOrExit((netif = Netif::GetNetifById(aMetadata.mInterfaceId)) != NULL, error = kThreadError_NoRoute);
+    VerifyOrExit((message = Message::New(Message::kTypeIp6, 0)) != NULL, error = kThreadError_NoBufs);
+    SuccessOrExit(error = message->SetLength(length));
+    aMessage.CopyTo(0, 0, length, *message);
+    SuccessOrExit(error = netif->SendMessage(*message));
+    mRetransmissions++;
 
 exit:
-    return error;
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        Message::Free(*message);
+    }
 }
 
-void Mpl::HandleTimer(void *aContext)
+void Mpl::ScheduleRetransmissionTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t nextTime = 0;
+    uint32_t eventTime;
+    bool found = false;
+    BufferedMessageMetadata metadata;
+
+    for (Message *message = mBufferedMessageSet.GetHead(); message; message = message->GetNext())
+    {
+        ReadMetadata(*message, metadata);
+        eventTime = metadata.mTransmissionPending ? metadata.mTransmissionTime : metadata.mIntervalEnd;
+
+        if (!found || static_cast<int32_t>(eventTime - nextTime) < 0)
+        {
+            nextTime = eventTime;
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        mRetransmissionTimer.Stop();
+    }
+    else if (static_cast<int32_t>(nextTime - now) > 0)
+    {
+        mRetransmissionTimer.StartAt(now, nextTime - now);
+    }
+    else
+    {
+        mRetransmissionTimer.StartAt(now, 0);
+    }
+}
+
+void Mpl::HandleRetransmissionTimer(void *aContext)
 {
     Mpl *obj = reinterpret_cast<Mpl *>(aContext);
-    obj->HandleTimer();
+    obj->HandleRetransmissionTimer();
 }
 
-void Mpl::HandleTimer()
+void Mpl::HandleRetransmissionTimer(void)
 {
-    bool startTimer = false;
+    uint32_t now = Timer::GetNow();
+    BufferedMessageMetadata metadata;
+    Message *next;
 
-    for (int i = 0; i < kNumEntries; i++)
+    for (Message *message = mBufferedMessageSet.GetHead(); message; message = next)
     {
-        if (mEntries[i].mLifetime > 0)
+        next = message->GetNext();
+        ReadMetadata(*message, metadata);
+
+        if (metadata.mTransmissionPending && static_cast<int32_t>(now - metadata.mTransmissionTime) >= 0)
         {
-            mEntries[i].mLifetime--;
-            startTimer = true;
+            // suppress the transmission if enough consistent messages were heard in this interval
+            if (metadata.mCounter < kDataMessageRedundancy)
+            {
+                TransmitBufferedMessage(*message, metadata);
+            }
+
+            metadata.mTransmissionPending = false;
         }
-    }
 
-    if (startTimer)
-    {
-        mTimer.Start(1000);
+        if (static_cast<int32_t>(now - metadata.mIntervalEnd) >= 0)
+        {
+            if (++metadata.mExpirations >= mTimerExpirations)
+            {
+                RemoveBufferedMessage(*message);
+                continue;
+            }
+
+            metadata.mInterval *= 2;
+
+            if (metadata.mInterval > kDataMessageIntervalMax)
+            {
+                metadata.mInterval = kDataMessageIntervalMax;
+            }
+
+            StartInterval(metadata, now);
+        }
+
+        WriteMetadata(*message, metadata);
     }
+
+    ScheduleRetransmissionTimer();
 }
 
 }  // namespace Ip6
@@ -195,26 +195,140 @@ public:
      */
     ThreadError ProcessOption(const Message &aMessage);
 
+    /**
+     * This method adds a copy of an MPL Data Message to the MPL Buffered Message Set.
+     *
+     * The buffered copy is retransmitted using trickle for the configured number of timer expirations.
+     *
+     * @param[in]  aMessage      A reference to the IPv6 datagram.
+     * @param[in]  aInterfaceId  The interface identifier to retransmit the datagram on.
+     *
+     * @retval kThreadError_None    Successfully buffered the MPL Data Message.
+     * @retval kThreadError_Drop    Retransmissions are disabled or @p aMessage does not include an MPL option.
+     * @retval kThreadError_NoBufs  Insufficient message buffers were available.
+     *
+     */
+    ThreadError AddBufferedMessage(Message &aMessage, uint8_t aInterfaceId);
+
+    /**
+     * This method sets the number of trickle intervals over which MPL Data Messages are retransmitted.
+     *
+     * @param[in]  aTimerExpirations  The number of trickle timer expirations, zero disables retransmissions.
+     *
+     */
+    void SetTimerExpirations(uint8_t aTimerExpirations) { mTimerExpirations = aTimerExpirations; }
+
+    /**
+     * This method returns the number of live MPL Seed Set entries evicted to make room for a new seed.
+     *
+     * @returns The number of MPL Seed Set evictions.
+     *
+     */
+    uint32_t GetSeedSetEvictions(void) const { return mSeedSetEvictions; }
+
+    /**
+     * This method returns the number of MPL Data Messages dropped as duplicates.
+     *
+     * @returns The number of duplicate MPL Data Messages.
+     *
+     */
+    uint32_t GetDuplicateDrops(void) const { return mDuplicateDrops; }
+
+    /**
+     * This method returns the number of new MPL Data Messages accepted for delivery and forwarding.
+     *
+     * @returns The number of received MPL Data Messages.
+     *
+     */
+    uint32_t GetReceivedMessages(void) const { return mReceivedMessages; }
+
+    /**
+     * This method returns the number of trickle retransmissions of buffered MPL Data Messages.
+     *
+     * @returns The number of MPL Data Message retransmissions.
+     *
+     */
+    uint32_t GetRetransmissions(void) const { return mRetransmissions; }
+
 private:
     enum
     {
         kNumEntries = OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES,
+        kNumBuckets = OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES,
+        kInvalidIndex = 0xff,
         kLifetime = OPENTHREAD_CONFIG_MPL_CACHE_ENTRY_LIFETIME,
+        kNumBufferedMessages = OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_SET_SIZE,
+        kMinFreeBuffers = OPENTHREAD_CONFIG_MPL_MIN_FREE_BUFFERS,
+        kDataMessageIntervalMin = OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMIN,
+        kDataMessageIntervalMax = OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMAX,
+        kDataMessageRedundancy = OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_K,
+    };
+
+    /**
+     * Trickle state appended to each message in the MPL Buffered Message Set.
+     *
+     */
+    struct BufferedMessageMetadata
+    {
+        uint32_t mTransmissionTime;     ///< The time of the pending transmission within the current interval.
+        uint32_t mIntervalEnd;          ///< The time the current trickle interval ends.
+        uint32_t mInterval;             ///< The current trickle interval length in milliseconds.
+        uint16_t mSeed;                 ///< The MPL Seed value.
+        uint8_t  mSequence;             ///< The MPL Sequence value.
+        uint8_t  mInterfaceId;          ///< The interface to retransmit on.
+        uint8_t  mCounter;              ///< The number of consistent messages heard in the current interval.
+        uint8_t  mExpirations;          ///< The number of trickle intervals that have ended.
+        bool     mTransmissionPending;  ///< TRUE if a transmission is pending in the current interval.
     };
 
-    static void HandleTimer(void *context);
-    void HandleTimer();
+    static ThreadError FindOption(const Message &aMessage, OptionMpl &aOption);
+    static void ReadMetadata(const Message &aMessage, BufferedMessageMetadata &aMetadata);
+    static void WriteMetadata(Message &aMessage, const BufferedMessageMetadata &aMetadata);
+    static void StartInterval(BufferedMessageMetadata &aMetadata, uint32_t aNow);
+
+    void HandleConsistentMessage(uint16_t aSeed, uint8_t aSequence);
+    void RemoveBufferedMessage(Message &aMessage);
+    void TransmitBufferedMessage(Message &aMessage, const BufferedMessageMetadata &aMetadata);
+    void ScheduleRetransmissionTimer(void);
+
+    static uint8_t GetBucket(uint16_t aSeed) { return (aSeed ^ (aSeed >> 10)) % kNumBuckets; }
+    uint8_t FindEntry(uint16_t aSeed) const;
+    uint8_t NewEntry(uint16_t aSeed);
+    void RemoveFromBucket(uint8_t aIndex);
+    void MoveToLruHead(uint8_t aIndex);
 
-    Timer mTimer;
+    static void HandleRetransmissionTimer(void *aContext);
+    void HandleRetransmissionTimer(void);
+
+    Timer mRetransmissionTimer;
     uint8_t mSequence;
+    uint8_t mTimerExpirations;
+    uint8_t mNumBufferedMessages;
+    MessageQueue mBufferedMessageSet;
 
+    /**
+     * An MPL Seed Set entry, linked into a hash bucket and into the LRU list.
+     *
+     */
     struct MplEntry
     {
-        uint16_t mSeed;
-        uint8_t mSequence;
-        uint8_t mLifetime;
+        uint32_t mTimestamp;  ///< The time the seed was last heard.
+        uint16_t mSeed;       ///< The MPL Seed value.
+        uint8_t  mSequence;   ///< The largest MPL Sequence value heard from the seed.
+        uint8_t  mNext;       ///< The next entry in the same hash bucket.
+        uint8_t  mLruPrev;    ///< The next more recently heard entry.
+        uint8_t  mLruNext;    ///< The next less recently heard entry.
+        bool     mValid;      ///< TRUE if the entry holds a seed.
     };
     MplEntry mEntries[kNumEntries];
+    uint8_t mBuckets[kNumBuckets];
+    uint8_t mLruHead;
+    uint8_t mLruTail;
+
+    uint32_t mSeedSetEvictions;
+    uint32_t mDuplicateDrops;
+    uint32_t mReceivedMessages;
+    uint32_t mRetransmissions;
 };
 
 /**
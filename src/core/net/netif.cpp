@@ -41,6 +41,10 @@ namespace Ip6 {
 
 Netif *Netif::sNetifListHead = NULL;
 int Netif::sNextInterfaceId = 1;
+const NetifUnicastAddress *Netif::sUnicastIndex[kAddressIndexSize];
+bool Netif::sUnicastIndexValid = true;
+Netif::SourceCacheEntry Netif::sSourceCache[kSourceCacheEntries];
+uint8_t Netif::sSourceCacheNext = 0;
 
 Netif::Netif() :
     mUnicastChangedTask(&HandleUnicastChangedTask, this)
@@ -48,6 +52,8 @@ Netif::Netif() :
     mHandlers = NULL;
     mUnicastAddresses = NULL;
     mMulticastAddresses = NULL;
+    memset(mMulticastIndex, 0, sizeof(mMulticastIndex));
+    mMulticastIndexValid = true;
     mInterfaceId = -1;
     mAllRoutersSubscribed = false;
     mNext = NULL;
@@ -104,6 +110,10 @@ ThreadError Netif::AddNetif()
         mInterfaceId = sNextInterfaceId++;
     }
 
+    // addresses may have been modified in place while the interface was down
+    UpdateUnicastIndex();
+    UpdateMulticastIndex();
+
 exit:
     return error;
 }
@@ -133,6 +143,7 @@ ThreadError Netif::RemoveNetif()
     }
 
     mNext = NULL;
+    UpdateUnicastIndex();
 
 exit:
     return error;
@@ -193,11 +204,26 @@ bool Netif::IsMulticastSubscribed(const Address &aAddress) const
         ExitNow(rval = mAllRoutersSubscribed);
     }
 
-    for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
+    if (mMulticastIndexValid)
+    {
+        for (uint8_t i = 0, slot = GetAddressIndexSlot(aAddress);
+             i < kAddressIndexSize && mMulticastIndex[slot] != NULL;
+             i++, slot = (slot + 1) & (kAddressIndexSize - 1))
+        {
+            if (mMulticastIndex[slot]->mAddress == aAddress)
+            {
+                ExitNow(rval = true);
+            }
+        }
+    }
+    else
     {
-        if (memcmp(&cur->mAddress, &aAddress, sizeof(cur->mAddress)) == 0)
+        for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
         {
-            ExitNow(rval = true);
+            if (cur->mAddress == aAddress)
+            {
+                ExitNow(rval = true);
+            }
         }
     }
 
@@ -231,6 +257,7 @@ ThreadError Netif::SubscribeMulticast(NetifMulticastAddress &aAddress)
     mMulticastAddresses = &aAddress;
 
 exit:
+    UpdateMulticastIndex();
     return error;
 }
 
@@ -258,6 +285,7 @@ ThreadError Netif::UnsubscribeMulticast(const NetifMulticastAddress &aAddress)
     ExitNow(error = kThreadError_Error);
 
 exit:
+    UpdateMulticastIndex();
     return error;
 }
 
@@ -284,6 +312,7 @@ ThreadError Netif::AddUnicastAddress(NetifUnicastAddress &aAddress)
     mUnicastChangedTask.Post();
 
 exit:
+    UpdateUnicastIndex();
     return error;
 }
 
@@ -311,6 +340,7 @@ ThreadError Netif::RemoveUnicastAddress(const NetifUnicastAddress &aAddress)
     ExitNow(error = kThreadError_Error);
 
 exit:
+    UpdateUnicastIndex();
     mUnicastChangedTask.Post();
     return error;
 }
@@ -324,28 +354,152 @@ bool Netif::IsUnicastAddress(const Address &aAddress)
 {
     bool rval = false;
 
-    for (Netif *netif = sNetifListHead; netif; netif = netif->mNext)
+    if (sUnicastIndexValid)
     {
-        for (NetifUnicastAddress *cur = netif->mUnicastAddresses; cur; cur = cur->GetNext())
+        for (uint8_t i = 0, slot = GetAddressIndexSlot(aAddress);
+             i < kAddressIndexSize && sUnicastIndex[slot] != NULL;
+             i++, slot = (slot + 1) & (kAddressIndexSize - 1))
         {
-            if (cur->GetAddress() == aAddress)
+            if (sUnicastIndex[slot]->GetAddress() == aAddress)
             {
                 ExitNow(rval = true);
             }
         }
     }
+    else
+    {
+        for (Netif *netif = sNetifListHead; netif; netif = netif->mNext)
+        {
+            for (NetifUnicastAddress *cur = netif->mUnicastAddresses; cur; cur = cur->GetNext())
+            {
+                if (cur->GetAddress() == aAddress)
+                {
+                    ExitNow(rval = true);
+                }
+            }
+        }
+    }
 
 exit:
     return rval;
 }
 
+uint8_t Netif::GetAddressIndexSlot(const Address &aAddress)
+{
+    uint32_t hash = aAddress.m32[0] ^ aAddress.m32[1] ^ aAddress.m32[2] ^ aAddress.m32[3];
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+
+    return static_cast<uint8_t>(hash) & (kAddressIndexSize - 1);
+}
+
+void Netif::UpdateUnicastIndex(void)
+{
+    uint8_t count = 0;
+    uint8_t slot;
+
+    // cached source address selections may no longer be valid
+    ClearSourceCache();
+
+    memset(sUnicastIndex, 0, sizeof(sUnicastIndex));
+    sUnicastIndexValid = true;
+
+    for (Netif *netif = sNetifListHead; netif; netif = netif->mNext)
+    {
+        for (const NetifUnicastAddress *cur = netif->mUnicastAddresses; cur; cur = cur->GetNext())
+        {
+            // keep at least one empty slot so that unsuccessful lookups terminate early
+            VerifyOrExit(++count < kAddressIndexSize, sUnicastIndexValid = false);
+
+            slot = GetAddressIndexSlot(cur->GetAddress());
+
+            while (sUnicastIndex[slot] != NULL)
+            {
+                slot = (slot + 1) & (kAddressIndexSize - 1);
+            }
+
+            sUnicastIndex[slot] = cur;
+        }
+    }
+
+exit:
+    return;
+}
+
+void Netif::UpdateMulticastIndex(void)
+{
+    uint8_t count = 0;
+    uint8_t slot;
+
+    memset(mMulticastIndex, 0, sizeof(mMulticastIndex));
+    mMulticastIndexValid = true;
+
+    for (const NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
+    {
+        // keep at least one empty slot so that unsuccessful lookups terminate early
+        VerifyOrExit(++count < kAddressIndexSize, mMulticastIndexValid = false);
+
+        slot = GetAddressIndexSlot(cur->mAddress);
+
+        while (mMulticastIndex[slot] != NULL)
+        {
+            slot = (slot + 1) & (kAddressIndexSize - 1);
+        }
+
+        mMulticastIndex[slot] = cur;
+    }
+
+exit:
+    return;
+}
+
 const NetifUnicastAddress *Netif::SelectSourceAddress(MessageInfo &aMessageInfo)
 {
-    Address *destination = &aMessageInfo.GetPeerAddr();
-    int interfaceId = aMessageInfo.mInterfaceId;
+    const Address &destination = aMessageInfo.GetPeerAddr();
+    const NetifUnicastAddress *rvalAddr;
+    SourceCacheEntry *entry;
+    uint8_t rvalIface = 0;
+
+    for (int i = 0; i < kSourceCacheEntries; i++)
+    {
+        entry = &sSourceCache[i];
+
+        if (entry->mSource != NULL &&
+            entry->mInterfaceId == aMessageInfo.mInterfaceId &&
+            entry->mDestination == destination)
+        {
+            rvalAddr = entry->mSource;
+            rvalIface = entry->mSourceInterfaceId;
+            ExitNow();
+        }
+    }
+
+    rvalAddr = SelectSourceAddress(destination, aMessageInfo.mInterfaceId, rvalIface);
+
+    if (rvalAddr != NULL)
+    {
+        entry = &sSourceCache[sSourceCacheNext];
+        entry->mDestination = destination;
+        entry->mSource = rvalAddr;
+        entry->mInterfaceId = aMessageInfo.mInterfaceId;
+        entry->mSourceInterfaceId = rvalIface;
+        sSourceCacheNext = (sSourceCacheNext + 1) % kSourceCacheEntries;
+    }
+
+exit:
+    aMessageInfo.mInterfaceId = rvalIface;
+    return rvalAddr;
+}
+
+const NetifUnicastAddress *Netif::SelectSourceAddress(const Address &aDestination, uint8_t aInterfaceId,
+                                                      uint8_t &aSourceInterfaceId)
+{
     const NetifUnicastAddress *rvalAddr = NULL;
     const Address *candidateAddr;
     uint8_t candidateId;
+    uint8_t candidatePrefixMatch;
+    int rvalPrefixMatch = -1;
     uint8_t rvalIface = 0;
 
     for (Netif *netif = GetNetifList(); netif; netif = netif->mNext)
@@ -356,9 +510,9 @@ const NetifUnicastAddress *Netif::SelectSourceAddress(MessageInfo &aMessageInfo)
         {
             candidateAddr = &addr->GetAddress();
 
-            if (destination->IsLinkLocal() || destination->IsMulticast())
+            if (aDestination.IsLinkLocal() || aDestination.IsMulticast())
             {
-                if (interfaceId != candidateId)
+                if (aInterfaceId != candidateId)
                 {
                     continue;
                 }
@@ -369,8 +523,9 @@ const NetifUnicastAddress *Netif::SelectSourceAddress(MessageInfo &aMessageInfo)
                 // Rule 0: Prefer any address
                 rvalAddr = addr;
                 rvalIface = candidateId;
+                rvalPrefixMatch = -1;
             }
-            else if (*candidateAddr == *destination)
+            else if (*candidateAddr == aDestination)
             {
                 // Rule 1: Prefer same address
                 rvalAddr = addr;
@@ -380,18 +535,20 @@ const NetifUnicastAddress *Netif::SelectSourceAddress(MessageInfo &aMessageInfo)
             else if (candidateAddr->GetScope() < rvalAddr->GetAddress().GetScope())
             {
                 // Rule 2: Prefer appropriate scope
-                if (candidateAddr->GetScope() >= destination->GetScope())
+                if (candidateAddr->GetScope() >= aDestination.GetScope())
                 {
                     rvalAddr = addr;
                     rvalIface = candidateId;
+                    rvalPrefixMatch = -1;
                 }
             }
             else if (candidateAddr->GetScope() > rvalAddr->GetAddress().GetScope())
             {
-                if (rvalAddr->GetAddress().GetScope() < destination->GetScope())
+                if (rvalAddr->GetAddress().GetScope() < aDestination.GetScope())
                 {
                     rvalAddr = addr;
                     rvalIface = candidateId;
+                    rvalPrefixMatch = -1;
                 }
             }
             else if (addr->mPreferredLifetime != 0 && rvalAddr->mPreferredLifetime == 0)
@@ -399,31 +556,49 @@ const NetifUnicastAddress *Netif::SelectSourceAddress(MessageInfo &aMessageInfo)
                 // Rule 3: Avoid deprecated addresses
                 rvalAddr = addr;
                 rvalIface = candidateId;
+                rvalPrefixMatch = -1;
             }
-            else if (aMessageInfo.mInterfaceId != 0 && aMessageInfo.mInterfaceId == candidateId &&
-                     rvalIface != candidateId)
+            else if (aInterfaceId != 0 && aInterfaceId == candidateId && rvalIface != candidateId)
             {
                 // Rule 4: Prefer home address
                 // Rule 5: Prefer outgoing interface
                 rvalAddr = addr;
                 rvalIface = candidateId;
+                rvalPrefixMatch = -1;
             }
-            else if (destination->PrefixMatch(*candidateAddr) > destination->PrefixMatch(rvalAddr->GetAddress()))
+            else
             {
                 // Rule 6: Prefer matching label
                 // Rule 7: Prefer public address
                 // Rule 8: Use longest prefix matching
-                rvalAddr = addr;
-                rvalIface = candidateId;
+                candidatePrefixMatch = aDestination.PrefixMatch(*candidateAddr);
+
+                if (rvalPrefixMatch < 0)
+                {
+                    rvalPrefixMatch = aDestination.PrefixMatch(rvalAddr->GetAddress());
+                }
+
+                if (candidatePrefixMatch > rvalPrefixMatch)
+                {
+                    rvalAddr = addr;
+                    rvalIface = candidateId;
+                    rvalPrefixMatch = candidatePrefixMatch;
+                }
             }
         }
     }
 
 exit:
-    aMessageInfo.mInterfaceId = rvalIface;
+    aSourceInterfaceId = rvalIface;
     return rvalAddr;
 }
 
+void Netif::ClearSourceCache(void)
+{
+    memset(sSourceCache, 0, sizeof(sSourceCache));
+    sSourceCacheNext = 0;
+}
+
 int Netif::GetOnLinkNetif(const Address &aAddress)
 {
     int rval = -1;
@@ -451,6 +626,8 @@ void Netif::HandleUnicastChangedTask(void *aContext)
 
 void Netif::HandleUnicastChangedTask()
 {
+    ClearSourceCache();
+
     for (NetifHandler *handler = mHandlers; handler; handler = handler->mNext)
     {
         handler->HandleUnicastAddressesChanged();
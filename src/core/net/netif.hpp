@@ -34,6 +34,7 @@
 #ifndef NET_NETIF_HPP_
 #define NET_NETIF_HPP_
 
+#include <openthread-core-config.h>
 #include <common/message.hpp>
 #include <common/tasklet.hpp>
 #include <mac/mac_frame.hpp>
@@ -250,6 +251,8 @@ public:
      *
      * @param[in]  aAddress  A reference to the unicast address.
      *
+     * If @p aAddress was already added, its contents are re-indexed so that in-place changes are picked up.
+     *
      * @retval kThreadError_None  Successfully added the unicast address.
      * @retval kThreadError_Busy  The unicast address was already added.
      *
@@ -295,6 +298,8 @@ public:
      *
      * @param[in]  aAddress  A reference to the multicast address.
      *
+     * If @p aAddress was already subscribed, its contents are re-indexed so that in-place changes are picked up.
+     *
      * @retval kThreadError_None   Successfully subscribed to @p aAddress.
      * @retval kThreadError_Busy   The multicast address is already subscribed.
      *
@@ -406,6 +411,8 @@ public:
     /**
      * This static method perform default source address selection.
      *
+     * Selections are cached per destination until the set of assigned unicast addresses changes.
+     *
      * @param[in]  aMessageInfo  A reference to the message information.
      *
      * @returns A pointer to the selected IPv6 source address or NULL if no source address was found.
@@ -424,12 +431,36 @@ public:
     static int GetOnLinkNetif(const Address &aAddress);
 
 private:
+    enum
+    {
+        kAddressIndexSize = OPENTHREAD_CONFIG_NETIF_ADDRESS_INDEX_SIZE,
+        kSourceCacheEntries = OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES,
+    };
+
+    struct SourceCacheEntry
+    {
+        Address                    mDestination;
+        const NetifUnicastAddress *mSource;
+        uint8_t                    mInterfaceId;
+        uint8_t                    mSourceInterfaceId;
+    };
+
     static void HandleUnicastChangedTask(void *aContext);
     void HandleUnicastChangedTask(void);
 
+    static const NetifUnicastAddress *SelectSourceAddress(const Address &aDestination, uint8_t aInterfaceId,
+                                                          uint8_t &aSourceInterfaceId);
+    static void ClearSourceCache(void);
+
+    static uint8_t GetAddressIndexSlot(const Address &aAddress);
+    static void UpdateUnicastIndex(void);
+    void UpdateMulticastIndex(void);
+
     NetifHandler *mHandlers;
     NetifUnicastAddress *mUnicastAddresses;
     NetifMulticastAddress *mMulticastAddresses;
+    const NetifMulticastAddress *mMulticastIndex[kAddressIndexSize];
+    bool mMulticastIndexValid;
     int mInterfaceId;
     bool mAllRoutersSubscribed;
     Tasklet mUnicastChangedTask;
@@ -437,6 +468,10 @@ private:
 
     static Netif *sNetifListHead;
     static int sNextInterfaceId;
+    static const NetifUnicastAddress *sUnicastIndex[kAddressIndexSize];
+    static bool sUnicastIndexValid;
+    static SourceCacheEntry sSourceCache[kSourceCacheEntries];
+    static uint8_t sSourceCacheNext;
 };
 
 /**
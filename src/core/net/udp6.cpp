@@ -43,14 +43,14 @@ using Thread::Encoding::BigEndian::HostSwap16;
 namespace Thread {
 namespace Ip6 {
 
-UdpSocket *Udp::sSockets = NULL;
+UdpSocket *Udp::sSockets[kNumSocketBuckets];
 uint16_t Udp::sEphemeralPort = kDynamicPortMin;
 
 ThreadError UdpSocket::Open(otUdpReceive aHandler, void *aContext)
 {
     ThreadError error = kThreadError_None;
 
-    for (UdpSocket *cur = Udp::sSockets; cur; cur = cur->GetNext())
+    for (UdpSocket *cur = Udp::GetSocketBucket(GetSockName().mPort); cur; cur = cur->GetNext())
     {
         if (cur == this)
         {
@@ -63,8 +63,7 @@ ThreadError UdpSocket::Open(otUdpReceive aHandler, void *aContext)
     mHandler = aHandler;
     mContext = aContext;
 
-    SetNext(Udp::sSockets);
-    Udp::sSockets = this;
+    Udp::AddSocket(*this);
 
 exit:
     return error;
@@ -72,27 +71,30 @@ exit:
 
 ThreadError UdpSocket::Bind(const SockAddr &aSockAddr)
 {
+    bool relink = (GetSockName().mPort != aSockAddr.mPort ||
+                   GetSockName().GetAddress().IsUnspecified() != aSockAddr.GetAddress().IsUnspecified());
+    bool isOpen = false;
+
+    // only move the socket when its bucket or position changes, so that rebinding from within a
+    // receive handler does not disturb an in-progress delivery
+    if (relink)
+    {
+        isOpen = (Udp::RemoveSocket(*this) == kThreadError_None);
+    }
+
     mSockName = aSockAddr;
+
+    if (isOpen)
+    {
+        Udp::AddSocket(*this);
+    }
+
     return kThreadError_None;
 }
 
 ThreadError UdpSocket::Close(void)
 {
-    if (Udp::sSockets == this)
-    {
-        Udp::sSockets = Udp::sSockets->GetNext();
-    }
-    else
-    {
-        for (UdpSocket *socket = Udp::sSockets; socket; socket = socket->GetNext())
-        {
-            if (socket->GetNext() == this)
-            {
-                socket->SetNext(GetNext());
-                break;
-            }
-        }
-    }
+    Udp::RemoveSocket(*this);
 
     memset(&mSockName, 0, sizeof(mSockName));
     memset(&mPeerName, 0, sizeof(mPeerName));
@@ -116,16 +118,9 @@ ThreadError UdpSocket::SendTo(Message &aMessage, const MessageInfo &aMessageInfo
 
     if (GetSockName().mPort == 0)
     {
-        GetSockName().mPort = Udp::sEphemeralPort;
-
-        if (Udp::sEphemeralPort < Udp::kDynamicPortMax)
-        {
-            Udp::sEphemeralPort++;
-        }
-        else
-        {
-            Udp::sEphemeralPort = Udp::kDynamicPortMin;
-        }
+        SockAddr sockaddr = GetSockName();
+        sockaddr.mPort = Udp::GetEphemeralPort();
+        Bind(sockaddr);
     }
 
     udpHeader.SetSourcePort(GetSockName().mPort);
@@ -141,6 +136,68 @@ exit:
     return error;
 }
 
+void Udp::AddSocket(UdpSocket &aSocket)
+{
+    UdpSocket *&head = GetSocketBucket(aSocket.GetSockName().mPort);
+    UdpSocket *cur;
+
+    if (head == NULL || aSocket.IsSpecific())
+    {
+        // bound and connected sockets are kept ahead of wildcard sockets
+        aSocket.SetNext(head);
+        head = &aSocket;
+    }
+    else
+    {
+        for (cur = head; cur->GetNext(); cur = cur->GetNext()) {}
+
+        aSocket.SetNext(NULL);
+        cur->SetNext(&aSocket);
+    }
+}
+
+ThreadError Udp::RemoveSocket(UdpSocket &aSocket)
+{
+    ThreadError error = kThreadError_None;
+    UdpSocket *&head = GetSocketBucket(aSocket.GetSockName().mPort);
+
+    if (head == &aSocket)
+    {
+        head = aSocket.GetNext();
+        ExitNow();
+    }
+
+    for (UdpSocket *cur = head; cur; cur = cur->GetNext())
+    {
+        if (cur->GetNext() == &aSocket)
+        {
+            cur->SetNext(aSocket.GetNext());
+            ExitNow();
+        }
+    }
+
+    ExitNow(error = kThreadError_Error);
+
+exit:
+    return error;
+}
+
+uint16_t Udp::GetEphemeralPort(void)
+{
+    uint16_t rval = sEphemeralPort;
+
+    if (sEphemeralPort < kDynamicPortMax)
+    {
+        sEphemeralPort++;
+    }
+    else
+    {
+        sEphemeralPort = kDynamicPortMin;
+    }
+
+    return rval;
+}
+
 Message *Udp::NewMessage(uint16_t aReserved)
 {
     return Ip6::NewMessage(sizeof(UdpHeader) + aReserved);
@@ -170,7 +227,7 @@ ThreadError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
     aMessageInfo.mSockPort = udpHeader.GetDestinationPort();
 
     // find socket
-    for (UdpSocket *socket = Udp::sSockets; socket; socket = socket->GetNext())
+    for (UdpSocket *socket = GetSocketBucket(udpHeader.GetDestinationPort()); socket; socket = socket->GetNext())
     {
         if (socket->GetSockName().mPort != udpHeader.GetDestinationPort())
         {
@@ -206,6 +263,12 @@ ThreadError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
         }
 
         socket->HandleUdpReceive(aMessage, aMessageInfo);
+
+        // a unicast datagram that matches a bound or connected socket is not delivered to wildcard sockets
+        if (!aMessageInfo.GetSockAddr().IsMulticast() && socket->IsSpecific())
+        {
+            ExitNow();
+        }
     }
 
 exit:
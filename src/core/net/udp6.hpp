@@ -109,6 +109,10 @@ private:
     SockAddr &GetSockName(void) { return *static_cast<SockAddr *>(&mSockName); }
     SockAddr &GetPeerName(void) { return *static_cast<SockAddr *>(&mPeerName); }
 
+    bool IsSpecific(void) {
+        return !GetSockName().GetAddress().IsUnspecified() || GetPeerName().mPort != 0;
+    }
+
     void HandleUdpReceive(Message &aMessage, const MessageInfo &aMessageInfo) {
         mHandler(mContext, &aMessage, &aMessageInfo);
     }
@@ -162,9 +166,16 @@ private:
     {
         kDynamicPortMin = 49152,  ///< Service Name and Transport Protocol Port Number Registry
         kDynamicPortMax = 65535,  ///< Service Name and Transport Protocol Port Number Registry
+        kNumSocketBuckets = 8,    ///< Number of local port hash buckets (must be a power of two)
     };
+
+    static UdpSocket *&GetSocketBucket(uint16_t aPort) { return sSockets[aPort & (kNumSocketBuckets - 1)]; }
+    static void AddSocket(UdpSocket &aSocket);
+    static ThreadError RemoveSocket(UdpSocket &aSocket);
+    static uint16_t GetEphemeralPort(void);
+
     static uint16_t sEphemeralPort;
-    static UdpSocket *sSockets;
+    static UdpSocket *sSockets[kNumSocketBuckets];
 };
 
 struct UdpHeaderPoD
@@ -74,16 +74,82 @@
 #define OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD           100
 #endif  // OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD
 
+/**
+ * @def OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD
+ *
+ * The Data Poll period in milliseconds used right after a sleepy end device sends a frame.  The period
+ * doubles after every poll that brings no data until it reaches the configured Data Poll period.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD
+#define OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD             50
+#endif  // OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD
+
 /**
  * @def OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
  *
- * The number of EID-to-RLOC cache entries.
+ * The number of EID-to-RLOC cache entries (at most 254).
  *
  */
 #ifndef OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
-#define OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES             8
+#define OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES             32
 #endif  // OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
 
+/**
+ * @def OPENTHREAD_CONFIG_ADDRESS_QUERY_MAX_QUEUED_BYTES
+ *
+ * The maximum number of message bytes queued for a single EID while its Address Query is outstanding.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ADDRESS_QUERY_MAX_QUEUED_BYTES
+#define OPENTHREAD_CONFIG_ADDRESS_QUERY_MAX_QUEUED_BYTES    1280
+#endif  // OPENTHREAD_CONFIG_ADDRESS_QUERY_MAX_QUEUED_BYTES
+
+/**
+ * @def OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE
+ *
+ * The maximum size of the Thread Network Data in bytes.  Values above 255 carry the MLE Network Data TLV using the
+ * extended TLV length format, which is not understood by devices built with the default.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE
+#define OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE             255
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_NETWORK_DATA_COALESCE_WINDOW
+ *
+ * The time in milliseconds the Leader collects Server Data registrations before incrementing the Network Data
+ * version (0 applies each registration immediately).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETWORK_DATA_COALESCE_WINDOW
+#define OPENTHREAD_CONFIG_NETWORK_DATA_COALESCE_WINDOW      0
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_COALESCE_WINDOW
+
+/**
+ * @def OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY
+ *
+ * The number of Network Data version changes retained for sending deltas instead of the complete Network Data
+ * (0 always sends the complete Network Data).  Deltas are only sent by unicast, in reply to a Data Request that
+ * carries the Network Data Delta TLV; multicast Data Responses always carry the complete Network Data.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY
+#define OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY        0
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY
+
+/**
+ * @def OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_MAX_LENGTH
+ *
+ * The maximum number of bytes inserted by a single retained Network Data delta.  Larger changes clear the history
+ * and are propagated as complete Network Data.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_MAX_LENGTH
+#define OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_MAX_LENGTH     32
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_MAX_LENGTH
+
 /**
  * @def OPENTHREAD_CONFIG_MAX_CHILDREN
  *
@@ -94,6 +160,37 @@
 #define OPENTHREAD_CONFIG_MAX_CHILDREN                      5
 #endif  // OPENTHREAD_CONFIG_MAX_CHILDREN
 
+/**
+ * @def OPENTHREAD_CONFIG_CHILD_HASH_SIZE
+ *
+ * The number of buckets in the child table extended address hash (must be a power of two).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_CHILD_HASH_SIZE
+#define OPENTHREAD_CONFIG_CHILD_HASH_SIZE                   8
+#endif  // OPENTHREAD_CONFIG_CHILD_HASH_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_NUM_CHILD_MASKS
+ *
+ * The number of child masks shared by messages scheduled for more than one sleepy child.  Only used when
+ * OPENTHREAD_CONFIG_MAX_CHILDREN exceeds 64; smaller child tables keep a full mask in each message.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NUM_CHILD_MASKS
+#define OPENTHREAD_CONFIG_NUM_CHILD_MASKS                   4
+#endif  // OPENTHREAD_CONFIG_NUM_CHILD_MASKS
+
+/**
+ * @def OPENTHREAD_CONFIG_MAX_PENDING_CHILD_ID_REQUESTS
+ *
+ * The number of Child ID Requests that may be held while upgrading to a router before they are answered.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MAX_PENDING_CHILD_ID_REQUESTS
+#define OPENTHREAD_CONFIG_MAX_PENDING_CHILD_ID_REQUESTS     4
+#endif  // OPENTHREAD_CONFIG_MAX_PENDING_CHILD_ID_REQUESTS
+
 /**
  * @def OPENTHREAD_CONFIG_IP_ADDRS_PER_CHILD
  *
@@ -104,6 +201,37 @@
 #define OPENTHREAD_CONFIG_IP_ADDRS_PER_CHILD                4
 #endif  // OPENTHREAD_CONFIG_IP_ADDRS_PER_CHILD
 
+/**
+ * @def OPENTHREAD_CONFIG_MAX_CHILD_PREFIXES
+ *
+ * The number of 64-bit prefixes shared by IPv6 addresses registered by children.  Addresses from other prefixes are
+ * stored in full, using two of the child's address entries.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MAX_CHILD_PREFIXES
+#define OPENTHREAD_CONFIG_MAX_CHILD_PREFIXES                4
+#endif  // OPENTHREAD_CONFIG_MAX_CHILD_PREFIXES
+
+/**
+ * @def OPENTHREAD_CONFIG_CHILD_ADDRESS_HASH_SIZE
+ *
+ * The number of buckets in the hash of IPv6 addresses registered by children (a power of two, at most 256).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_CHILD_ADDRESS_HASH_SIZE
+#define OPENTHREAD_CONFIG_CHILD_ADDRESS_HASH_SIZE           16
+#endif  // OPENTHREAD_CONFIG_CHILD_ADDRESS_HASH_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_MAX_PARENT_CANDIDATES
+ *
+ * The number of previous parents remembered and tried first with a unicast Parent Request when re-attaching.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MAX_PARENT_CANDIDATES
+#define OPENTHREAD_CONFIG_MAX_PARENT_CANDIDATES             3
+#endif  // OPENTHREAD_CONFIG_MAX_PARENT_CANDIDATES
+
 /**
  * @def OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT
  *
@@ -117,7 +245,7 @@
 /**
  * @def OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES
  *
- * The number of MPL cache entries for duplicate detection.
+ * The number of MPL cache entries for duplicate detection (at most 254).
  *
  */
 #ifndef OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES
@@ -134,6 +262,97 @@
 #define OPENTHREAD_CONFIG_MPL_CACHE_ENTRY_LIFETIME          5
 #endif  // OPENTHREAD_CONFIG_MPL_CACHE_ENTRY_LIFETIME
 
+/**
+ * @def OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_SET_SIZE
+ *
+ * The maximum number of MPL Data Messages held for retransmission.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_SET_SIZE
+#define OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_SET_SIZE     4
+#endif  // OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_SET_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_MPL_MIN_FREE_BUFFERS
+ *
+ * The minimum number of free message buffers that must remain for an MPL Data Message to be buffered.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_MIN_FREE_BUFFERS
+#define OPENTHREAD_CONFIG_MPL_MIN_FREE_BUFFERS              16
+#endif  // OPENTHREAD_CONFIG_MPL_MIN_FREE_BUFFERS
+
+/**
+ * @def OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMIN
+ *
+ * The minimum MPL Data Message trickle interval (DATA_MESSAGE_IMIN) in milliseconds.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMIN
+#define OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMIN             64
+#endif  // OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMIN
+
+/**
+ * @def OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMAX
+ *
+ * The maximum MPL Data Message trickle interval (DATA_MESSAGE_IMAX) in milliseconds.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMAX
+#define OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMAX             256
+#endif  // OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_IMAX
+
+/**
+ * @def OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_K
+ *
+ * The MPL Data Message trickle redundancy constant (DATA_MESSAGE_K).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_K
+#define OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_K                1
+#endif  // OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_K
+
+/**
+ * @def OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS
+ *
+ * The number of trickle intervals a router retransmits an MPL Data Message for (DATA_MESSAGE_TIMER_EXPIRATIONS).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS
+#define OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS  3
+#endif  // OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS
+
+/**
+ * @def OPENTHREAD_CONFIG_NETIF_ADDRESS_INDEX_SIZE
+ *
+ * The number of slots in the network interface address lookup index (must be a power of two).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NETIF_ADDRESS_INDEX_SIZE
+#define OPENTHREAD_CONFIG_NETIF_ADDRESS_INDEX_SIZE          16
+#endif  // OPENTHREAD_CONFIG_NETIF_ADDRESS_INDEX_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES
+ *
+ * The number of destinations for which the selected IPv6 source address is cached.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES
+#define OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES      4
+#endif  // OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES
+
+/**
+ * @def OPENTHREAD_CONFIG_STORE_FRAME_COUNTER_AHEAD
+ *
+ * The number of MAC and MLE frame counter values reserved ahead each time the frame counters are saved in
+ * non-volatile memory.  The counters are saved again when half of the reserved values are used.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_STORE_FRAME_COUNTER_AHEAD
+#define OPENTHREAD_CONFIG_STORE_FRAME_COUNTER_AHEAD         1000
+#endif  // OPENTHREAD_CONFIG_STORE_FRAME_COUNTER_AHEAD
+
 /**
  * @def OPENTHREAD_CONFIG_LOG_LEVEL
  *
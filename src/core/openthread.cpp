@@ -40,7 +40,9 @@
 #include <common/message.hpp>
 #include <common/tasklet.hpp>
 #include <common/timer.hpp>
+#include <net/ip6_mpl.hpp>
 #include <platform/random.h>
+#include <platform/settings.h>
 #include <thread/thread_netif.hpp>
 
 namespace Thread {
@@ -64,6 +66,7 @@ void otInit()
     otLogInfoApi("Init\n");
     Message::Init();
     sThreadNetif = new(&sThreadNetifRaw) ThreadNetif;
+    sThreadNetif->GetMle().Restore();
 }
 
 void otProcessNextTasklet(void)
@@ -96,6 +99,16 @@ void otSetChildTimeout(uint32_t aTimeout)
     sThreadNetif->GetMle().SetTimeout(aTimeout);
 }
 
+uint32_t otGetFastPollPeriod(void)
+{
+    return sThreadNetif->GetMeshForwarder().GetFastPollPeriod();
+}
+
+void otSetFastPollPeriod(uint32_t aPeriod)
+{
+    sThreadNetif->GetMeshForwarder().SetFastPollPeriod(aPeriod);
+}
+
 const uint8_t *otGetExtendedAddress(void)
 {
     return reinterpret_cast<const uint8_t *>(sThreadNetif->GetMac().GetExtAddress());
@@ -206,6 +219,25 @@ void otSetLocalLeaderWeight(uint8_t aWeight)
     sThreadNetif->GetMle().SetLeaderWeight(aWeight);
 }
 
+uint32_t otGetNetworkDataCoalesceWindow(void)
+{
+    return sThreadNetif->GetNetworkDataLeader().GetCoalesceWindow();
+}
+
+void otSetNetworkDataCoalesceWindow(uint32_t aWindow)
+{
+    sThreadNetif->GetNetworkDataLeader().SetCoalesceWindow(aWindow);
+}
+
+void otGetNetworkDataCounters(otNetworkDataCounters *aCounters)
+{
+    const NetworkData::Leader &leader = sThreadNetif->GetNetworkDataLeader();
+
+    aCounters->mRegistrations = leader.GetRegistrations();
+    aCounters->mVersionBumps = leader.GetVersionBumps();
+    aCounters->mSuppressedVersionBumps = leader.GetSuppressedVersionBumps();
+}
+
 ThreadError otAddBorderRouter(const otBorderRouterConfig *aConfig)
 {
     uint8_t flags = 0;
@@ -437,6 +469,41 @@ uint8_t otGetStableNetworkDataVersion()
     return sThreadNetif->GetMle().GetLeaderDataTlv().GetStableDataVersion();
 }
 
+ThreadError otGetNeighborLinkQuality(const uint8_t *aExtAddr, otLinkQualityInfo *aLinkQuality)
+{
+    ThreadError error = kThreadError_None;
+    Neighbor *neighbor;
+
+    neighbor = sThreadNetif->GetMle().GetNeighbor(*reinterpret_cast<const Mac::ExtAddress *>(aExtAddr));
+    VerifyOrExit(neighbor != NULL, error = kThreadError_InvalidArgs);
+
+    aLinkQuality->mAverageLinkMargin = neighbor->mLinkInfo.GetAverageLinkMargin();
+    aLinkQuality->mLinkQualityIn = neighbor->mLinkInfo.GetLinkQuality();
+    aLinkQuality->mTxFailureRate = neighbor->mLinkInfo.GetTxFailureRate();
+    aLinkQuality->mLinkMarginSamples = neighbor->mLinkInfo.GetLinkMarginSamples();
+    aLinkQuality->mTxAttempts = neighbor->mLinkInfo.GetTxAttempts();
+    aLinkQuality->mTxFailures = neighbor->mLinkInfo.GetTxFailures();
+
+exit:
+    return error;
+}
+
+void otGetDataPollCounters(otDataPollCounters *aCounters)
+{
+    aCounters->mPolls = sThreadNetif->GetMeshForwarder().GetPollCount();
+    aCounters->mWastedPolls = sThreadNetif->GetMeshForwarder().GetWastedPollCount();
+}
+
+void otGetMplCounters(otMplCounters *aCounters)
+{
+    const Ip6::Mpl &mpl = Ip6::Ip6::GetMpl();
+
+    aCounters->mReceivedMessages = mpl.GetReceivedMessages();
+    aCounters->mRetransmissions = mpl.GetRetransmissions();
+    aCounters->mDuplicateDrops = mpl.GetDuplicateDrops();
+    aCounters->mSeedSetEvictions = mpl.GetSeedSetEvictions();
+}
+
 bool otIsIp6AddressEqual(const otIp6Address *a, const otIp6Address *b)
 {
     return *static_cast<const Ip6::Address *>(a) == *static_cast<const Ip6::Address *>(b);
@@ -472,6 +539,17 @@ ThreadError otDisable(void)
     return sThreadNetif->Down();
 }
 
+ThreadError otErasePersistentInfo(void)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(!sThreadNetif->IsUp(), error = kThreadError_InvalidState);
+    otPlatSettingsWipe();
+
+exit:
+    return error;
+}
+
 ThreadError otActiveScan(uint16_t aScanChannels, uint16_t aScanDuration, otHandleActiveScanResult aCallback)
 {
     return sThreadNetif->GetMac().ActiveScan(aScanChannels, aScanDuration, &HandleActiveScanResult,
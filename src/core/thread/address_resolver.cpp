@@ -60,7 +60,10 @@ AddressResolver::AddressResolver(ThreadNetif &aThreadNetif) :
     mMle(aThreadNetif.GetMle()),
     mNetif(aThreadNetif)
 {
-    memset(&mCache, 0, sizeof(mCache));
+    Clear();
+    mCacheHits = 0;
+    mCacheMisses = 0;
+    mCacheEvictions = 0;
 
     mCoapServer.AddResource(mAddressError);
     mCoapServer.AddResource(mAddressQuery);
@@ -72,16 +75,34 @@ AddressResolver::AddressResolver(ThreadNetif &aThreadNetif) :
 
 void AddressResolver::Clear()
 {
-    memset(&mCache, 0, sizeof(mCache));
+    memset(mBuckets, kInvalidIndex, sizeof(mBuckets));
+
+    // all entries start out unused on the LRU list
+    for (int i = 0; i < kCacheEntries; i++)
+    {
+        if (mCache[i].mQueue.GetHead() != NULL)
+        {
+            HandleResolved(mCache[i], kThreadError_Drop);
+        }
+
+        mCache[i].mState = Cache::kStateInvalid;
+        mCache[i].mQueuedBytes = 0;
+        mCache[i].mNext = kInvalidIndex;
+        mCache[i].mLruPrev = (i > 0) ? i - 1 : kInvalidIndex;
+        mCache[i].mLruNext = (i < kCacheEntries - 1) ? i + 1 : kInvalidIndex;
+    }
+
+    mLruHead = 0;
+    mLruTail = kCacheEntries - 1;
 }
 
 void AddressResolver::Remove(uint8_t routerId)
 {
     for (int i = 0; i < kCacheEntries; i++)
     {
-        if ((mCache[i].mRloc16 >> 10) == routerId)
+        if (mCache[i].mState != Cache::kStateInvalid && (mCache[i].mRloc16 >> 10) == routerId)
         {
-            mCache[i].mState = Cache::kStateInvalid;
+            InvalidateEntry(mCache[i]);
         }
     }
 }
@@ -89,30 +110,18 @@ void AddressResolver::Remove(uint8_t routerId)
 ThreadError AddressResolver::Resolve(const Ip6::Address &aEid, uint16_t &aRloc16)
 {
     ThreadError error = kThreadError_None;
-    Cache *entry = NULL;
+    Cache *entry;
 
-    for (int i = 0; i < kCacheEntries; i++)
+    if ((entry = FindEntry(aEid)) == NULL && (entry = NewEntry(aEid, false)) == NULL)
     {
-        if (mCache[i].mState != Cache::kStateInvalid)
-        {
-            if (memcmp(&mCache[i].mTarget, &aEid, sizeof(mCache[i].mTarget)) == 0)
-            {
-                entry = &mCache[i];
-                break;
-            }
-        }
-        else if (entry == NULL)
-        {
-            entry = &mCache[i];
-        }
+        mCacheMisses++;
+        ExitNow(error = kThreadError_NoBufs);
     }
 
-    VerifyOrExit(entry != NULL, error = kThreadError_NoBufs);
-
     switch (entry->mState)
     {
     case Cache::kStateInvalid:
-        entry->mTarget = aEid;
+        mCacheMisses++;
         entry->mRloc16 = Mac::kShortAddrInvalid;
         entry->mTimeout = kAddressQueryTimeout;
         entry->mFailures = 0;
@@ -123,6 +132,8 @@ ThreadError AddressResolver::Resolve(const Ip6::Address &aEid, uint16_t &aRloc16
         break;
 
     case Cache::kStateQuery:
+        mCacheMisses++;
+
         if (entry->mTimeout > 0)
         {
             error = kThreadError_AddressQuery;
@@ -141,6 +152,9 @@ ThreadError AddressResolver::Resolve(const Ip6::Address &aEid, uint16_t &aRloc16
         break;
 
     case Cache::kStateCached:
+    case Cache::kStateSnooped:
+        mCacheHits++;
+        MoveToLruHead(static_cast<uint8_t>(entry - mCache));
         aRloc16 = entry->mRloc16;
         break;
     }
@@ -149,6 +163,213 @@ exit:
     return error;
 }
 
+void AddressResolver::Snoop(const Ip6::Address &aEid, Mac::ShortAddress aRloc16)
+{
+    Cache *entry;
+    bool resolved;
+
+    if ((entry = FindEntry(aEid)) == NULL)
+    {
+        VerifyOrExit((entry = NewEntry(aEid, true)) != NULL, ;);
+    }
+
+    // mappings from Address Notifications are authoritative
+    VerifyOrExit(entry->mState != Cache::kStateCached, ;);
+
+    resolved = (entry->mState == Cache::kStateQuery);
+
+    memset(entry->mMeshLocalIid, 0, sizeof(entry->mMeshLocalIid));
+    entry->mRloc16 = aRloc16;
+    entry->mRetryTimeout = 0;
+    entry->mTimeout = 0;
+    entry->mFailures = 0;
+    entry->mState = Cache::kStateSnooped;
+    MoveToLruHead(static_cast<uint8_t>(entry - mCache));
+
+    if (resolved)
+    {
+        HandleResolved(*entry, kThreadError_None);
+    }
+
+exit:
+    return;
+}
+
+ThreadError AddressResolver::QueueMessage(const Ip6::Address &aEid, Message &aMessage)
+{
+    ThreadError error = kThreadError_None;
+    Cache *entry;
+
+    VerifyOrExit((entry = FindEntry(aEid)) != NULL && entry->mState == Cache::kStateQuery,
+                 error = kThreadError_Drop);
+    VerifyOrExit(entry->mQueuedBytes + aMessage.GetLength() <= kMaxQueuedBytes, error = kThreadError_NoBufs);
+
+    SuccessOrExit(error = entry->mQueue.Enqueue(aMessage));
+    entry->mQueuedBytes += aMessage.GetLength();
+
+exit:
+    return error;
+}
+
+void AddressResolver::HandleResolved(Cache &aEntry, ThreadError aError)
+{
+    mMeshForwarder.HandleResolved(aEntry.mQueue, aError);
+    aEntry.mQueuedBytes = 0;
+}
+
+uint8_t AddressResolver::GetBucket(const Ip6::Address &aEid)
+{
+    uint32_t hash = aEid.m32[0] ^ aEid.m32[1] ^ aEid.m32[2] ^ aEid.m32[3];
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+
+    return hash % kCacheBuckets;
+}
+
+AddressResolver::Cache *AddressResolver::FindEntry(const Ip6::Address &aEid)
+{
+    Cache *rval = NULL;
+
+    for (uint8_t index = mBuckets[GetBucket(aEid)]; index != kInvalidIndex; index = mCache[index].mNext)
+    {
+        if (mCache[index].mTarget == aEid)
+        {
+            ExitNow(rval = &mCache[index]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+AddressResolver::Cache *AddressResolver::NewEntry(const Ip6::Address &aEid, bool aSnoop)
+{
+    Cache *rval = NULL;
+    uint8_t bucket = GetBucket(aEid);
+    uint8_t index;
+
+    // take the least recently used entry that does not have a query in flight,
+    // snooped mappings never displace ones learned from Address Notifications
+    for (index = mLruTail; index != kInvalidIndex; index = mCache[index].mLruPrev)
+    {
+        if (mCache[index].mState != Cache::kStateQuery &&
+            !(aSnoop && mCache[index].mState == Cache::kStateCached))
+        {
+            break;
+        }
+    }
+
+    // failing that, give up the least recently used query waiting out its retry delay
+    if (index == kInvalidIndex)
+    {
+        for (index = mLruTail; index != kInvalidIndex; index = mCache[index].mLruPrev)
+        {
+            if (mCache[index].mState == Cache::kStateQuery &&
+                mCache[index].mTimeout == 0 && mCache[index].mRetryTimeout > 0)
+            {
+                break;
+            }
+        }
+    }
+
+    VerifyOrExit(index != kInvalidIndex, ;);
+
+    rval = &mCache[index];
+
+    if (rval->mState != Cache::kStateInvalid)
+    {
+        mCacheEvictions++;
+        InvalidateEntry(*rval);
+    }
+
+    rval->mTarget = aEid;
+    rval->mNext = mBuckets[bucket];
+    mBuckets[bucket] = index;
+    MoveToLruHead(index);
+
+exit:
+    return rval;
+}
+
+void AddressResolver::InvalidateEntry(Cache &aEntry)
+{
+    uint8_t index = static_cast<uint8_t>(&aEntry - mCache);
+    uint8_t *link = &mBuckets[GetBucket(aEntry.mTarget)];
+
+    while (*link != kInvalidIndex && *link != index)
+    {
+        link = &mCache[*link].mNext;
+    }
+
+    if (*link == index)
+    {
+        *link = aEntry.mNext;
+    }
+
+    aEntry.mNext = kInvalidIndex;
+    aEntry.mState = Cache::kStateInvalid;
+
+    if (aEntry.mQueue.GetHead() != NULL)
+    {
+        HandleResolved(aEntry, kThreadError_Drop);
+    }
+
+    // unused entries are reused first
+    MoveToLruTail(index);
+}
+
+void AddressResolver::RemoveFromLru(uint8_t aIndex)
+{
+    Cache &entry = mCache[aIndex];
+
+    if (entry.mLruPrev != kInvalidIndex)
+    {
+        mCache[entry.mLruPrev].mLruNext = entry.mLruNext;
+    }
+    else
+    {
+        mLruHead = entry.mLruNext;
+    }
+
+    if (entry.mLruNext != kInvalidIndex)
+    {
+        mCache[entry.mLruNext].mLruPrev = entry.mLruPrev;
+    }
+    else
+    {
+        mLruTail = entry.mLruPrev;
+    }
+}
+
+void AddressResolver::MoveToLruHead(uint8_t aIndex)
+{
+    VerifyOrExit(aIndex != mLruHead, ;);
+
+    RemoveFromLru(aIndex);
+    mCache[aIndex].mLruPrev = kInvalidIndex;
+    mCache[aIndex].mLruNext = mLruHead;
+    mCache[mLruHead].mLruPrev = aIndex;
+    mLruHead = aIndex;
+
+exit:
+    return;
+}
+
+void AddressResolver::MoveToLruTail(uint8_t aIndex)
+{
+    VerifyOrExit(aIndex != mLruTail, ;);
+
+    RemoveFromLru(aIndex);
+    mCache[aIndex].mLruNext = kInvalidIndex;
+    mCache[aIndex].mLruPrev = mLruTail;
+    mCache[mLruTail].mLruNext = aIndex;
+    mLruTail = aIndex;
+
+exit:
+    return;
+}
+
 ThreadError AddressResolver::SendAddressQuery(const Ip6::Address &aEid)
 {
     ThreadError error;
@@ -226,48 +447,46 @@ void AddressResolver::HandleAddressNotification(Coap::Header &aHeader, Message &
     ThreadTargetTlv targetTlv;
     ThreadMeshLocalEidTlv mlIidTlv;
     ThreadRloc16Tlv rloc16Tlv;
+    Cache *entry;
+    TlvIndex tlvs;
 
     VerifyOrExit(aHeader.GetType() == Coap::Header::kTypeConfirmable &&
                  aHeader.GetCode() == Coap::Header::kCodePost, ;);
 
     otLogInfoArp("Received address notification from %04x\n", HostSwap16(aMessageInfo.GetPeerAddr().m16[7]));
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kTarget, sizeof(targetTlv), targetTlv));
+    tlvs.Init(aMessage);
+
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kTarget, sizeof(targetTlv), targetTlv));
     VerifyOrExit(targetTlv.IsValid(), ;);
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kMeshLocalEid, sizeof(mlIidTlv), mlIidTlv));
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kMeshLocalEid, sizeof(mlIidTlv), mlIidTlv));
     VerifyOrExit(mlIidTlv.IsValid(), ;);
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kRloc16, sizeof(rloc16Tlv), rloc16Tlv));
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kRloc16, sizeof(rloc16Tlv), rloc16Tlv));
     VerifyOrExit(rloc16Tlv.IsValid(), ;);
 
-    for (int i = 0; i < kCacheEntries; i++)
+    if ((entry = FindEntry(*targetTlv.GetTarget())) != NULL)
     {
-        if (mCache[i].mTarget == *targetTlv.GetTarget())
+        if (entry->mState != Cache::kStateCached ||
+            memcmp(entry->mMeshLocalIid, mlIidTlv.GetIid(), sizeof(entry->mMeshLocalIid)) == 0)
         {
-            if (mCache[i].mState != Cache::kStateCached ||
-                memcmp(mCache[i].mMeshLocalIid, mlIidTlv.GetIid(), sizeof(mCache[i].mMeshLocalIid)) == 0)
-            {
-                memcpy(mCache[i].mMeshLocalIid, mlIidTlv.GetIid(), sizeof(mCache[i].mMeshLocalIid));
-                mCache[i].mRloc16 = rloc16Tlv.GetRloc16();
-                mCache[i].mRetryTimeout = 0;
-                mCache[i].mTimeout = 0;
-                mCache[i].mFailures = 0;
-                mCache[i].mState = Cache::kStateCached;
-                SendAddressNotificationResponse(aHeader, aMessageInfo);
-                mMeshForwarder.HandleResolved(*targetTlv.GetTarget(), kThreadError_None);
-            }
-            else
-            {
-                SendAddressError(targetTlv, mlIidTlv, NULL);
-            }
-
-            ExitNow();
+            memcpy(entry->mMeshLocalIid, mlIidTlv.GetIid(), sizeof(entry->mMeshLocalIid));
+            entry->mRloc16 = rloc16Tlv.GetRloc16();
+            entry->mRetryTimeout = 0;
+            entry->mTimeout = 0;
+            entry->mFailures = 0;
+            entry->mState = Cache::kStateCached;
+            MoveToLruHead(static_cast<uint8_t>(entry - mCache));
+            SendAddressNotificationResponse(aHeader, aMessageInfo);
+            HandleResolved(*entry, kThreadError_None);
+        }
+        else
+        {
+            SendAddressError(targetTlv, mlIidTlv, NULL);
         }
     }
 
-    ExitNow();
-
 exit:
     {}
 }
@@ -381,18 +600,23 @@ void AddressResolver::HandleAddressError(Coap::Header &aHeader, Message &aMessag
     ThreadTargetTlv targetTlv;
     ThreadMeshLocalEidTlv mlIidTlv;
     Child *children;
-    uint8_t numChildren;
+    uint16_t numChildren;
+    uint8_t prefixId;
+    uint8_t index;
     Mac::ExtAddress macAddr;
     Ip6::Address destination;
+    TlvIndex tlvs;
 
     VerifyOrExit(aHeader.GetCode() == Coap::Header::kCodePost, error = kThreadError_Drop);
 
     otLogInfoArp("Received address error notification\n");
 
-    SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kTarget, sizeof(targetTlv), targetTlv));
+    tlvs.Init(aMessage);
+
+    SuccessOrExit(error = ThreadTlv::GetTlv(tlvs, ThreadTlv::kTarget, sizeof(targetTlv), targetTlv));
     VerifyOrExit(targetTlv.IsValid(), error = kThreadError_Parse);
 
-    SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kMeshLocalEid, sizeof(mlIidTlv), mlIidTlv));
+    SuccessOrExit(error = ThreadTlv::GetTlv(tlvs, ThreadTlv::kMeshLocalEid, sizeof(mlIidTlv), mlIidTlv));
     VerifyOrExit(mlIidTlv.IsValid(), error = kThreadError_Parse);
 
     for (const Ip6::NetifUnicastAddress *address = mNetif.GetUnicastAddresses(); address; address = address->GetNext())
@@ -406,6 +630,8 @@ void AddressResolver::HandleAddressError(Coap::Header &aHeader, Message &aMessag
         }
     }
 
+    prefixId = mMle.GetChildPrefixId(*targetTlv.GetTarget());
+
     children = mMle.GetChildren(&numChildren);
 
     memcpy(&macAddr, mlIidTlv.GetIid(), sizeof(macAddr));
@@ -418,21 +644,20 @@ void AddressResolver::HandleAddressError(Coap::Header &aHeader, Message &aMessag
             continue;
         }
 
-        for (int j = 0; j < Child::kMaxIp6AddressPerChild; j++)
+        index = children[i].FindIp6Address(prefixId, *targetTlv.GetTarget());
+
+        if (index < Child::kMaxIp6AddressPerChild &&
+            memcmp(&children[i].mMacAddr, &macAddr, sizeof(children[i].mMacAddr)))
         {
-            if (memcmp(&children[i].mIp6Address[j], targetTlv.GetTarget(), sizeof(children[i].mIp6Address[j])) == 0 &&
-                memcmp(&children[i].mMacAddr, &macAddr, sizeof(children[i].mMacAddr)))
-            {
-                // Target EID matches child address and Mesh Local EID differs on child
-                memset(&children[i].mIp6Address[j], 0, sizeof(children[i].mIp6Address[j]));
+            // Target EID matches child address and Mesh Local EID differs on child
+            mMle.RemoveChildAddress(children[i], index);
 
-                memset(&destination, 0, sizeof(destination));
-                destination.m16[0] = HostSwap16(0xfe80);
-                destination.SetIid(children[i].mMacAddr);
+            memset(&destination, 0, sizeof(destination));
+            destination.m16[0] = HostSwap16(0xfe80);
+            destination.SetIid(children[i].mMacAddr);
 
-                SendAddressError(targetTlv, mlIidTlv, &destination);
-                ExitNow();
-            }
+            SendAddressError(targetTlv, mlIidTlv, &destination);
+            ExitNow();
         }
     }
 
@@ -453,8 +678,7 @@ void AddressResolver::HandleAddressQuery(Coap::Header &aHeader, Message &aMessag
     ThreadTargetTlv targetTlv;
     ThreadMeshLocalEidTlv mlIidTlv;
     ThreadLastTransactionTimeTlv lastTransactionTimeTlv;
-    Child *children;
-    uint8_t numChildren;
+    Child *child;
 
     VerifyOrExit(aHeader.GetType() == Coap::Header::kTypeNonConfirmable &&
                  aHeader.GetCode() == Coap::Header::kCodePost, ;);
@@ -475,30 +699,13 @@ void AddressResolver::HandleAddressQuery(Coap::Header &aHeader, Message &aMessag
         ExitNow();
     }
 
-    children = mMle.GetChildren(&numChildren);
-
-    for (int i = 0; i < Mle::kMaxChildren; i++)
-    {
-        if (children[i].mState != Neighbor::kStateValid || (children[i].mMode & Mle::ModeTlv::kModeFFD) != 0)
-        {
-            continue;
-        }
-
-        for (int j = 0; j < Child::kMaxIp6AddressPerChild; j++)
-        {
-            if (memcmp(&children[i].mIp6Address[j], targetTlv.GetTarget(), sizeof(children[i].mIp6Address[j])))
-            {
-                continue;
-            }
+    VerifyOrExit((child = mMle.GetMtdChild(*targetTlv.GetTarget())) != NULL, ;);
 
-            children[i].mMacAddr.m8[0] ^= 0x2;
-            mlIidTlv.SetIid(children[i].mMacAddr.m8);
-            children[i].mMacAddr.m8[0] ^= 0x2;
-            lastTransactionTimeTlv.SetTime(Timer::GetNow() - children[i].mLastHeard);
-            SendAddressQueryResponse(targetTlv, mlIidTlv, &lastTransactionTimeTlv, aMessageInfo.GetPeerAddr());
-            ExitNow();
-        }
-    }
+    child->mMacAddr.m8[0] ^= 0x2;
+    mlIidTlv.SetIid(child->mMacAddr.m8);
+    child->mMacAddr.m8[0] ^= 0x2;
+    lastTransactionTimeTlv.SetTime(Timer::GetNow() - child->mLastHeard);
+    SendAddressQueryResponse(targetTlv, mlIidTlv, &lastTransactionTimeTlv, aMessageInfo.GetPeerAddr());
 
 exit:
     {}
@@ -591,7 +798,7 @@ void AddressResolver::HandleTimer()
                     mCache[i].mFailures--;
                 }
 
-                mMeshForwarder.HandleResolved(mCache[i].mTarget, kThreadError_Drop);
+                HandleResolved(mCache[i], kThreadError_Drop);
             }
         }
         else if (mCache[i].mRetryTimeout > 0)
@@ -617,19 +824,15 @@ void AddressResolver::HandleDstUnreach(Message &aMessage, const Ip6::MessageInfo
                                        const Ip6::IcmpHeader &aIcmpHeader)
 {
     Ip6::Header ip6Header;
+    Cache *entry;
 
     VerifyOrExit(aIcmpHeader.GetCode() == Ip6::IcmpHeader::kCodeDstUnreachNoRoute, ;);
     VerifyOrExit(aMessage.Read(aMessage.GetOffset(), sizeof(ip6Header), &ip6Header) == sizeof(ip6Header), ;);
 
-    for (int i = 0; i < kCacheEntries; i++)
+    if ((entry = FindEntry(ip6Header.GetDestination())) != NULL)
     {
-        if (mCache[i].mState != Cache::kStateInvalid &&
-            memcmp(&mCache[i].mTarget, &ip6Header.GetDestination(), sizeof(mCache[i].mTarget)) == 0)
-        {
-            mCache[i].mState = Cache::kStateInvalid;
-            otLogInfoArp("cache entry removed!\n");
-            break;
-        }
+        InvalidateEntry(*entry);
+        otLogInfoArp("cache entry removed!\n");
     }
 
 exit:
@@ -98,10 +98,62 @@ public:
      */
     ThreadError Resolve(const Ip6::Address &aEid, Mac::ShortAddress &aRloc16);
 
+    /**
+     * This method records an EID-to-RLOC mapping learned from a received mesh-headered datagram.
+     *
+     * A snooped mapping never replaces one learned from an Address Notification and is itself replaced by any
+     * subsequent Address Notification for the same EID.
+     *
+     * @param[in]  aEid     A reference to the source EID of the datagram.
+     * @param[in]  aRloc16  The mesh source RLOC16 of the datagram.
+     *
+     */
+    void Snoop(const Ip6::Address &aEid, Mac::ShortAddress aRloc16);
+
+    /**
+     * This method queues a message until the Address Query for its destination EID completes.
+     *
+     * @param[in]  aEid      A reference to the destination EID of @p aMessage.
+     * @param[in]  aMessage  A reference to the message.
+     *
+     * @retval kThreadError_None    Successfully queued the message.
+     * @retval kThreadError_Drop    No Address Query is outstanding for @p aEid.
+     * @retval kThreadError_NoBufs  Queuing @p aMessage would exceed the bytes allowed per EID.
+     *
+     */
+    ThreadError QueueMessage(const Ip6::Address &aEid, Message &aMessage);
+
+    /**
+     * This method returns the number of lookups that found a cached EID-to-RLOC mapping.
+     *
+     * @returns The number of EID-to-RLOC cache hits.
+     *
+     */
+    uint32_t GetCacheHits(void) const { return mCacheHits; }
+
+    /**
+     * This method returns the number of lookups that did not find a cached EID-to-RLOC mapping.
+     *
+     * @returns The number of EID-to-RLOC cache misses.
+     *
+     */
+    uint32_t GetCacheMisses(void) const { return mCacheMisses; }
+
+    /**
+     * This method returns the number of cached EID-to-RLOC mappings evicted to make room for a new EID.
+     *
+     * @returns The number of EID-to-RLOC cache evictions.
+     *
+     */
+    uint32_t GetCacheEvictions(void) const { return mCacheEvictions; }
+
 private:
     enum
     {
         kCacheEntries = OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES,
+        kCacheBuckets = OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES,
+        kMaxQueuedBytes = OPENTHREAD_CONFIG_ADDRESS_QUERY_MAX_QUEUED_BYTES,
+        kInvalidIndex = 0xff,
         kStateUpdatePeriod = 1000u,           ///< State update period in milliseconds.
     };
 
@@ -124,16 +176,31 @@ private:
         uint16_t          mRetryTimeout;
         uint8_t           mTimeout;
         uint8_t           mFailures;
+        uint8_t           mNext;       ///< The next entry in the same hash bucket.
+        uint8_t           mLruPrev;    ///< The next more recently used entry.
+        uint8_t           mLruNext;    ///< The next less recently used entry.
+        uint16_t          mQueuedBytes;
+        MessageQueue      mQueue;      ///< Messages waiting for this EID to be resolved.
 
         enum State
         {
             kStateInvalid,
             kStateQuery,
             kStateCached,
+            kStateSnooped,
         };
         State             mState;
     };
 
+    static uint8_t GetBucket(const Ip6::Address &aEid);
+    Cache *FindEntry(const Ip6::Address &aEid);
+    Cache *NewEntry(const Ip6::Address &aEid, bool aSnoop);
+    void InvalidateEntry(Cache &aEntry);
+    void HandleResolved(Cache &aEntry, ThreadError aError);
+    void RemoveFromLru(uint8_t aIndex);
+    void MoveToLruHead(uint8_t aIndex);
+    void MoveToLruTail(uint8_t aIndex);
+
     ThreadError SendAddressQuery(const Ip6::Address &aEid);
     ThreadError SendAddressError(const ThreadTargetTlv &aTarget, const ThreadMeshLocalEidTlv &aEid,
                                  const Ip6::Address *aDestination);
@@ -167,6 +234,12 @@ private:
     Coap::Resource mAddressQuery;
     Coap::Resource mAddressNotification;
     Cache mCache[kCacheEntries];
+    uint8_t mBuckets[kCacheBuckets];
+    uint8_t mLruHead;
+    uint8_t mLruTail;
+    uint32_t mCacheHits;
+    uint32_t mCacheMisses;
+    uint32_t mCacheEvictions;
     uint16_t mCoapMessageId;
     uint8_t mCoapToken[2];
     Ip6::IcmpHandler mIcmpHandler;
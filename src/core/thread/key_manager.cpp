@@ -45,11 +45,15 @@ static const uint8_t kThreadString[] =
 };
 
 KeyManager::KeyManager(ThreadNetif &aThreadNetif):
+    mStoreFrameCounters(&HandleStoreFrameCounters, this),
     mNetif(aThreadNetif)
 {
     mPreviousKeyValid = false;
     mMacFrameCounter = 0;
     mMleFrameCounter = 0;
+    mStoredMacFrameCounter = 0;
+    mStoredMleFrameCounter = 0;
+    mStoredFrameCountersValid = false;
 }
 
 const uint8_t *KeyManager::GetMasterKey(uint8_t *aKeyLength) const
@@ -101,23 +105,24 @@ uint32_t KeyManager::GetCurrentKeySequence() const
 
 void KeyManager::UpdateNeighbors()
 {
-    uint8_t numNeighbors;
+    uint8_t numRouters;
+    uint16_t numChildren;
     Router *routers;
     Child *children;
 
     routers = mNetif.GetMle().GetParent();
     routers->mPreviousKey = true;
 
-    routers = mNetif.GetMle().GetRouters(&numNeighbors);
+    routers = mNetif.GetMle().GetRouters(&numRouters);
 
-    for (int i = 0; i < numNeighbors; i++)
+    for (int i = 0; i < numRouters; i++)
     {
         routers[i].mPreviousKey = true;
     }
 
-    children = mNetif.GetMle().GetChildren(&numNeighbors);
+    children = mNetif.GetMle().GetChildren(&numChildren);
 
-    for (int i = 0; i < numNeighbors; i++)
+    for (int i = 0; i < numChildren; i++)
     {
         children[i].mPreviousKey = true;
     }
@@ -134,8 +139,16 @@ void KeyManager::SetCurrentKeySequence(uint32_t aKeySequence)
 
     mMacFrameCounter = 0;
     mMleFrameCounter = 0;
+    mStoredMacFrameCounter = 0;
+    mStoredMleFrameCounter = 0;
 
     UpdateNeighbors();
+
+    if (mNetif.GetMle().GetDeviceState() != Mle::kDeviceStateDisabled &&
+        mNetif.GetMle().GetDeviceState() != Mle::kDeviceStateDetached)
+    {
+        mNetif.GetMle().Store();
+    }
 }
 
 const uint8_t *KeyManager::GetCurrentMacKey() const
@@ -188,6 +201,21 @@ uint32_t KeyManager::GetMacFrameCounter() const
 void KeyManager::IncrementMacFrameCounter()
 {
     mMacFrameCounter++;
+
+    if (mStoredFrameCountersValid && mMacFrameCounter + kStoreFrameCounterAhead / 2 >= mStoredMacFrameCounter)
+    {
+        mStoreFrameCounters.Post();
+    }
+}
+
+void KeyManager::SetMacFrameCounter(uint32_t aMacFrameCounter)
+{
+    mMacFrameCounter = aMacFrameCounter;
+}
+
+ThreadError KeyManager::CheckMacFrameCounter(void)
+{
+    return CheckFrameCounter(mMacFrameCounter, mStoredMacFrameCounter);
 }
 
 uint32_t KeyManager::GetMleFrameCounter() const
@@ -198,6 +226,58 @@ uint32_t KeyManager::GetMleFrameCounter() const
 void KeyManager::IncrementMleFrameCounter()
 {
     mMleFrameCounter++;
+
+    if (mStoredFrameCountersValid && mMleFrameCounter + kStoreFrameCounterAhead / 2 >= mStoredMleFrameCounter)
+    {
+        mStoreFrameCounters.Post();
+    }
+}
+
+void KeyManager::SetMleFrameCounter(uint32_t aMleFrameCounter)
+{
+    mMleFrameCounter = aMleFrameCounter;
+}
+
+ThreadError KeyManager::CheckMleFrameCounter(void)
+{
+    return CheckFrameCounter(mMleFrameCounter, mStoredMleFrameCounter);
+}
+
+void KeyManager::SetStoredFrameCounters(uint32_t aMacFrameCounter, uint32_t aMleFrameCounter)
+{
+    mStoredMacFrameCounter = aMacFrameCounter;
+    mStoredMleFrameCounter = aMleFrameCounter;
+    mStoredFrameCountersValid = true;
+}
+
+void KeyManager::ClearStoredFrameCounters(void)
+{
+    mStoredFrameCountersValid = false;
+}
+
+ThreadError KeyManager::CheckFrameCounter(uint32_t aFrameCounter, uint32_t aStoredFrameCounter)
+{
+    ThreadError error = kThreadError_None;
+
+    if (mStoredFrameCountersValid && aFrameCounter >= aStoredFrameCounter)
+    {
+        mStoreFrameCounters.Post();
+        ExitNow(error = kThreadError_Busy);
+    }
+
+exit:
+    return error;
+}
+
+void KeyManager::HandleStoreFrameCounters(void *aContext)
+{
+    KeyManager *obj = reinterpret_cast<KeyManager *>(aContext);
+    obj->HandleStoreFrameCounters();
+}
+
+void KeyManager::HandleStoreFrameCounters(void)
+{
+    mNetif.GetMle().StoreFrameCounters();
 }
 
 }  // namespace Thread
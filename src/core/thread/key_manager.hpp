@@ -36,7 +36,9 @@
 
 #include <stdint.h>
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
+#include <common/tasklet.hpp>
 #include <crypto/hmac_sha256.h>
 
 namespace Thread {
@@ -55,6 +57,12 @@ class ThreadNetif;
 class KeyManager
 {
 public:
+    enum
+    {
+        kMaxKeyLength           = 16,  ///< Maximum length of the Thread Master Key (bytes).
+        kStoreFrameCounterAhead = OPENTHREAD_CONFIG_STORE_FRAME_COUNTER_AHEAD,  ///< Frame counters reserved ahead.
+    };
+
     /**
      * This constructor initializes the object.
      *
@@ -186,6 +194,26 @@ public:
      */
     void IncrementMacFrameCounter();
 
+    /**
+     * This method sets the current MAC Frame Counter value.
+     *
+     * @param[in]  aMacFrameCounter  The MAC Frame Counter value.
+     *
+     */
+    void SetMacFrameCounter(uint32_t aMacFrameCounter);
+
+    /**
+     * This method checks whether the current MAC Frame Counter value may be used to secure a frame.
+     *
+     * A value at or beyond the one saved in non-volatile memory could be used again after a reset.  Such a value is
+     * not used until the frame counters are saved again, and this method posts the tasklet that saves them.
+     *
+     * @retval kThreadError_None  The current MAC Frame Counter value may be used.
+     * @retval kThreadError_Busy  The frame counters must be saved before the current value may be used.
+     *
+     */
+    ThreadError CheckMacFrameCounter(void);
+
     /**
      * This method returns the current MLE Frame Counter value.
      *
@@ -202,15 +230,56 @@ public:
      */
     void IncrementMleFrameCounter();
 
-private:
-    enum
-    {
-        kMaxKeyLength = 16,
-    };
+    /**
+     * This method sets the current MLE Frame Counter value.
+     *
+     * @param[in]  aMleFrameCounter  The MLE Frame Counter value.
+     *
+     */
+    void SetMleFrameCounter(uint32_t aMleFrameCounter);
 
+    /**
+     * This method checks whether the current MLE Frame Counter value may be used to secure a message.
+     *
+     * A value at or beyond the one saved in non-volatile memory could be used again after a reset.  Such a value is
+     * not used until the frame counters are saved again, and this method posts the tasklet that saves them.
+     *
+     * @retval kThreadError_None  The current MLE Frame Counter value may be used.
+     * @retval kThreadError_Busy  The frame counters must be saved before the current value may be used.
+     *
+     */
+    ThreadError CheckMleFrameCounter(void);
+
+    /**
+     * This method sets the MAC and MLE Frame Counter values saved in non-volatile memory.
+     *
+     * The saved values are reserved ahead of the current values.  Once the current values come within half of
+     * kStoreFrameCounterAhead of the saved values, the frame counters are saved again from a tasklet.  The saved
+     * values are only updated after a successful save, so a failed save is retried on the next frame sent.
+     *
+     * @param[in]  aMacFrameCounter  The MAC Frame Counter value saved in non-volatile memory.
+     * @param[in]  aMleFrameCounter  The MLE Frame Counter value saved in non-volatile memory.
+     *
+     */
+    void SetStoredFrameCounters(uint32_t aMacFrameCounter, uint32_t aMleFrameCounter);
+
+    /**
+     * This method indicates that no frame counters are saved in non-volatile memory.
+     *
+     * The frame counters are then not limited by any saved value until SetStoredFrameCounters() is called.
+     *
+     */
+    void ClearStoredFrameCounters(void);
+
+private:
     ThreadError ComputeKey(uint32_t aKeySequence, uint8_t *aKey);
     void UpdateNeighbors();
 
+    ThreadError CheckFrameCounter(uint32_t aFrameCounter, uint32_t aStoredFrameCounter);
+
+    static void HandleStoreFrameCounters(void *aContext);
+    void HandleStoreFrameCounters(void);
+
     uint8_t mMasterKey[kMaxKeyLength];
     uint8_t mMasterKeyLength;
 
@@ -225,6 +294,10 @@ private:
 
     uint32_t mMacFrameCounter;
     uint32_t mMleFrameCounter;
+    uint32_t mStoredMacFrameCounter;
+    uint32_t mStoredMleFrameCounter;
+    bool mStoredFrameCountersValid;
+    Tasklet mStoreFrameCounters;
 
     ThreadNetif &mNetif;
 };
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the neighbor link quality estimator.
+ */
+
+#include <string.h>
+
+#include <common/code_utils.hpp>
+#include <thread/link_quality.hpp>
+
+namespace Thread {
+
+void LinkQualityInfo::Clear(void)
+{
+    memset(this, 0, sizeof(*this));
+}
+
+void LinkQualityInfo::AddLinkMargin(uint8_t aLinkMargin)
+{
+    if (mLinkMarginSamples == 0)
+    {
+        mLinkMarginAverage = static_cast<uint16_t>(aLinkMargin) << kShift;
+        mLinkQuality = LinkMarginToQuality(aLinkMargin);
+    }
+    else
+    {
+        mLinkMarginAverage = Average(mLinkMarginAverage, static_cast<uint16_t>(aLinkMargin) << kShift);
+    }
+
+    if (mLinkMarginSamples < 0xffff)
+    {
+        mLinkMarginSamples++;
+    }
+
+    UpdateLinkQuality();
+}
+
+void LinkQualityInfo::AddTxResult(bool aAcked)
+{
+    mTxFailureRate = Average(mTxFailureRate, aAcked ? 0 : 0xffff);
+
+    if (!aAcked)
+    {
+        if (mTxFailures < 0xffff)
+        {
+            mTxFailures++;
+        }
+    }
+
+    if (mTxAttempts < 0xffff)
+    {
+        mTxAttempts++;
+    }
+
+    UpdateLinkQuality();
+}
+
+void LinkQualityInfo::UpdateLinkQuality(void)
+{
+    uint16_t loss = static_cast<uint16_t>((static_cast<uint32_t>(mTxFailureRate) * kMaxTxFailureLoss) >> (16 - kShift));
+    uint8_t margin;
+    uint8_t quality;
+
+    if (mLinkMarginSamples == 0)
+    {
+        ExitNow();
+    }
+
+    margin = mLinkMarginAverage > loss ? static_cast<uint8_t>((mLinkMarginAverage - loss + kRound - 1) >> kShift) : 0;
+
+    // only move to a better quality once the margin exceeds its threshold by the hysteresis
+    quality = LinkMarginToQuality(margin > kHysteresis ? margin - kHysteresis : 0);
+
+    if (quality > mLinkQuality)
+    {
+        mLinkQuality = quality;
+        ExitNow();
+    }
+
+    // only move to a worse quality once the margin falls below the current threshold by the hysteresis
+    quality = LinkMarginToQuality(margin < 0xff - kHysteresis ? margin + kHysteresis : 0xff);
+
+    if (quality < mLinkQuality)
+    {
+        mLinkQuality = quality;
+    }
+
+exit:
+    {}
+}
+
+uint16_t LinkQualityInfo::Average(uint16_t aAverage, uint16_t aSample)
+{
+    return static_cast<uint16_t>((static_cast<uint32_t>(aAverage) * ((1 << kShift) - 1) + aSample + kRound) >> kShift);
+}
+
+uint8_t LinkQualityInfo::LinkMarginToQuality(uint8_t aLinkMargin)
+{
+    if (aLinkMargin > 20)
+    {
+        return 3;
+    }
+    else if (aLinkMargin > 10)
+    {
+        return 2;
+    }
+    else if (aLinkMargin > 2)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+}  // namespace Thread
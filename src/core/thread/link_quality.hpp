@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for estimating the quality of a link to a neighbor.
+ */
+
+#ifndef LINK_QUALITY_HPP_
+#define LINK_QUALITY_HPP_
+
+#include <openthread-types.h>
+
+namespace Thread {
+
+/**
+ * @addtogroup core-link-quality
+ *
+ * @brief
+ *   This module includes definitions for estimating the quality of a link to a neighbor.
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements a link quality estimator for a single neighbor.
+ *
+ * The estimator keeps an exponentially weighted moving average of the link margin of received frames and of the
+ * MAC acknowledgment failure rate of transmitted frames.  Acknowledgment failures lower the effective link margin,
+ * and the resulting link quality only changes once the effective link margin clears a quality threshold by the
+ * hysteresis margin, so that a single noisy frame does not change route costs.
+ *
+ */
+class LinkQualityInfo
+{
+public:
+    enum
+    {
+        kNoiseFloor = -100,  ///< The noise floor used to derive link margin from RSS (dBm)
+    };
+
+    /**
+     * This method clears all samples.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method adds the received signal strength of a received frame.
+     *
+     * @param[in]  aRss  The received signal strength in dBm.
+     *
+     */
+    void AddRss(int8_t aRss) { AddLinkMargin(aRss > kNoiseFloor ? static_cast<uint8_t>(aRss - kNoiseFloor) : 0); }
+
+    /**
+     * This method adds the link margin of a received frame.
+     *
+     * The first sample after Clear() sets the average and the link quality directly.
+     *
+     * @param[in]  aLinkMargin  The link margin in dB.
+     *
+     */
+    void AddLinkMargin(uint8_t aLinkMargin);
+
+    /**
+     * This method adds the outcome of a transmission that requested a MAC acknowledgment.
+     *
+     * @param[in]  aAcked  TRUE if the frame was acknowledged, FALSE otherwise.
+     *
+     */
+    void AddTxResult(bool aAcked);
+
+    /**
+     * This method returns the average link margin.
+     *
+     * @returns The average link margin in dB.
+     *
+     */
+    uint8_t GetAverageLinkMargin(void) const {
+        return static_cast<uint8_t>((mLinkMarginAverage + kRound - 1) >> kShift);
+    }
+
+    /**
+     * This method returns the average MAC acknowledgment failure rate.
+     *
+     * @returns The average failure rate, where 0xffff corresponds to all transmissions failing.
+     *
+     */
+    uint16_t GetTxFailureRate(void) const { return mTxFailureRate; }
+
+    /**
+     * This method returns the number of link margin samples since the last Clear().
+     *
+     * @returns The number of link margin samples, saturating at 0xffff.
+     *
+     */
+    uint16_t GetLinkMarginSamples(void) const { return mLinkMarginSamples; }
+
+    /**
+     * This method returns the number of transmissions that requested a MAC acknowledgment since the last Clear().
+     *
+     * @returns The number of transmissions, saturating at 0xffff.
+     *
+     */
+    uint16_t GetTxAttempts(void) const { return mTxAttempts; }
+
+    /**
+     * This method returns the number of transmissions that were not acknowledged since the last Clear().
+     *
+     * @returns The number of unacknowledged transmissions, saturating at 0xffff.
+     *
+     */
+    uint16_t GetTxFailures(void) const { return mTxFailures; }
+
+    /**
+     * This method returns the current link quality.
+     *
+     * @returns The link quality (0-3).
+     *
+     */
+    uint8_t GetLinkQuality(void) const { return mLinkQuality; }
+
+    /**
+     * This static method converts a link margin to a link quality.
+     *
+     * @param[in]  aLinkMargin  The link margin in dB.
+     *
+     * @returns The link quality (0-3).
+     *
+     */
+    static uint8_t LinkMarginToQuality(uint8_t aLinkMargin);
+
+private:
+    enum
+    {
+        kShift             = 3,                 ///< Weight of a new sample is 1/8; averages are in 1/8 dB
+        kRound             = 1 << (kShift - 1),
+        kHysteresis        = 2,                 ///< Margin (dB) a threshold must be cleared by to change quality
+        kMaxTxFailureLoss  = 32,                ///< Link margin (dB) lost when every transmission fails
+    };
+
+    static uint16_t Average(uint16_t aAverage, uint16_t aSample);
+    void UpdateLinkQuality(void);
+
+    uint16_t mLinkMarginAverage;
+    uint16_t mTxFailureRate;
+    uint16_t mLinkMarginSamples;
+    uint16_t mTxAttempts;
+    uint16_t mTxFailures;
+    uint8_t  mLinkQuality;
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Thread
+
+#endif  // LINK_QUALITY_HPP_
@@ -63,6 +63,11 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
 {
     mFragTag = otPlatRandomGet();
     mPollPeriod = 0;
+    mFastPollPeriod = kFastPollPeriod;
+    mPollInterval = 0;
+    mPollCount = 0;
+    mWastedPollCount = 0;
+    mPollOutstanding = false;
     mSendMessage = NULL;
     mSendBusy = false;
     mEnabled = false;
@@ -113,36 +118,23 @@ exit:
     return error;
 }
 
-void MeshForwarder::HandleResolved(const Ip6::Address &aEid, ThreadError aError)
+void MeshForwarder::HandleResolved(MessageQueue &aQueue, ThreadError aError)
 {
-    Message *cur, *next;
-    Ip6::Address ip6Dst;
+    Message *message;
     bool enqueuedMessage = false;
 
-    for (cur = mResolvingQueue.GetHead(); cur; cur = next)
+    while ((message = aQueue.GetHead()) != NULL)
     {
-        next = cur->GetNext();
+        aQueue.Dequeue(*message);
 
-        if (cur->GetType() != Message::kTypeIp6)
+        if (aError == kThreadError_None)
         {
-            continue;
+            mSendQueue.Enqueue(*message);
+            enqueuedMessage = true;
         }
-
-        cur->Read(Ip6::Header::GetDestinationOffset(), sizeof(ip6Dst), &ip6Dst);
-
-        if (memcmp(&ip6Dst, &aEid, sizeof(ip6Dst)) == 0)
+        else
         {
-            mResolvingQueue.Dequeue(*cur);
-
-            if (aError == kThreadError_None)
-            {
-                mSendQueue.Enqueue(*cur);
-                enqueuedMessage = true;
-            }
-            else
-            {
-                Message::Free(*cur);
-            }
+            Message::Free(*message);
         }
     }
 
@@ -161,7 +153,7 @@ void MeshForwarder::ScheduleTransmissionTask(void *aContext)
 void MeshForwarder::ScheduleTransmissionTask()
 {
     ThreadError error = kThreadError_None;
-    uint8_t numChildren;
+    uint16_t numChildren;
     Child *children;
 
     VerifyOrExit(mSendBusy == false, error = kThreadError_Busy);
@@ -194,7 +186,7 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
     ThreadError error = kThreadError_None;
     Neighbor *neighbor;
     Ip6::Header ip6Header;
-    uint8_t numChildren;
+    uint16_t numChildren;
     Child *children;
     Lowpan::MeshHeader meshHeader;
 
@@ -215,9 +207,13 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
 
             for (int i = 0; i < numChildren; i++)
             {
-                if (children[i].mState == Neighbor::kStateValid && (children[i].mMode & Mle::ModeTlv::kModeRxOnWhenIdle) == 0)
+                // without a pooled child mask, the child is sent its own copy of the message
+                if (children[i].mState == Neighbor::kStateValid &&
+                    (children[i].mMode & Mle::ModeTlv::kModeRxOnWhenIdle) == 0 &&
+                    aMessage.SetChildMask(i) != kThreadError_None &&
+                    SendCopyToChild(aMessage, i) != kThreadError_None)
                 {
-                    aMessage.SetChildMask(i);
+                    otLogWarnMac("Dropped multicast to sleepy child %d\n", i);
                 }
             }
         }
@@ -225,7 +221,7 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
                  (neighbor->mMode & Mle::ModeTlv::kModeRxOnWhenIdle) == 0)
         {
             // destined for a sleepy child
-            aMessage.SetChildMask(mMle.GetChildIndex(*reinterpret_cast<Child *>(neighbor)));
+            SuccessOrExit(error = aMessage.SetChildMask(mMle.GetChildIndex(*reinterpret_cast<Child *>(neighbor))));
         }
         else
         {
@@ -242,7 +238,7 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
             (neighbor->mMode & Mle::ModeTlv::kModeRxOnWhenIdle) == 0)
         {
             // destined for a sleepy child
-            aMessage.SetChildMask(mMle.GetChildIndex(*reinterpret_cast<Child *>(neighbor)));
+            SuccessOrExit(error = aMessage.SetChildMask(mMle.GetChildIndex(*reinterpret_cast<Child *>(neighbor))));
         }
         else
         {
@@ -265,28 +261,25 @@ exit:
     return error;
 }
 
-void MeshForwarder::MoveToResolving(const Ip6::Address &aDestination)
+ThreadError MeshForwarder::SendCopyToChild(Message &aMessage, uint16_t aChildIndex)
 {
-    Message *cur, *next;
-    Ip6::Address ip6Dst;
+    ThreadError error = kThreadError_None;
+    Message *message;
 
-    for (cur = mSendQueue.GetHead(); cur; cur = next)
-    {
-        next = cur->GetNext();
+    VerifyOrExit((message = Message::New(aMessage.GetType(), 0)) != NULL, error = kThreadError_NoBufs);
+    SuccessOrExit(error = message->SetLength(aMessage.GetLength()));
+    aMessage.CopyTo(0, 0, aMessage.GetLength(), *message);
+    SuccessOrExit(error = message->SetChildMask(aChildIndex));
+    SuccessOrExit(error = mSendQueue.Enqueue(*message));
 
-        if (cur->GetType() != Message::kTypeIp6)
-        {
-            continue;
-        }
-
-        cur->Read(Ip6::Header::GetDestinationOffset(), sizeof(ip6Dst), &ip6Dst);
+exit:
 
-        if (memcmp(&ip6Dst, &aDestination, sizeof(ip6Dst)) == 0)
-        {
-            mSendQueue.Dequeue(*cur);
-            mResolvingQueue.Enqueue(*cur);
-        }
+    if (error != kThreadError_None && message != NULL)
+    {
+        Message::Free(*message);
     }
+
+    return error;
 }
 
 Message *MeshForwarder::GetDirectTransmission()
@@ -325,7 +318,13 @@ Message *MeshForwarder::GetDirectTransmission()
 
         case kThreadError_AddressQuery:
             curMessage->Read(Ip6::Header::GetDestinationOffset(), sizeof(ip6Dst), &ip6Dst);
-            MoveToResolving(ip6Dst);
+            mSendQueue.Dequeue(*curMessage);
+
+            if (mAddressResolver.QueueMessage(ip6Dst, *curMessage) != kThreadError_None)
+            {
+                Message::Free(*curMessage);
+            }
+
             continue;
 
         case kThreadError_Drop:
@@ -543,18 +542,35 @@ void MeshForwarder::SetRxOnWhenIdle(bool aRxOnWhenIdle)
     }
     else
     {
-        mPollTimer.Start(mPollPeriod);
+        ResetPollInterval();
     }
 }
 
 void MeshForwarder::SetPollPeriod(uint32_t aPeriod)
 {
-    if (mMac.GetRxOnWhenIdle() == false && mPollPeriod != aPeriod)
+    if (mPollPeriod != aPeriod)
+    {
+        mPollPeriod = aPeriod;
+
+        if (mMac.GetRxOnWhenIdle() == false)
+        {
+            ResetPollInterval();
+        }
+    }
+}
+
+void MeshForwarder::ResetPollInterval(void)
+{
+    if (mFastPollPeriod != 0 && mFastPollPeriod < mPollPeriod)
+    {
+        mPollInterval = mFastPollPeriod;
+    }
+    else
     {
-        mPollTimer.Start(aPeriod);
+        mPollInterval = mPollPeriod;
     }
 
-    mPollPeriod = aPeriod;
+    mPollTimer.Start(mPollInterval);
 }
 
 void MeshForwarder::HandlePollTimer(void *aContext)
@@ -567,13 +583,22 @@ void MeshForwarder::HandlePollTimer()
 {
     Message *message;
 
+    if (mPollOutstanding)
+    {
+        // nothing arrived since the last poll, back off towards the Data Poll period
+        mWastedPollCount++;
+        mPollInterval = (mPollInterval < mPollPeriod / 2) ? mPollInterval * 2 : mPollPeriod;
+    }
+
     if ((message = Message::New(Message::kTypeMacDataPoll, 0)) != NULL)
     {
         SendMessage(*message);
+        mPollCount++;
+        mPollOutstanding = true;
         otLogInfoMac("Sent poll\n");
     }
 
-    mPollTimer.Start(mPollPeriod);
+    mPollTimer.Start(mPollInterval);
 }
 
 ThreadError MeshForwarder::GetMacSourceAddress(const Ip6::Address &aIp6Addr, Mac::Address &aMacAddr)
@@ -943,6 +968,14 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame)
         }
     }
 
+    if (mPollTimer.IsRunning() && mSendMessage->GetType() != Message::kTypeMacDataPoll &&
+        mFastPollPeriod != 0 && mFastPollPeriod < mPollInterval)
+    {
+        // a response is likely on its way
+        mPollInterval = mFastPollPeriod;
+        mPollTimer.Start(mPollInterval);
+    }
+
     if (mSendMessage->GetDirectTransmission())
     {
         if (mMessageNextOffset < mSendMessage->GetLength())
@@ -1020,14 +1053,25 @@ void MeshForwarder::HandleReceivedFrame(Mac::Frame &aFrame, ThreadError aError)
     }
 
     SuccessOrExit(aFrame.GetDstAddr(macDest));
-    messageInfo.mLinkMargin = aFrame.GetPower() - -100;
+    messageInfo.mLinkMargin = aFrame.GetPower() - LinkQualityInfo::kNoiseFloor;
 
     payload = aFrame.GetPayload();
     payloadLength = aFrame.GetPayloadLength();
 
-    if (mPollTimer.IsRunning() && aFrame.GetFramePending())
+    if (mPollTimer.IsRunning())
     {
-        HandlePollTimer();
+        mPollOutstanding = false;
+
+        if (aFrame.GetFramePending())
+        {
+            HandlePollTimer();
+        }
+        else if (mPollInterval != mPollPeriod)
+        {
+            // the parent has nothing more queued, go back to the Data Poll period
+            mPollInterval = mPollPeriod;
+            mPollTimer.Start(mPollInterval);
+        }
     }
 
     switch (aFrame.GetType())
@@ -1083,6 +1127,8 @@ void MeshForwarder::HandleMesh(uint8_t *aFrame, uint8_t aFrameLength, const Thre
         aFrame += meshHeader->GetHeaderLength();
         aFrameLength -= meshHeader->GetHeaderLength();
 
+        SnoopSourceAddress(aFrame, meshSource, meshDest);
+
         if (reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->IsFragmentHeader())
         {
             HandleFragment(aFrame, aFrameLength, meshSource, meshDest, aMessageInfo);
@@ -1106,7 +1152,7 @@ void MeshForwarder::HandleMesh(uint8_t *aFrame, uint8_t aFrameLength, const Thre
         SuccessOrExit(error = message->SetLength(aFrameLength));
         message->Write(0, aFrameLength, aFrame);
 
-        SendMessage(*message);
+        SuccessOrExit(error = SendMessage(*message));
     }
 
 exit:
@@ -1144,6 +1190,37 @@ exit:
     return error;
 }
 
+void MeshForwarder::SnoopSourceAddress(uint8_t *aFrame, const Mac::Address &aMeshSource,
+                                       const Mac::Address &aMeshDest)
+{
+    Ip6::Header ip6Header;
+
+    // only routers resolve EIDs
+    VerifyOrExit(mMle.GetDeviceMode() & Mle::ModeTlv::kModeFFD, ;);
+
+    // skip fragment header
+    if (reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->IsFragmentHeader())
+    {
+        VerifyOrExit(reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->GetDatagramOffset() == 0, ;);
+        aFrame += reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->GetHeaderLength();
+    }
+
+    // only process IPv6 packets
+    VerifyOrExit(Lowpan::Lowpan::IsLowpanHc(aFrame), ;);
+
+    VerifyOrExit(mLowpan.DecompressBaseHeader(ip6Header, aMeshSource, aMeshDest, aFrame) > 0, ;);
+
+    // the mesh source is only known to reach on-mesh EIDs
+    VerifyOrExit(!ip6Header.GetSource().IsLinkLocal() && !ip6Header.GetSource().IsMulticast() &&
+                 !mMle.IsRoutingLocator(ip6Header.GetSource()) &&
+                 mNetworkData.IsOnMesh(ip6Header.GetSource()), ;);
+
+    mAddressResolver.Snoop(ip6Header.GetSource(), aMeshSource.mShortAddress);
+
+exit:
+    return;
+}
+
 void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
                                    const Mac::Address &aMacSource, const Mac::Address &aMacDest,
                                    const ThreadMessageInfo &aMessageInfo)
@@ -110,11 +110,11 @@ public:
     /**
      * This method is called by the address resolver when an EID-to-RLOC mapping has been resolved.
      *
-     * @param[in]  aEid    A reference to the EID that has been resolved.
+     * @param[in]  aQueue  A reference to the messages that were waiting for the EID.
      * @param[in]  aError  kThreadError_None on success and kThreadError_Drop otherwise.
      *
      */
-    void HandleResolved(const Ip6::Address &aEid, ThreadError aError);
+    void HandleResolved(MessageQueue &aQueue, ThreadError aError);
 
     /**
      * This method indicates whether or not rx-on-when-idle mode is enabled.
@@ -141,10 +141,47 @@ public:
      */
     void SetPollPeriod(uint32_t aPeriod);
 
+    /**
+     * This method returns the fast Data Poll period.
+     *
+     * @returns The fast Data Poll period in milliseconds.
+     *
+     */
+    uint32_t GetFastPollPeriod(void) const { return mFastPollPeriod; }
+
+    /**
+     * This method sets the fast Data Poll period.
+     *
+     * After a frame is sent, the parent is polled at this period and the period doubles after every poll that
+     * brings no data until it reaches the Data Poll period.  Polling returns to the Data Poll period as soon as
+     * a frame without the Frame Pending bit is received.
+     *
+     * @param[in]  aPeriod  The fast Data Poll period in milliseconds, zero always polls at the Data Poll period.
+     *
+     */
+    void SetFastPollPeriod(uint32_t aPeriod) { mFastPollPeriod = aPeriod; }
+
+    /**
+     * This method returns the number of Data Polls sent.
+     *
+     * @returns The number of Data Polls sent.
+     *
+     */
+    uint32_t GetPollCount(void) const { return mPollCount; }
+
+    /**
+     * This method returns the number of Data Polls that were not followed by any frame from the parent.
+     *
+     * @returns The number of wasted Data Polls.
+     *
+     */
+    uint32_t GetWastedPollCount(void) const { return mWastedPollCount; }
+
 private:
     enum
     {
-        kStateUpdatePeriod = 1000,  ///< State update period in milliseconds.
+        kStateUpdatePeriod = 1000,                                   ///< State update period in milliseconds.
+        kFastPollPeriod    = OPENTHREAD_CONFIG_FAST_DATA_POLL_PERIOD, ///< Fast Data Poll period in milliseconds.
     };
 
     ThreadError CheckReachability(uint8_t *aFrame, uint8_t aFrameLength,
@@ -161,13 +198,15 @@ private:
                         const Mac::Address &aMacSource, const Mac::Address &aMacDest,
                         const ThreadMessageInfo &aMessageInfo);
     void HandleDataRequest(const Mac::Address &aMacSource);
-    void MoveToResolving(const Ip6::Address &aDestination);
+    void SnoopSourceAddress(uint8_t *aFrame, const Mac::Address &aMeshSource, const Mac::Address &aMeshDest);
     ThreadError SendPoll(Message &aMessage, Mac::Frame &aFrame);
     ThreadError SendMesh(Message &aMessage, Mac::Frame &aFrame);
     ThreadError SendFragment(Message &aMessage, Mac::Frame &aFrame);
+    ThreadError SendCopyToChild(Message &aMessage, uint16_t aChildIndex);
     void UpdateFramePending(void);
     ThreadError UpdateIp6Route(Message &aMessage);
     ThreadError UpdateMeshRoute(Message &aMessage);
+    void ResetPollInterval(void);
 
     static void HandleReceivedFrame(void *aContext, Mac::Frame &aFrame, ThreadError aError);
     void HandleReceivedFrame(Mac::Frame &aFrame, ThreadError aError);
@@ -193,10 +232,14 @@ private:
 
     MessageQueue mSendQueue;
     MessageQueue mReassemblyList;
-    MessageQueue mResolvingQueue;
     uint16_t mFragTag;
     uint16_t mMessageNextOffset;
     uint32_t mPollPeriod;
+    uint32_t mFastPollPeriod;
+    uint32_t mPollInterval;
+    uint32_t mPollCount;
+    uint32_t mWastedPollCount;
+    bool mPollOutstanding;
     Message *mSendMessage;
 
     Mac::Address mMacSource;
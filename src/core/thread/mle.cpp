@@ -36,11 +36,13 @@
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
+#include <common/settings.hpp>
 #include <crypto/aes_ccm.hpp>
 #include <mac/mac_frame.hpp>
 #include <net/netif.hpp>
 #include <net/udp6.hpp>
 #include <platform/random.h>
+#include <platform/settings.h>
 #include <thread/address_resolver.hpp>
 #include <thread/key_manager.hpp>
 #include <thread/mle_router.hpp>
@@ -68,9 +70,12 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
     mParentRequestState = kParentIdle;
     mParentRequestMode = kMleAttachAnyPartition;
     mTimeout = kMaxNeighborAge;
+    mNumParentCandidates = 0;
+    mTryParentCandidates = false;
 
     memset(&mLeaderData, 0, sizeof(mLeaderData));
     memset(&mParent, 0, sizeof(mParent));
+    memset(&mParentCandidates, 0, sizeof(mParentCandidates));
     memset(&mChildIdRequest, 0, sizeof(mChildIdRequest));
     memset(&mLinkLocal64, 0, sizeof(mLinkLocal64));
     memset(&mLinkLocal16, 0, sizeof(mLinkLocal16));
@@ -151,6 +156,7 @@ ThreadError Mle::Start(void)
     else if (GetChildId(GetRloc16()) == 0)
     {
         mMleRouter.BecomeRouter();
+        mMleRouter.RestoreChildren();
     }
     else
     {
@@ -179,6 +185,187 @@ exit:
     return error;
 }
 
+ThreadError Mle::Restore(void)
+{
+    ThreadError error = kThreadError_None;
+    NetworkInfo networkInfo;
+    ParentInfo parentInfo;
+    char networkName[OT_NETWORK_NAME_SIZE + 1];
+    uint16_t length;
+
+    VerifyOrExit(mDeviceState == kDeviceStateDisabled, error = kThreadError_InvalidState);
+
+    length = sizeof(networkInfo);
+    SuccessOrExit(error = otPlatSettingsGet(Settings::kKeyNetworkInfo, 0, reinterpret_cast<uint8_t *>(&networkInfo),
+                                            &length));
+    VerifyOrExit(length == sizeof(networkInfo) && networkInfo.mMasterKeyLength <= sizeof(networkInfo.mMasterKey),
+                 error = kThreadError_NotFound);
+
+    if (networkInfo.mDeviceState == kDeviceStateChild)
+    {
+        length = sizeof(parentInfo);
+
+        if (otPlatSettingsGet(Settings::kKeyParentInfo, 0, reinterpret_cast<uint8_t *>(&parentInfo),
+                              &length) != kThreadError_None ||
+            length != sizeof(parentInfo))
+        {
+            // without the parent there is nothing to synchronize with, attach from scratch
+            networkInfo.mDeviceState = kDeviceStateDetached;
+            networkInfo.mRloc16 = Mac::kShortAddrInvalid;
+        }
+    }
+
+    length = sizeof(mParentCandidates);
+
+    if (otPlatSettingsGet(Settings::kKeyParentCandidates, 0, reinterpret_cast<uint8_t *>(mParentCandidates),
+                          &length) == kThreadError_None)
+    {
+        if (length > sizeof(mParentCandidates))
+        {
+            length = sizeof(mParentCandidates);
+        }
+
+        mNumParentCandidates = static_cast<uint8_t>(length / sizeof(mParentCandidates[0]));
+        mTryParentCandidates = mNumParentCandidates > 0;
+    }
+
+    // security material, the frame counters are reset by a key sequence change
+    mKeyManager.SetMasterKey(networkInfo.mMasterKey, networkInfo.mMasterKeyLength);
+
+    if (networkInfo.mKeySequence != mKeyManager.GetCurrentKeySequence())
+    {
+        mKeyManager.SetCurrentKeySequence(networkInfo.mKeySequence);
+    }
+
+    // resume at the reserved values, the first frame sent reserves the next ones
+    mKeyManager.SetMleFrameCounter(networkInfo.mMleFrameCounter);
+    mKeyManager.SetMacFrameCounter(networkInfo.mMacFrameCounter);
+    mKeyManager.SetStoredFrameCounters(networkInfo.mMacFrameCounter, networkInfo.mMleFrameCounter);
+
+    // link parameters
+    SuccessOrExit(error = mMac.SetExtAddress(networkInfo.mExtAddress));
+    mLinkLocal64.GetAddress().SetIid(*mMac.GetExtAddress());
+    mMac.SetChannel(networkInfo.mChannel);
+    mMac.SetPanId(networkInfo.mPanId);
+    mMac.SetExtendedPanId(networkInfo.mExtendedPanId);
+
+    memcpy(networkName, networkInfo.mNetworkName, sizeof(networkInfo.mNetworkName));
+    networkName[sizeof(networkInfo.mNetworkName)] = '\0';
+    mMac.SetNetworkName(networkName);
+
+    // mesh link establishment
+    mDeviceMode = networkInfo.mDeviceMode;
+    memcpy(mMeshLocal64.GetAddress().m8 + 8, networkInfo.mMlIid, sizeof(networkInfo.mMlIid));
+
+    switch (networkInfo.mDeviceState)
+    {
+    case kDeviceStateChild:
+        memset(&mParent, 0, sizeof(mParent));
+        memcpy(&mParent.mMacAddr, &parentInfo.mExtAddress, sizeof(mParent.mMacAddr));
+        mParent.mValid.mRloc16 = GetRloc16(GetRouterId(networkInfo.mRloc16));
+        mParent.mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
+        mParent.mState = Neighbor::kStateValid;
+        SetRloc16(networkInfo.mRloc16);
+        break;
+
+    case kDeviceStateRouter:
+    case kDeviceStateLeader:
+        mMleRouter.SetRouterId(GetRouterId(networkInfo.mRloc16));
+        SetRloc16(networkInfo.mRloc16);
+        break;
+
+    default:
+        SetRloc16(Mac::kShortAddrInvalid);
+        break;
+    }
+
+    otLogInfoMle("Restored network information, rloc16 %04x\n", GetRloc16());
+
+exit:
+    return error;
+}
+
+ThreadError Mle::Store(void)
+{
+    ThreadError error = kThreadError_None;
+    NetworkInfo networkInfo;
+    ParentInfo parentInfo;
+    const uint8_t *masterKey;
+
+    memset(&networkInfo, 0, sizeof(networkInfo));
+    networkInfo.mDeviceState = mDeviceState;
+    networkInfo.mDeviceMode = mDeviceMode;
+    networkInfo.mRloc16 = GetRloc16();
+    networkInfo.mKeySequence = mKeyManager.GetCurrentKeySequence();
+    networkInfo.mMleFrameCounter = mKeyManager.GetMleFrameCounter() + KeyManager::kStoreFrameCounterAhead;
+    networkInfo.mMacFrameCounter = mKeyManager.GetMacFrameCounter() + KeyManager::kStoreFrameCounterAhead;
+    memcpy(&networkInfo.mExtAddress, mMac.GetExtAddress(), sizeof(networkInfo.mExtAddress));
+    memcpy(networkInfo.mMlIid, mMeshLocal64.GetAddress().m8 + 8, sizeof(networkInfo.mMlIid));
+    masterKey = mKeyManager.GetMasterKey(&networkInfo.mMasterKeyLength);
+    memcpy(networkInfo.mMasterKey, masterKey, networkInfo.mMasterKeyLength);
+    networkInfo.mChannel = mMac.GetChannel();
+    networkInfo.mPanId = mMac.GetPanId();
+    memcpy(networkInfo.mExtendedPanId, mMac.GetExtendedPanId(), sizeof(networkInfo.mExtendedPanId));
+    memcpy(networkInfo.mNetworkName, mMac.GetNetworkName(), sizeof(networkInfo.mNetworkName));
+
+    SuccessOrExit(error = otPlatSettingsSet(Settings::kKeyNetworkInfo, reinterpret_cast<const uint8_t *>(&networkInfo),
+                                            sizeof(networkInfo)));
+    mKeyManager.SetStoredFrameCounters(networkInfo.mMacFrameCounter, networkInfo.mMleFrameCounter);
+
+    if (mDeviceState == kDeviceStateChild)
+    {
+        memcpy(&parentInfo.mExtAddress, &mParent.mMacAddr, sizeof(parentInfo.mExtAddress));
+        SuccessOrExit(error = otPlatSettingsSet(Settings::kKeyParentInfo,
+                                                reinterpret_cast<const uint8_t *>(&parentInfo), sizeof(parentInfo)));
+    }
+    else
+    {
+        otPlatSettingsDelete(Settings::kKeyParentInfo, -1);
+    }
+
+    if (mDeviceState != kDeviceStateRouter && mDeviceState != kDeviceStateLeader)
+    {
+        otPlatSettingsDelete(Settings::kKeyChildInfo, -1);
+    }
+
+exit:
+    return error;
+}
+
+ThreadError Mle::StoreFrameCounters(void)
+{
+    ThreadError error = kThreadError_None;
+    NetworkInfo networkInfo;
+    uint16_t length;
+    uint32_t macFrameCounter = mKeyManager.GetMacFrameCounter() + KeyManager::kStoreFrameCounterAhead;
+    uint32_t mleFrameCounter = mKeyManager.GetMleFrameCounter() + KeyManager::kStoreFrameCounterAhead;
+
+    length = sizeof(networkInfo);
+    SuccessOrExit(error = otPlatSettingsGet(Settings::kKeyNetworkInfo, 0, reinterpret_cast<uint8_t *>(&networkInfo),
+                                            &length));
+    VerifyOrExit(length == sizeof(networkInfo), error = kThreadError_NotFound);
+
+    networkInfo.mKeySequence = mKeyManager.GetCurrentKeySequence();
+    networkInfo.mMacFrameCounter = macFrameCounter;
+    networkInfo.mMleFrameCounter = mleFrameCounter;
+
+    SuccessOrExit(error = otPlatSettingsSet(Settings::kKeyNetworkInfo, reinterpret_cast<const uint8_t *>(&networkInfo),
+                                            sizeof(networkInfo)));
+
+    // the saved values only move after a successful write, a failed write is retried on the next frame sent
+    mKeyManager.SetStoredFrameCounters(macFrameCounter, mleFrameCounter);
+
+exit:
+
+    if (error == kThreadError_NotFound)
+    {
+        // nothing is saved, so a reset cannot resume at a frame counter already used
+        mKeyManager.ClearStoredFrameCounters();
+    }
+
+    return error;
+}
+
 ThreadError Mle::BecomeDetached(void)
 {
     ThreadError error = kThreadError_None;
@@ -187,6 +374,7 @@ ThreadError Mle::BecomeDetached(void)
 
     SetStateDetached();
     SetRloc16(Mac::kShortAddrInvalid);
+    Store();
     BecomeChild(kMleAttachAnyPartition);
 
 exit:
@@ -209,7 +397,18 @@ ThreadError Mle::BecomeChild(otMleAttachFilter aFilter)
         mParent.mState = Neighbor::kStateInvalid;
     }
 
-    mParentRequestTimer.Start(kParentRequestRouterTimeout);
+    if (aFilter == kMleAttachAnyPartition && mTryParentCandidates)
+    {
+        // previous parents are asked once, the multicast search follows if none of them answers
+        mTryParentCandidates = false;
+        mParentRequestState = kParentRequestCached;
+        SendParentRequest();
+        mParentRequestTimer.Start(kParentRequestCachedTimeout);
+    }
+    else
+    {
+        mParentRequestTimer.Start(kParentRequestRouterTimeout);
+    }
 
 exit:
     return error;
@@ -228,6 +427,7 @@ ThreadError Mle::SetStateDetached(void)
     mParentRequestTimer.Stop();
     mMesh.SetRxOnWhenIdle(true);
     mMleRouter.HandleDetachStart();
+    Ip6::Ip6::SetMplTimerExpirations(kMplChildDataMessageTimerExpirations);
     otLogInfoMle("Mode -> Detached\n");
     return kThreadError_None;
 }
@@ -237,6 +437,7 @@ ThreadError Mle::SetStateChild(uint16_t aRloc16)
     SetRloc16(aRloc16);
     mDeviceState = kDeviceStateChild;
     mParentRequestState = kParentIdle;
+    Ip6::Ip6::SetMplTimerExpirations(kMplChildDataMessageTimerExpirations);
 
     if ((mDeviceMode & ModeTlv::kModeRxOnWhenIdle) != 0)
     {
@@ -248,6 +449,8 @@ ThreadError Mle::SetStateChild(uint16_t aRloc16)
         mMleRouter.HandleChildStart(mParentRequestMode);
     }
 
+    AddParentCandidate();
+    Store();
     otLogInfoMle("Mode -> Child\n");
     return kThreadError_None;
 }
@@ -339,10 +542,24 @@ ThreadError Mle::SetMeshLocalPrefix(const uint8_t *aExtendedPanId)
     mRealmLocalAllThreadNodes.GetAddress().m8[3] = 64;
     memcpy(mRealmLocalAllThreadNodes.GetAddress().m8 + 4, &mMeshLocal64.GetAddress(), 8);
 
+    // re-index the modified addresses (the interface re-indexes all addresses when brought up)
+    if (mDeviceState != kDeviceStateDisabled)
+    {
+        mNetif.AddUnicastAddress(mMeshLocal64);
+
+        if (GetRloc16() != Mac::kShortAddrInvalid)
+        {
+            mNetif.AddUnicastAddress(mMeshLocal16);
+        }
+
+        mNetif.SubscribeMulticast(mLinkLocalAllThreadNodes);
+        mNetif.SubscribeMulticast(mRealmLocalAllThreadNodes);
+    }
+
     return kThreadError_None;
 }
 
-const uint8_t Mle::GetChildId(uint16_t aRloc16) const
+const uint16_t Mle::GetChildId(uint16_t aRloc16) const
 {
     return aRloc16 & kChildIdMask;
 }
@@ -588,16 +805,34 @@ ThreadError Mle::AppendLeaderData(Message &aMessage)
 }
 
 ThreadError Mle::AppendNetworkData(Message &aMessage, bool aStableOnly)
+{
+    const uint8_t *data;
+    uint16_t length;
+
+    if (aStableOnly)
+    {
+        data = mNetworkData.GetStableTlvs(length);
+    }
+    else
+    {
+        data = mNetworkData.GetTlvs(length);
+    }
+
+    return Tlv::Append(aMessage, Tlv::kNetworkData, data, length);
+}
+
+ThreadError Mle::AppendNetworkDataDelta(Message &aMessage, uint8_t aVersion)
 {
     ThreadError error = kThreadError_None;
-    NetworkDataTlv tlv;
+    NetworkDataDeltaTlv tlv;
     uint8_t length;
 
     tlv.Init();
-    mNetworkData.GetNetworkData(aStableOnly, tlv.GetNetworkData(), length);
+    length = tlv.GetLength();
+    SuccessOrExit(error = mNetworkData.GetDeltas(aVersion, tlv.GetDeltas(), length));
     tlv.SetLength(length);
 
-    SuccessOrExit(error = aMessage.Append(&tlv, sizeof(Tlv) + tlv.GetLength()));
+    SuccessOrExit(error = aMessage.Append(&tlv, sizeof(Tlv) + length));
 
 exit:
     return error;
@@ -655,7 +890,7 @@ ThreadError Mle::AppendAddressRegistration(Message &aMessage)
     AddressRegistrationEntry entry;
     Lowpan::Context context;
     uint8_t length = 0;
-    uint8_t startOffset = aMessage.GetLength();
+    uint16_t startOffset = aMessage.GetLength();
 
     tlv.SetType(Tlv::kAddressRegistration);
     SuccessOrExit(error = aMessage.Append(&tlv, sizeof(tlv)));
@@ -753,6 +988,7 @@ void Mle::HandleParentRequestTimer(void)
         BecomeChild(kMleAttachAnyPartition);
         break;
 
+    case kParentRequestCached:
     case kParentRequestStart:
         mParentRequestState = kParentRequestRouter;
         mParent.mState = Neighbor::kStateInvalid;
@@ -827,11 +1063,81 @@ void Mle::HandleParentRequestTimer(void)
     }
 }
 
+void Mle::AddParentCandidate(void)
+{
+    ParentCandidate candidate;
+    uint8_t index;
+
+    memset(&candidate, 0, sizeof(candidate));
+    memcpy(&candidate.mExtAddress, &mParent.mMacAddr, sizeof(candidate.mExtAddress));
+    candidate.mPartitionId = mLeaderData.GetPartitionId();
+    candidate.mRloc16 = mParent.mValid.mRloc16;
+    candidate.mLinkMargin = mParent.mLinkInfo.GetAverageLinkMargin();
+
+    mTryParentCandidates = true;
+
+    for (index = 0; index < mNumParentCandidates; index++)
+    {
+        if (memcmp(&mParentCandidates[index].mExtAddress, &candidate.mExtAddress, sizeof(candidate.mExtAddress)) == 0)
+        {
+            break;
+        }
+    }
+
+    if (index == mNumParentCandidates)
+    {
+        if (mNumParentCandidates < kMaxParentCandidates)
+        {
+            mNumParentCandidates++;
+        }
+        else
+        {
+            // evict the previous parent with the weakest link
+            index = 0;
+
+            for (uint8_t i = 1; i < mNumParentCandidates; i++)
+            {
+                if (mParentCandidates[i].mLinkMargin <= mParentCandidates[index].mLinkMargin)
+                {
+                    index = i;
+                }
+            }
+        }
+    }
+    else if (index == 0 && memcmp(&mParentCandidates[0], &candidate, sizeof(candidate)) == 0)
+    {
+        ExitNow();
+    }
+
+    // most recent parent first, it is the first to get a Parent Request
+    memmove(&mParentCandidates[1], &mParentCandidates[0], index * sizeof(mParentCandidates[0]));
+    mParentCandidates[0] = candidate;
+
+    otPlatSettingsSet(Settings::kKeyParentCandidates, reinterpret_cast<const uint8_t *>(mParentCandidates),
+                      mNumParentCandidates * sizeof(mParentCandidates[0]));
+
+exit:
+    {}
+}
+
+const Mle::ParentCandidate *Mle::FindParentCandidate(const Mac::ExtAddress &aMacAddr) const
+{
+    const ParentCandidate *rval = NULL;
+
+    for (uint8_t i = 0; i < mNumParentCandidates; i++)
+    {
+        if (memcmp(&mParentCandidates[i].mExtAddress, &aMacAddr, sizeof(aMacAddr)) == 0)
+        {
+            ExitNow(rval = &mParentCandidates[i]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
 ThreadError Mle::SendParentRequest(void)
 {
-    ThreadError error = kThreadError_None;
-    Message *message;
-    uint8_t scanMask = 0;
     Ip6::Address destination;
 
     for (uint8_t i = 0; i < sizeof(mParentRequest.mChallenge); i++)
@@ -839,6 +1145,34 @@ ThreadError Mle::SendParentRequest(void)
         mParentRequest.mChallenge[i] = otPlatRandomGet();
     }
 
+    memset(&destination, 0, sizeof(destination));
+
+    if (mParentRequestState == kParentRequestCached)
+    {
+        destination.m16[0] = HostSwap16(0xfe80);
+
+        for (uint8_t i = 0; i < mNumParentCandidates; i++)
+        {
+            destination.SetIid(mParentCandidates[i].mExtAddress);
+            SendParentRequest(destination);
+        }
+    }
+    else
+    {
+        destination.m16[0] = HostSwap16(0xff02);
+        destination.m16[7] = HostSwap16(0x0002);
+        SendParentRequest(destination);
+    }
+
+    return kThreadError_None;
+}
+
+ThreadError Mle::SendParentRequest(const Ip6::Address &aDestination)
+{
+    ThreadError error = kThreadError_None;
+    Message *message;
+    uint8_t scanMask = 0;
+
     VerifyOrExit((message = Ip6::Udp::NewMessage(0)) != NULL, ;);
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandParentRequest));
     SuccessOrExit(error = AppendMode(*message, mDeviceMode));
@@ -850,6 +1184,7 @@ ThreadError Mle::SendParentRequest(void)
         scanMask = ScanMaskTlv::kRouterFlag;
         break;
 
+    case kParentRequestCached:
     case kParentRequestChild:
         scanMask = ScanMaskTlv::kRouterFlag | ScanMaskTlv::kEndDeviceFlag;
         break;
@@ -861,14 +1196,14 @@ ThreadError Mle::SendParentRequest(void)
 
     SuccessOrExit(error = AppendScanMask(*message, scanMask));
     SuccessOrExit(error = AppendVersion(*message));
-
-    memset(&destination, 0, sizeof(destination));
-    destination.m16[0] = HostSwap16(0xff02);
-    destination.m16[7] = HostSwap16(0x0002);
-    SuccessOrExit(error = SendMessage(*message, destination));
+    SuccessOrExit(error = SendMessage(*message, aDestination));
 
     switch (mParentRequestState)
     {
+    case kParentRequestCached:
+        otLogInfoMle("Sent parent request to previous parent\n");
+        break;
+
     case kParentRequestRouter:
         otLogInfoMle("Sent parent request to routers\n");
         break;
@@ -946,6 +1281,17 @@ ThreadError Mle::SendDataRequest(const Ip6::Address &aDestination, const uint8_t
     SuccessOrExit(error = AppendHeader(*message, Header::kCommandDataRequest));
     SuccessOrExit(error = AppendTlvRequest(*message, aTlvs, aTlvsLength));
 
+    if (NetworkData::Leader::kDeltaHistory > 0 && (mDeviceMode & ModeTlv::kModeFullNetworkData) &&
+        memchr(aTlvs, Tlv::kNetworkDataDelta, aTlvsLength) != NULL)
+    {
+        NetworkDataDeltaTlv delta;
+
+        delta.Init();
+        delta.SetLength(sizeof(uint8_t));
+        delta.SetVersion(mNetworkData.GetVersion());
+        SuccessOrExit(error = message->Append(&delta, sizeof(Tlv) + delta.GetLength()));
+    }
+
     SuccessOrExit(error = SendMessage(*message, aDestination));
 
     otLogInfoMle("Sent Data Request\n");
@@ -960,7 +1306,8 @@ exit:
     return error;
 }
 
-ThreadError Mle::SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength)
+ThreadError Mle::SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength,
+                                  const uint8_t *aDeltaVersion)
 {
     ThreadError error = kThreadError_None;
     Message *message;
@@ -982,6 +1329,13 @@ ThreadError Mle::SendDataResponse(const Ip6::Address &aDestination, const uint8_
 
         case Tlv::kNetworkData:
             stableOnly = neighbor != NULL ? (neighbor->mMode & ModeTlv::kModeFullNetworkData) == 0 : false;
+
+            if (aDeltaVersion != NULL && !stableOnly && !aDestination.IsMulticast() &&
+                AppendNetworkDataDelta(*message, *aDeltaVersion) == kThreadError_None)
+            {
+                break;
+            }
+
             SuccessOrExit(error = AppendNetworkData(*message, stableOnly));
             break;
         }
@@ -1076,6 +1430,8 @@ ThreadError Mle::SendMessage(Message &aMessage, const Ip6::Address &aDestination
     int length;
     Ip6::MessageInfo messageInfo;
 
+    SuccessOrExit(error = mKeyManager.CheckMleFrameCounter());
+
     aMessage.Read(0, sizeof(header), &header);
     header.SetFrameCounter(mKeyManager.GetMleFrameCounter());
 
@@ -1148,6 +1504,7 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     uint8_t tagLength;
     uint8_t command;
     Neighbor *neighbor;
+    TlvIndex tlvs;
 
     aMessage.Read(aMessage.GetOffset(), sizeof(header), &header);
     VerifyOrExit(header.IsValid(),);
@@ -1240,6 +1597,8 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     aMessage.Read(aMessage.GetOffset(), sizeof(command), &command);
     aMessage.MoveOffset(sizeof(command));
 
+    Tlv::InitIndex(tlvs, aMessage);
+
     switch (mDeviceState)
     {
     case kDeviceStateDetached:
@@ -1296,15 +1655,15 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     switch (command)
     {
     case Header::kCommandLinkRequest:
-        mMleRouter.HandleLinkRequest(aMessage, aMessageInfo);
+        mMleRouter.HandleLinkRequest(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandLinkAccept:
-        mMleRouter.HandleLinkAccept(aMessage, aMessageInfo, keySequence);
+        mMleRouter.HandleLinkAccept(aMessage, tlvs, aMessageInfo, keySequence);
         break;
 
     case Header::kCommandLinkAcceptAndRequest:
-        mMleRouter.HandleLinkAcceptAndRequest(aMessage, aMessageInfo, keySequence);
+        mMleRouter.HandleLinkAcceptAndRequest(aMessage, tlvs, aMessageInfo, keySequence);
         break;
 
     case Header::kCommandLinkReject:
@@ -1312,39 +1671,39 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
         break;
 
     case Header::kCommandAdvertisement:
-        HandleAdvertisement(aMessage, aMessageInfo);
+        HandleAdvertisement(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandDataRequest:
-        HandleDataRequest(aMessage, aMessageInfo);
+        HandleDataRequest(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandDataResponse:
-        HandleDataResponse(aMessage, aMessageInfo);
+        HandleDataResponse(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandParentRequest:
-        mMleRouter.HandleParentRequest(aMessage, aMessageInfo);
+        mMleRouter.HandleParentRequest(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandParentResponse:
-        HandleParentResponse(aMessage, aMessageInfo, keySequence);
+        HandleParentResponse(aMessage, tlvs, aMessageInfo, keySequence);
         break;
 
     case Header::kCommandChildIdRequest:
-        mMleRouter.HandleChildIdRequest(aMessage, aMessageInfo, keySequence);
+        mMleRouter.HandleChildIdRequest(aMessage, tlvs, aMessageInfo, keySequence);
         break;
 
     case Header::kCommandChildIdResponse:
-        HandleChildIdResponse(aMessage, aMessageInfo);
+        HandleChildIdResponse(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandChildUpdateRequest:
-        mMleRouter.HandleChildUpdateRequest(aMessage, aMessageInfo);
+        mMleRouter.HandleChildUpdateRequest(aMessage, tlvs, aMessageInfo);
         break;
 
     case Header::kCommandChildUpdateResponse:
-        HandleChildUpdateResponse(aMessage, aMessageInfo);
+        HandleChildUpdateResponse(aMessage, tlvs, aMessageInfo);
         break;
     }
 
@@ -1352,18 +1711,25 @@ exit:
     {}
 }
 
-ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError Mle::HandleAdvertisement(const Message &aMessage, const TlvIndex &aTlvs,
+                                     const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     Mac::ExtAddress macAddr;
     bool isNeighbor;
     Neighbor *neighbor;
     LeaderDataTlv leaderData;
-    uint8_t tlvs[] = {Tlv::kLeaderData, Tlv::kNetworkData};
+    uint8_t tlvs[] =
+    {
+        Tlv::kLeaderData, Tlv::kNetworkData,
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+        Tlv::kNetworkDataDelta,
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+    };
 
     if (mDeviceState != kDeviceStateDetached)
     {
-        SuccessOrExit(error = mMleRouter.HandleAdvertisement(aMessage, aMessageInfo));
+        SuccessOrExit(error = mMleRouter.HandleAdvertisement(aMessage, aTlvs, aMessageInfo));
     }
 
     macAddr.Set(aMessageInfo.GetPeerAddr());
@@ -1384,6 +1750,7 @@ ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::Message
 
         isNeighbor = true;
         mParent.mLastHeard = mParentRequestTimer.GetNow();
+        mParent.mLinkQualityIn = mParent.mLinkInfo.GetLinkQuality();
         break;
 
     case kDeviceStateRouter:
@@ -1399,7 +1766,7 @@ ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::Message
 
     if (isNeighbor)
     {
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
         VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
         if (static_cast<int8_t>(leaderData.GetDataVersion() - mNetworkData.GetVersion()) > 0)
@@ -1412,69 +1779,81 @@ exit:
     return error;
 }
 
-ThreadError Mle::HandleDataRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError Mle::HandleDataRequest(const Message &aMessage, const TlvIndex &aTlvs, const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     TlvRequestTlv tlvRequest;
+    NetworkDataDeltaTlv delta;
+    uint8_t deltaVersion;
+    const uint8_t *deltaVersionPtr = NULL;
 
     otLogInfoMle("Received Data Request\n");
 
     // TLV Request
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest));
     VerifyOrExit(tlvRequest.IsValid(), error = kThreadError_Parse);
 
-    SendDataResponse(aMessageInfo.GetPeerAddr(), tlvRequest.GetTlvs(), tlvRequest.GetLength());
+    // Network Data Delta (optional)
+    if (Tlv::GetTlv(aTlvs, Tlv::kNetworkDataDelta, sizeof(Tlv) + sizeof(uint8_t), delta) == kThreadError_None &&
+        delta.IsValid())
+    {
+        deltaVersion = delta.GetVersion();
+        deltaVersionPtr = &deltaVersion;
+    }
+
+    SendDataResponse(aMessageInfo.GetPeerAddr(), tlvRequest.GetTlvs(), tlvRequest.GetLength(), deltaVersionPtr);
 
 exit:
     return error;
 }
 
-ThreadError Mle::HandleDataResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError Mle::HandleDataResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                    const Ip6::MessageInfo &aMessageInfo)
 {
+    static const uint8_t tlvs[] = {Tlv::kLeaderData, Tlv::kNetworkData};
     ThreadError error = kThreadError_None;
     LeaderDataTlv leaderData;
-    NetworkDataTlv networkData;
+    uint16_t networkDataOffset;
+    uint16_t networkDataLength;
+    NetworkDataDeltaTlv delta;
     int8_t diff;
 
     otLogInfoMle("Received Data Response\n");
 
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kNetworkData, sizeof(networkData), networkData));
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
     VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
     diff = leaderData.GetDataVersion() - mNetworkData.GetVersion();
     VerifyOrExit(diff > 0, ;);
 
-    mNetworkData.SetNetworkData(leaderData.GetDataVersion(), leaderData.GetStableDataVersion(),
-                                (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
-                                networkData.GetNetworkData(), networkData.GetLength());
+    if (Tlv::GetTlv(aTlvs, Tlv::kNetworkDataDelta, sizeof(delta), delta) == kThreadError_None)
+    {
+        VerifyOrExit(delta.IsValid(), error = kThreadError_Parse);
 
-exit:
-    return error;
-}
+        if ((mDeviceMode & ModeTlv::kModeFullNetworkData) == 0 ||
+            mNetworkData.ApplyDeltas(leaderData.GetDataVersion(), leaderData.GetStableDataVersion(),
+                                     delta.GetDeltas(), delta.GetLength()) != kThreadError_None)
+        {
+            // fall back to the complete Network Data
+            otLogInfoMle("Network data delta not applicable\n");
+            SendDataRequest(aMessageInfo.GetPeerAddr(), tlvs, sizeof(tlvs));
+        }
 
-uint8_t Mle::LinkMarginToQuality(uint8_t aLinkMargin)
-{
-    if (aLinkMargin > 20)
-    {
-        return 3;
-    }
-    else if (aLinkMargin > 10)
-    {
-        return 2;
-    }
-    else if (aLinkMargin > 2)
-    {
-        return 1;
-    }
-    else
-    {
-        return 0;
+        ExitNow();
     }
+
+    SuccessOrExit(error = Tlv::GetValueOffset(aTlvs, Tlv::kNetworkData, networkDataOffset, networkDataLength));
+    SuccessOrExit(error = mNetworkData.SetNetworkData(leaderData.GetDataVersion(),
+                                                      leaderData.GetStableDataVersion(),
+                                                      (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
+                                                      aMessage, networkDataOffset, networkDataLength));
+
+exit:
+    return error;
 }
 
-ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                      uint32_t aKeySequence)
+ThreadError Mle::HandleParentResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                      const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence)
 {
     ThreadError error = kThreadError_None;
     ResponseTlv response;
@@ -1490,21 +1869,23 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
     MleFrameCounterTlv mleFrameCounter;
     ChallengeTlv challenge;
     int8_t diff;
+    Mac::ExtAddress macAddr;
+    const ParentCandidate *candidate;
 
     otLogInfoMle("Received Parent Response\n");
 
     // Response
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kResponse, sizeof(response), response));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kResponse, sizeof(response), response));
     VerifyOrExit(response.IsValid() &&
                  memcmp(response.GetResponse(), mParentRequest.mChallenge, response.GetLength()) == 0,
                  error = kThreadError_Parse);
 
     // Source Address
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
     VerifyOrExit(sourceAddress.IsValid(), error = kThreadError_Parse);
 
     // Leader Data
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
     VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
     // Weight
@@ -1513,6 +1894,14 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
     // Partition ID
     peerPartitionId = leaderData.GetPartitionId();
 
+    // a previous parent is only taken back within the partition it was attached to
+    if (mParentRequestState == kParentRequestCached)
+    {
+        macAddr.Set(aMessageInfo.GetPeerAddr());
+        VerifyOrExit((candidate = FindParentCandidate(macAddr)) != NULL &&
+                     candidate->mPartitionId == peerPartitionId, ;);
+    }
+
     if (mDeviceState != kDeviceStateDetached)
     {
         switch (mParentRequestMode)
@@ -1545,7 +1934,7 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
     }
 
     // Link Quality
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkMargin, sizeof(linkMarginTlv), linkMarginTlv));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLinkMargin, sizeof(linkMarginTlv), linkMarginTlv));
     VerifyOrExit(linkMarginTlv.IsValid(), error = kThreadError_Parse);
 
     linkMargin = reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo)->mLinkMargin;
@@ -1555,12 +1944,12 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
         linkMargin = linkMarginTlv.GetLinkMargin();
     }
 
-    link_quality = LinkMarginToQuality(linkMargin);
+    link_quality = LinkQualityInfo::LinkMarginToQuality(linkMargin);
 
     VerifyOrExit(mParentRequestState != kParentRequestRouter || link_quality == 3, ;);
 
     // Connectivity
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kConnectivity, sizeof(connectivity), connectivity));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kConnectivity, sizeof(connectivity), connectivity));
     VerifyOrExit(connectivity.IsValid(), error = kThreadError_Parse);
 
     if (peerPartitionId == mLeaderData.GetPartitionId())
@@ -1581,12 +1970,12 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
     }
 
     // Link Frame Counter
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter),
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter),
                                       linkFrameCounter));
     VerifyOrExit(linkFrameCounter.IsValid(), error = kThreadError_Parse);
 
     // Mle Frame Counter
-    if (Tlv::GetTlv(aMessage, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) ==
+    if (Tlv::GetTlv(aTlvs, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) ==
         kThreadError_None)
     {
         VerifyOrExit(mleFrameCounter.IsValid(), ;);
@@ -1597,7 +1986,7 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
     }
 
     // Challenge
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kChallenge, sizeof(challenge), challenge));
     VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
     memcpy(mChildIdRequest.mChallenge, challenge.GetChallenge(), challenge.GetLength());
     mChildIdRequest.mChallengeLength = challenge.GetLength();
@@ -1607,23 +1996,36 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
     mParent.mValid.mLinkFrameCounter = linkFrameCounter.GetFrameCounter();
     mParent.mValid.mMleFrameCounter = mleFrameCounter.GetFrameCounter();
     mParent.mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
+    mParent.mLinkInfo.Clear();
+    mParent.mLinkInfo.AddLinkMargin(reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo)->mLinkMargin);
+    mParent.mLinkQualityIn = mParent.mLinkInfo.GetLinkQuality();
     mParent.mState = Neighbor::kStateValid;
     assert(aKeySequence == mKeyManager.GetCurrentKeySequence() ||
            aKeySequence == mKeyManager.GetPreviousKeySequence());
     mParent.mPreviousKey = aKeySequence == mKeyManager.GetPreviousKeySequence();
     mParentConnectivity = connectivity_metric;
 
+    if (mParentRequestState == kParentRequestCached)
+    {
+        // the first previous parent to answer is taken without waiting for the others
+        SendChildIdRequest();
+        mParentRequestState = kChildIdRequest;
+        mParentRequestTimer.Start(kParentRequestChildTimeout);
+    }
+
 exit:
     return error;
 }
 
-ThreadError Mle::HandleChildIdResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError Mle::HandleChildIdResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                       const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     LeaderDataTlv leaderData;
     SourceAddressTlv sourceAddress;
     Address16Tlv shortAddress;
-    NetworkDataTlv networkData;
+    uint16_t networkDataOffset;
+    uint16_t networkDataLength;
     RouteTlv route;
     uint8_t numRouters;
 
@@ -1632,22 +2034,23 @@ ThreadError Mle::HandleChildIdResponse(const Message &aMessage, const Ip6::Messa
     VerifyOrExit(mParentRequestState == kChildIdRequest, ;);
 
     // Leader Data
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
     VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
     // Source Address
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
     VerifyOrExit(sourceAddress.IsValid(), error = kThreadError_Parse);
 
     // ShortAddress
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kAddress16, sizeof(shortAddress), shortAddress));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kAddress16, sizeof(shortAddress), shortAddress));
     VerifyOrExit(shortAddress.IsValid(), error = kThreadError_Parse);
 
     // Network Data
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kNetworkData, sizeof(networkData), networkData));
-    mNetworkData.SetNetworkData(leaderData.GetDataVersion(), leaderData.GetStableDataVersion(),
-                                (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
-                                networkData.GetNetworkData(), networkData.GetLength());
+    SuccessOrExit(error = Tlv::GetValueOffset(aTlvs, Tlv::kNetworkData, networkDataOffset, networkDataLength));
+    SuccessOrExit(error = mNetworkData.SetNetworkData(leaderData.GetDataVersion(),
+                                                      leaderData.GetStableDataVersion(),
+                                                      (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
+                                                      aMessage, networkDataOffset, networkDataLength));
 
     // Parent Attach Success
     mParentRequestTimer.Stop();
@@ -1670,7 +2073,7 @@ ThreadError Mle::HandleChildIdResponse(const Message &aMessage, const Ip6::Messa
     SuccessOrExit(error = SetStateChild(shortAddress.GetRloc16()));
 
     // Route
-    if (Tlv::GetTlv(aMessage, Tlv::kRoute, sizeof(route), route) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kRoute, sizeof(route), route) == kThreadError_None)
     {
         numRouters = 0;
 
@@ -1692,7 +2095,8 @@ exit:
     return error;
 }
 
-ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                           const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     StatusTlv status;
@@ -1701,19 +2105,25 @@ ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const Ip6::M
     LeaderDataTlv leaderData;
     SourceAddressTlv sourceAddress;
     TimeoutTlv timeout;
-    uint8_t tlvs[] = {Tlv::kLeaderData, Tlv::kNetworkData};
+    uint8_t tlvs[] =
+    {
+        Tlv::kLeaderData, Tlv::kNetworkData,
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+        Tlv::kNetworkDataDelta,
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+    };
 
     otLogInfoMle("Received Child Update Response\n");
 
     // Status
-    if (Tlv::GetTlv(aMessage, Tlv::kStatus, sizeof(status), status) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kStatus, sizeof(status), status) == kThreadError_None)
     {
         BecomeDetached();
         ExitNow();
     }
 
     // Mode
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kMode, sizeof(mode), mode));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kMode, sizeof(mode), mode));
     VerifyOrExit(mode.IsValid(), error = kThreadError_Parse);
     VerifyOrExit(mode.GetMode() == mDeviceMode, error = kThreadError_Drop);
 
@@ -1721,7 +2131,7 @@ ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const Ip6::M
     {
     case kDeviceStateDetached:
         // Response
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kResponse, sizeof(response), response));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kResponse, sizeof(response), response));
         VerifyOrExit(response.IsValid(), error = kThreadError_Parse);
         VerifyOrExit(memcmp(response.GetResponse(), mParentRequest.mChallenge,
                             sizeof(mParentRequest.mChallenge)) == 0,
@@ -1732,7 +2142,7 @@ ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const Ip6::M
 
     case kDeviceStateChild:
         // Leader Data
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
         VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
         if (static_cast<int8_t>(leaderData.GetDataVersion() - mNetworkData.GetVersion()) > 0)
@@ -1741,7 +2151,7 @@ ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const Ip6::M
         }
 
         // Source Address
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
         VerifyOrExit(sourceAddress.IsValid(), error = kThreadError_Parse);
 
         if (GetRouterId(sourceAddress.GetRloc16()) != GetRouterId(GetRloc16()))
@@ -1751,7 +2161,7 @@ ThreadError Mle::HandleChildUpdateResponse(const Message &aMessage, const Ip6::M
         }
 
         // Timeout
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kTimeout, sizeof(timeout), timeout));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kTimeout, sizeof(timeout), timeout));
         VerifyOrExit(timeout.IsValid(), error = kThreadError_Parse);
 
         mTimeout = timeout.GetTimeout();
@@ -39,6 +39,7 @@
 #include <common/timer.hpp>
 #include <mac/mac.hpp>
 #include <net/udp6.hpp>
+#include <thread/key_manager.hpp>
 #include <thread/mle_constants.hpp>
 #include <thread/mle_tlvs.hpp>
 #include <thread/topology.hpp>
@@ -47,7 +48,6 @@ namespace Thread {
 
 class ThreadNetif;
 class AddressResolver;
-class KeyManager;
 class MeshForwarder;
 
 namespace Mac { class Mac; }
@@ -342,6 +342,42 @@ public:
      */
     ThreadError Stop(void);
 
+    /**
+     * This method restores the network information from non-volatile memory.
+     *
+     * This method must be called while the protocol operation is stopped.  The restored state is resumed by the next
+     * call to Start().
+     *
+     * @retval kThreadError_None          Successfully restored the network information.
+     * @retval kThreadError_NotFound      There is no valid network information in non-volatile memory.
+     * @retval kThreadError_InvalidState  The protocol operation was already started.
+     *
+     */
+    ThreadError Restore(void);
+
+    /**
+     * This method stores the network information into non-volatile memory.
+     *
+     * @retval kThreadError_None    Successfully stored the network information.
+     * @retval kThreadError_NoBufs  Insufficient space to store the network information.
+     *
+     */
+    ThreadError Store(void);
+
+    /**
+     * This method stores the MAC and MLE frame counters into non-volatile memory.
+     *
+     * The stored values are reserved KeyManager::kStoreFrameCounterAhead ahead of the current values, so that
+     * Restore() resumes past any frame counter used before a reset.  No frame is secured with a frame counter at or
+     * beyond the stored values until they are stored again.
+     *
+     * @retval kThreadError_None      Successfully stored the frame counters.
+     * @retval kThreadError_NotFound  There is no network information in non-volatile memory.
+     * @retval kThreadError_NoBufs    Insufficient space to store the frame counters.
+     *
+     */
+    ThreadError StoreFrameCounters(void);
+
     /**
      * This method causes the Thread interface to detach from the Thread network.
      *
@@ -413,7 +449,7 @@ public:
      * @returns The Child ID portion of an RLOC16.
      *
      */
-    const uint8_t GetChildId(uint16_t aRloc16) const;
+    const uint16_t GetChildId(uint16_t aRloc16) const;
 
     /**
      * This method returns the Router ID portion of an RLOC16.
@@ -659,6 +695,19 @@ protected:
      */
     ThreadError AppendNetworkData(Message &aMessage, bool aStableOnly);
 
+    /**
+     * This method appends a Network Data Delta TLV to the message.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     * @param[in]  aVersion  The Network Data version held by the receiver.
+     *
+     * @retval kThreadError_None      Successfully appended the Network Data Delta TLV.
+     * @retval kThreadError_Error     The edits from @p aVersion are not retained.
+     * @retval kThreadError_NoBufs    Insufficient buffers available to append the Network Data Delta TLV.
+     *
+     */
+    ThreadError AppendNetworkDataDelta(Message &aMessage, uint8_t aVersion);
+
     /**
      * This method appends a TLV Request TLV to a message.
      *
@@ -804,16 +853,6 @@ protected:
      */
     Mac::ShortAddress GetNextHop(uint16_t aDestination) const;
 
-    /**
-     * This method converts a link margin value to a link quality value.
-     *
-     * @param[in]  aLinkMargin  The Link Margin in dB.
-     *
-     * @returns The link quality value.
-     *
-     */
-    uint8_t LinkMarginToQuality(uint8_t aLinkMargin);
-
     /**
      * This method generates an MLE Data Request message.
      *
@@ -821,6 +860,9 @@ protected:
      * @param[in]  aTlvs         A pointer to requested TLV types.
      * @param[in]  aTlvsLength   The number of TLV types in @p aTlvs.
      *
+     * When @p aTlvs includes the Network Data Delta TLV and full Network Data is stored, the request carries the
+     * current Network Data version so that the neighbor may respond with edits instead of the complete Network Data.
+     *
      * @retval kThreadError_None    Successfully generated an MLE Data Request message.
      * @retval kThreadError_NoBufs  Insufficient buffers to generate the MLE Data Request message.
      *
@@ -833,12 +875,15 @@ protected:
      * @param[in]  aDestination  A reference to the IPv6 address of the destination.
      * @param[in]  aTlvs         A pointer to TLV types that should be included.
      * @param[in]  aTlvsLength   The number of TLV types in @p aTlvs.
+     * @param[in]  aDeltaVersion A pointer to the full Network Data version from the destination's Data Request, or NULL
+     *                           to always include the complete Network Data.  Ignored for multicast destinations.
      *
      * @retval kThreadError_None    Successfully generated an MLE Data Response message.
      * @retval kThreadError_NoBufs  Insufficient buffers to generate the MLE Data Response message.
      *
      */
-    ThreadError SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength);
+    ThreadError SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength,
+                                 const uint8_t *aDeltaVersion);
 
     /**
      * This method generates an MLE Child Update Request message.
@@ -910,6 +955,7 @@ protected:
         kParentIdle,           ///< Not currently searching for a parent.
         kParentSynchronize,    ///< Looking to synchronize with a parent (after reset).
         kParentRequestStart,   ///< Starting to look for a parent.
+        kParentRequestCached,  ///< Asking previous parents to attach to.
         kParentRequestRouter,  ///< Searching for a Router to attach to.
         kParentRequestChild,   ///< Searching for Routers or REEDs to attach to.
         kChildIdRequest,       ///< Sending a Child ID Request message.
@@ -934,17 +980,56 @@ private:
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
-    ThreadError HandleAdvertisement(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleChildIdResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleChildUpdateResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleDataRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleDataResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleParentResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                     uint32_t aKeySequence);
+    ThreadError HandleAdvertisement(const Message &aMessage, const TlvIndex &aTlvs,
+                                    const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleChildIdResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                      const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleChildUpdateResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                          const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleDataRequest(const Message &aMessage, const TlvIndex &aTlvs, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleDataResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                   const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleParentResponse(const Message &aMessage, const TlvIndex &aTlvs,
+                                     const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence);
 
     ThreadError SendParentRequest(void);
+    ThreadError SendParentRequest(const Ip6::Address &aDestination);
     ThreadError SendChildIdRequest(void);
 
+    struct NetworkInfo
+    {
+        uint8_t mDeviceState;
+        uint8_t mDeviceMode;
+        uint16_t mRloc16;
+        uint32_t mKeySequence;
+        uint32_t mMleFrameCounter;
+        uint32_t mMacFrameCounter;
+        Mac::ExtAddress mExtAddress;
+        uint8_t mMlIid[8];
+        uint8_t mMasterKey[KeyManager::kMaxKeyLength];
+        uint8_t mMasterKeyLength;
+        uint8_t mChannel;
+        uint16_t mPanId;
+        uint8_t mExtendedPanId[OT_EXT_PAN_ID_SIZE];
+        char mNetworkName[OT_NETWORK_NAME_SIZE];
+    };
+
+    struct ParentInfo
+    {
+        Mac::ExtAddress mExtAddress;
+    };
+
+    struct ParentCandidate
+    {
+        Mac::ExtAddress mExtAddress;
+        uint32_t mPartitionId;
+        uint16_t mRloc16;
+        uint8_t mLinkMargin;
+    };
+
+    void AddParentCandidate(void);
+    const ParentCandidate *FindParentCandidate(const Mac::ExtAddress &aMacAddr) const;
+
     struct
     {
         uint8_t mChallenge[ChallengeTlv::kMaxSize];
@@ -959,6 +1044,10 @@ private:
     otMleAttachFilter mParentRequestMode;
     uint32_t mParentConnectivity;
 
+    ParentCandidate mParentCandidates[kMaxParentCandidates];
+    uint8_t mNumParentCandidates;
+    bool mTryParentCandidates;
+
     Ip6::UdpSocket mSocket;
     uint32_t mTimeout;
 
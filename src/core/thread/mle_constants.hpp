@@ -45,6 +45,25 @@ namespace Mle {
 enum
 {
     kMaxChildren                = OPENTHREAD_CONFIG_MAX_CHILDREN,
+    kChildHashSize              = OPENTHREAD_CONFIG_CHILD_HASH_SIZE,
+    kMaxPendingChildIdRequests  = OPENTHREAD_CONFIG_MAX_PENDING_CHILD_ID_REQUESTS,
+    kMaxChildPrefixes           = OPENTHREAD_CONFIG_MAX_CHILD_PREFIXES,
+    kChildAddressHashSize       = OPENTHREAD_CONFIG_CHILD_ADDRESS_HASH_SIZE,
+    kMaxParentCandidates        = OPENTHREAD_CONFIG_MAX_PARENT_CANDIDATES,
+};
+
+#if OPENTHREAD_CONFIG_MAX_CHILDREN > 511
+#error "OPENTHREAD_CONFIG_MAX_CHILDREN must not exceed the number of Child IDs (511)"
+#endif
+
+/**
+ * MPL Forwarding Constants
+ *
+ */
+enum
+{
+    kMplRouterDataMessageTimerExpirations = OPENTHREAD_CONFIG_MPL_DATA_MESSAGE_TIMER_EXPIRATIONS,
+    kMplChildDataMessageTimerExpirations  = 0,  ///< End devices do not retransmit MPL Data Messages
 };
 
 /**
@@ -57,11 +76,13 @@ enum
     kUdpPort                    = 19788, ///< MLE UDP Port
     kParentRequestRouterTimeout = 1000,  ///< Router Request timeout
     kParentRequestChildTimeout  = 2000,  ///< End Device Request timeout
+    kParentRequestCachedTimeout = 250,   ///< Unicast Request to previous parents timeout
 };
 
 enum
 {
     kChildIdMask                = 0x1ff,
+    kMaxChildId                 = 511,
     kRouterIdOffset             = 10,
     kRlocPrefixLength           = 14,   ///< Prefix length of RLOC in bytes
 };
@@ -35,9 +35,11 @@
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
+#include <common/settings.hpp>
 #include <mac/mac_frame.hpp>
 #include <net/icmp6.hpp>
 #include <platform/random.h>
+#include <platform/settings.h>
 #include <thread/mle_router.hpp>
 #include <thread/thread_netif.hpp>
 #include <thread/thread_tlvs.hpp>
@@ -58,8 +60,16 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
 {
     mNextChildId = 1;
     mRouterIdSequence = 0;
+    mRouteTlvDirty = true;
     memset(mChildren, 0, sizeof(mChildren));
     memset(mRouters, 0, sizeof(mRouters));
+    memset(mChildPrefixes, 0, sizeof(mChildPrefixes));
+    ClearChildHash();
+
+    for (int i = 0; i < kMaxPendingChildIdRequests; i++)
+    {
+        mPendingChildIdRequests[i].mChildIndex = kMaxChildren;
+    }
 
     mNetworkIdTimeout = kNetworkIdTimeout;
     mRouterUpgradeThreshold = kRouterUpgradeThreadhold;
@@ -133,6 +143,7 @@ int MleRouter::AllocateRouterId(uint8_t aRouterId)
     // bump sequence number
     mRouterIdSequence++;
     mRouterIdSequenceLastUpdated = Timer::GetNow();
+    mRouteTlvDirty = true;
     rval = aRouterId;
 
     otLogInfoMle("add router id %d\n", aRouterId);
@@ -150,6 +161,7 @@ ThreadError MleRouter::ReleaseRouterId(uint8_t aRouterId)
     mRouters[aRouterId].mNextHop = kMaxRouterId;
     mRouterIdSequence++;
     mRouterIdSequenceLastUpdated = Timer::GetNow();
+    mRouteTlvDirty = true;
     mAddressResolver.Remove(aRouterId);
     mNetworkData.RemoveBorderRouter(GetRloc16(aRouterId));
     ResetAdvertiseInterval();
@@ -161,6 +173,13 @@ uint32_t MleRouter::GetLeaderAge(void) const
     return Timer::MsecToSec(Timer::GetNow() - mRouterIdSequenceLastUpdated);
 }
 
+void MleRouter::SetRouterId(uint8_t aRouterId)
+{
+    mRouterId = aRouterId;
+    mPreviousRouterId = mRouterId;
+    mRouteTlvDirty = true;
+}
+
 ThreadError MleRouter::BecomeRouter(void)
 {
     ThreadError error = kThreadError_None;
@@ -177,6 +196,7 @@ ThreadError MleRouter::BecomeRouter(void)
         mRouters[i].mNextHop = kMaxRouterId;
     }
 
+    mRouteTlvDirty = true;
     mSocket.Open(&HandleUdpReceive, this);
     mAdvertiseTimer.Stop();
     mAddressResolver.Clear();
@@ -216,6 +236,7 @@ ThreadError MleRouter::BecomeLeader(void)
         mRouters[i].mNextHop = kMaxRouterId;
     }
 
+    mRouteTlvDirty = true;
     mSocket.Open(&HandleUdpReceive, this);
     mAdvertiseTimer.Stop();
     ResetAdvertiseInterval();
@@ -248,11 +269,15 @@ ThreadError MleRouter::HandleDetachStart(void)
         mRouters[i].mState = Neighbor::kStateInvalid;
     }
 
+    mRouteTlvDirty = true;
+
     for (int i = 0; i < kMaxChildren; i++)
     {
         mChildren[i].mState = Neighbor::kStateInvalid;
     }
 
+    ClearChildHash();
+
     mAdvertiseTimer.Stop();
     mStateUpdateTimer.Stop();
     mNetworkData.Stop();
@@ -309,9 +334,12 @@ ThreadError MleRouter::SetStateRouter(uint16_t aRloc16)
 
     mNetif.SubscribeAllRoutersMulticast();
     mRouters[mRouterId].mNextHop = mRouterId;
+    mRouteTlvDirty = true;
+    Ip6::Ip6::SetMplTimerExpirations(kMplRouterDataMessageTimerExpirations);
     mNetworkData.Stop();
     mStateUpdateTimer.Start(kStateUpdatePeriod);
 
+    Store();
     otLogInfoMle("Mode -> Router\n");
     return kThreadError_None;
 }
@@ -325,12 +353,15 @@ ThreadError MleRouter::SetStateLeader(uint16_t aRloc16)
 
     mNetif.SubscribeAllRoutersMulticast();
     mRouters[mRouterId].mNextHop = mRouterId;
+    mRouteTlvDirty = true;
+    Ip6::Ip6::SetMplTimerExpirations(kMplRouterDataMessageTimerExpirations);
     mRouters[mRouterId].mLastHeard = Timer::GetNow();
 
     mNetworkData.Start();
     mCoapServer.AddResource(mAddressSolicit);
     mCoapServer.AddResource(mAddressRelease);
 
+    Store();
     otLogInfoMle("Mode -> Leader %d\n", mLeaderData.GetPartitionId());
     return kThreadError_None;
 }
@@ -537,7 +568,8 @@ exit:
     return error;
 }
 
-ThreadError MleRouter::HandleLinkRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError MleRouter::HandleLinkRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                         const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     Neighbor *neighbor = NULL;
@@ -559,22 +591,22 @@ ThreadError MleRouter::HandleLinkRequest(const Message &aMessage, const Ip6::Mes
     macAddr.Set(aMessageInfo.GetPeerAddr());
 
     // Challenge
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kChallenge, sizeof(challenge), challenge));
     VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
 
     // Version
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kVersion, sizeof(version), version));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kVersion, sizeof(version), version));
     VerifyOrExit(version.IsValid() && version.GetVersion() == kVersion, error = kThreadError_Parse);
 
     // Leader Data
-    if (Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData) == kThreadError_None)
     {
         VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
         VerifyOrExit(leaderData.GetPartitionId() == mLeaderData.GetPartitionId(), ;);
     }
 
     // Source Address
-    if (Tlv::GetTlv(aMessage, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress) == kThreadError_None)
     {
         VerifyOrExit(sourceAddress.IsValid(), error = kThreadError_Parse);
 
@@ -584,6 +616,7 @@ ThreadError MleRouter::HandleLinkRequest(const Message &aMessage, const Ip6::Mes
         {
             // remove stale neighbors
             neighbor->mState = Neighbor::kStateInvalid;
+            mRouteTlvDirty = true;
             neighbor = NULL;
         }
 
@@ -610,7 +643,7 @@ ThreadError MleRouter::HandleLinkRequest(const Message &aMessage, const Ip6::Mes
     }
 
     // TLV Request
-    if (Tlv::GetTlv(aMessage, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest) == kThreadError_None)
     {
         VerifyOrExit(tlvRequest.IsValid(), error = kThreadError_Parse);
     }
@@ -705,22 +738,22 @@ exit:
     return error;
 }
 
-ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                        uint32_t aKeySequence)
+ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const TlvIndex &aTlvs,
+                                        const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence)
 {
     otLogInfoMle("Received link accept\n");
-    return HandleLinkAccept(aMessage, aMessageInfo, aKeySequence, false);
+    return HandleLinkAccept(aMessage, aTlvs, aMessageInfo, aKeySequence, false);
 }
 
-ThreadError MleRouter::HandleLinkAcceptAndRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                                  uint32_t aKeySequence)
+ThreadError MleRouter::HandleLinkAcceptAndRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                                  const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence)
 {
     otLogInfoMle("Received link accept and request\n");
-    return HandleLinkAccept(aMessage, aMessageInfo, aKeySequence, true);
+    return HandleLinkAccept(aMessage, aTlvs, aMessageInfo, aKeySequence, true);
 }
 
-ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                        uint32_t aKeySequence, bool aRequest)
+ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const TlvIndex &aTlvs,
+                                        const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence, bool aRequest)
 {
     ThreadError error = kThreadError_None;
     Neighbor *neighbor = NULL;
@@ -734,7 +767,8 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     Address16Tlv address16;
     RouteTlv route;
     LeaderDataTlv leaderData;
-    NetworkDataTlv networkData;
+    uint16_t networkDataOffset;
+    uint16_t networkDataLength;
     LinkMarginTlv linkMargin;
     ChallengeTlv challenge;
     TlvRequestTlv tlvRequest;
@@ -742,15 +776,15 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     macAddr.Set(aMessageInfo.GetPeerAddr());
 
     // Version
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kVersion, sizeof(version), version));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kVersion, sizeof(version), version));
     VerifyOrExit(version.IsValid(), error = kThreadError_Parse);
 
     // Response
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kResponse, sizeof(response), response));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kResponse, sizeof(response), response));
     VerifyOrExit(response.IsValid(), error = kThreadError_Parse);
 
     // Source Address
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
     VerifyOrExit(sourceAddress.IsValid(), error = kThreadError_Parse);
 
     // Remove stale neighbors
@@ -758,16 +792,17 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
         neighbor->mValid.mRloc16 != sourceAddress.GetRloc16())
     {
         neighbor->mState = Neighbor::kStateInvalid;
+        mRouteTlvDirty = true;
         neighbor = NULL;
     }
 
     // Link-Layer Frame Counter
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter),
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter),
                                       linkFrameCounter));
     VerifyOrExit(linkFrameCounter.IsValid(), error = kThreadError_Parse);
 
     // MLE Frame Counter
-    if (Tlv::GetTlv(aMessage, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) ==
+    if (Tlv::GetTlv(aTlvs, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) ==
         kThreadError_None)
     {
         VerifyOrExit(mleFrameCounter.IsValid(), error = kThreadError_Parse);
@@ -801,27 +836,28 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
 
     case kDeviceStateDetached:
         // Address16
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kAddress16, sizeof(address16), address16));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kAddress16, sizeof(address16), address16));
         VerifyOrExit(address16.IsValid(), error = kThreadError_Parse);
         VerifyOrExit(GetRloc16() == address16.GetRloc16(), error = kThreadError_Drop);
 
         // Route
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kRoute, sizeof(route), route));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kRoute, sizeof(route), route));
         VerifyOrExit(route.IsValid(), error = kThreadError_Parse);
         SuccessOrExit(error = ProcessRouteTlv(route));
 
         // Leader Data
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
         VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
         mLeaderData.SetPartitionId(leaderData.GetPartitionId());
         mLeaderData.SetWeighting(leaderData.GetWeighting());
         mLeaderData.SetLeaderRouterId(leaderData.GetLeaderRouterId());
 
         // Network Data
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kNetworkData, sizeof(networkData), networkData));
-        mNetworkData.SetNetworkData(leaderData.GetDataVersion(), leaderData.GetStableDataVersion(),
-                                    (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
-                                    networkData.GetNetworkData(), networkData.GetLength());
+        SuccessOrExit(error = Tlv::GetValueOffset(aTlvs, Tlv::kNetworkData, networkDataOffset, networkDataLength));
+        SuccessOrExit(error = mNetworkData.SetNetworkData(leaderData.GetDataVersion(),
+                                                          leaderData.GetStableDataVersion(),
+                                                          (mDeviceMode & ModeTlv::kModeFullNetworkData) == 0,
+                                                          aMessage, networkDataOffset, networkDataLength));
 
         if (mLeaderData.GetLeaderRouterId() == GetRouterId(GetRloc16()))
         {
@@ -836,21 +872,27 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
 
     case kDeviceStateChild:
         mRouters[routerId].mLinkQualityOut = 3;
-        mRouters[routerId].mLinkQualityIn = 3;
+        mRouters[routerId].mLinkInfo.Clear();
+        mRouters[routerId].mLinkInfo.AddLinkMargin(
+            reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo)->mLinkMargin);
+        mRouters[routerId].mLinkQualityIn = mRouters[routerId].mLinkInfo.GetLinkQuality();
         break;
 
     case kDeviceStateRouter:
     case kDeviceStateLeader:
         // Leader Data
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
         VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
         VerifyOrExit(leaderData.GetPartitionId() == mLeaderData.GetPartitionId(), ;);
 
         // Link Margin
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkMargin, sizeof(linkMargin), linkMargin));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLinkMargin, sizeof(linkMargin), linkMargin));
         VerifyOrExit(linkMargin.IsValid(), error = kThreadError_Parse);
         mRouters[routerId].mLinkQualityOut = 3;
-        mRouters[routerId].mLinkQualityIn = 3;
+        mRouters[routerId].mLinkInfo.Clear();
+        mRouters[routerId].mLinkInfo.AddLinkMargin(
+            reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo)->mLinkMargin);
+        mRouters[routerId].mLinkQualityIn = mRouters[routerId].mLinkInfo.GetLinkQuality();
 
         // update routing table
         if (routerId != mRouterId && mRouters[routerId].mNextHop == kMaxRouterId)
@@ -870,6 +912,7 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     neighbor->mLastHeard = Timer::GetNow();
     neighbor->mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
     neighbor->mState = Neighbor::kStateValid;
+    mRouteTlvDirty = true;
     assert(aKeySequence == mKeyManager.GetCurrentKeySequence() ||
            aKeySequence == mKeyManager.GetPreviousKeySequence());
     neighbor->mPreviousKey = aKeySequence == mKeyManager.GetPreviousKeySequence();
@@ -877,11 +920,11 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     if (aRequest)
     {
         // Challenge
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kChallenge, sizeof(challenge), challenge));
         VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
 
         // TLV Request
-        if (Tlv::GetTlv(aMessage, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest) == kThreadError_None)
+        if (Tlv::GetTlv(aTlvs, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest) == kThreadError_None)
         {
             VerifyOrExit(tlvRequest.IsValid(), error = kThreadError_Parse);
         }
@@ -947,13 +990,16 @@ Child *MleRouter::NewChild(void)
 Child *MleRouter::FindChild(const Mac::ExtAddress &aAddress)
 {
     Child *rval = NULL;
+    Child *child;
 
-    for (int i = 0; i < kMaxChildren; i++)
+    for (uint16_t i = mChildHash[HashExtAddress(aAddress)]; i < kMaxChildren; i = child->mHashNext)
     {
-        if (mChildren[i].mState != Neighbor::kStateInvalid &&
-            memcmp(&mChildren[i].mMacAddr, &aAddress, sizeof(mChildren[i].mMacAddr)) == 0)
+        child = &mChildren[i];
+
+        if (child->mState != Neighbor::kStateInvalid &&
+            memcmp(&child->mMacAddr, &aAddress, sizeof(child->mMacAddr)) == 0)
         {
-            ExitNow(rval = &mChildren[i]);
+            ExitNow(rval = child);
         }
     }
 
@@ -961,6 +1007,223 @@ exit:
     return rval;
 }
 
+uint16_t MleRouter::AllocateChildId(const Child &aChild)
+{
+    // Child IDs are congruent to the child table index, so that GetChild() can locate a child by RLOC16 directly.
+    // IDs still rotate through the whole range, as they did before.
+    uint16_t index = GetChildIndex(aChild);
+    uint16_t childId = mNextChildId + (index + kMaxChildren - (mNextChildId - 1) % kMaxChildren) % kMaxChildren;
+
+    if (childId > kMaxChildId)
+    {
+        childId = index + 1;
+    }
+
+    mNextChildId = childId + 1;
+
+    if (mNextChildId > kMaxChildId)
+    {
+        mNextChildId = 1;
+    }
+
+    return childId;
+}
+
+uint8_t MleRouter::HashExtAddress(const Mac::ExtAddress &aMacAddr)
+{
+    uint8_t hash = 0;
+
+    for (size_t i = 0; i < sizeof(aMacAddr.m8); i++)
+    {
+        hash ^= aMacAddr.m8[i];
+    }
+
+    return hash & (kChildHashSize - 1);
+}
+
+void MleRouter::AddChildToHash(Child &aChild)
+{
+    uint8_t bucket = HashExtAddress(aChild.mMacAddr);
+
+    aChild.mHashNext = mChildHash[bucket];
+    mChildHash[bucket] = GetChildIndex(aChild);
+}
+
+void MleRouter::RemoveChildFromHash(Child &aChild)
+{
+    uint16_t index = GetChildIndex(aChild);
+    uint16_t *link = &mChildHash[HashExtAddress(aChild.mMacAddr)];
+
+    while (*link < kMaxChildren)
+    {
+        if (*link == index)
+        {
+            *link = aChild.mHashNext;
+            break;
+        }
+
+        link = &mChildren[*link].mHashNext;
+    }
+}
+
+void MleRouter::ClearChildHash(void)
+{
+    for (int i = 0; i < kChildHashSize; i++)
+    {
+        mChildHash[i] = kMaxChildren;
+    }
+
+    for (int i = 0; i < kChildAddressHashSize; i++)
+    {
+        mChildAddressHash[i] = kMaxChildAddresses;
+    }
+
+    for (int i = 0; i < kMaxChildren; i++)
+    {
+        memset(mChildren[i].mIp6PrefixId, Child::kInvalidPrefixId, sizeof(mChildren[i].mIp6PrefixId));
+    }
+}
+
+ThreadError MleRouter::StoreChild(const Child &aChild)
+{
+    ChildInfo childInfo;
+
+    RemoveStoredChild(aChild.mMacAddr);
+
+    memset(&childInfo, 0, sizeof(childInfo));
+    memcpy(&childInfo.mExtAddress, &aChild.mMacAddr, sizeof(childInfo.mExtAddress));
+    childInfo.mTimeout = aChild.mTimeout;
+    childInfo.mRloc16 = aChild.mValid.mRloc16;
+    childInfo.mMode = aChild.mMode;
+
+    return otPlatSettingsAdd(Settings::kKeyChildInfo, reinterpret_cast<const uint8_t *>(&childInfo),
+                             sizeof(childInfo));
+}
+
+ThreadError MleRouter::RemoveStoredChild(const Mac::ExtAddress &aMacAddr)
+{
+    ThreadError error = kThreadError_NotFound;
+    ChildInfo childInfo;
+    uint16_t length;
+
+    for (int i = 0; ; i++)
+    {
+        length = sizeof(childInfo);
+        SuccessOrExit(otPlatSettingsGet(Settings::kKeyChildInfo, i, reinterpret_cast<uint8_t *>(&childInfo), &length));
+
+        if (length == sizeof(childInfo) && memcmp(&childInfo.mExtAddress, &aMacAddr, sizeof(aMacAddr)) == 0)
+        {
+            ExitNow(error = otPlatSettingsDelete(Settings::kKeyChildInfo, i));
+        }
+    }
+
+exit:
+    return error;
+}
+
+void MleRouter::RestoreChildren(void)
+{
+    ChildInfo childInfo;
+    Child *child;
+    uint16_t length;
+
+    for (int i = 0; ; i++)
+    {
+        length = sizeof(childInfo);
+        SuccessOrExit(otPlatSettingsGet(Settings::kKeyChildInfo, i, reinterpret_cast<uint8_t *>(&childInfo), &length));
+
+        // entries left over from a previous Router ID can never be resumed
+        if (length != sizeof(childInfo) || GetRouterId(childInfo.mRloc16) != mRouterId ||
+            GetChildId(childInfo.mRloc16) == 0)
+        {
+            otPlatSettingsDelete(Settings::kKeyChildInfo, i--);
+            continue;
+        }
+
+        child = &mChildren[(GetChildId(childInfo.mRloc16) - 1) % kMaxChildren];
+
+        if (child->mState != Neighbor::kStateInvalid)
+        {
+            continue;
+        }
+
+        // registered addresses are not stored, the child registers them again when it resynchronizes
+        memset(child, 0, sizeof(*child));
+        memset(child->mIp6PrefixId, Child::kInvalidPrefixId, sizeof(child->mIp6PrefixId));
+        memcpy(&child->mMacAddr, &childInfo.mExtAddress, sizeof(child->mMacAddr));
+        child->mValid.mRloc16 = childInfo.mRloc16;
+        child->mTimeout = childInfo.mTimeout;
+        child->mMode = childInfo.mMode;
+        child->mLastHeard = Timer::GetNow();
+        child->mState = Neighbor::kStateValid;
+        AddChildToHash(*child);
+    }
+
+exit:
+    {}
+}
+
+uint8_t MleRouter::HashChildAddress(uint8_t aPrefixId, const uint8_t *aIid)
+{
+    uint8_t hash = aPrefixId;
+
+    for (int i = 0; i < Ip6::Address::kInterfaceIdentifierSize; i++)
+    {
+        hash ^= aIid[i];
+    }
+
+    return hash & (kChildAddressHashSize - 1);
+}
+
+void MleRouter::AddChildAddressToHash(Child &aChild, uint8_t aIndex)
+{
+    uint8_t bucket = HashChildAddress(aChild.mIp6PrefixId[aIndex], aChild.mIp6Iid[aIndex]);
+
+    aChild.mIp6HashNext[aIndex] = mChildAddressHash[bucket];
+    mChildAddressHash[bucket] = GetChildIndex(aChild) * Child::kMaxIp6AddressPerChild + aIndex;
+}
+
+void MleRouter::RemoveChildAddress(Child &aChild, uint8_t aIndex)
+{
+    uint16_t entry = GetChildIndex(aChild) * Child::kMaxIp6AddressPerChild + aIndex;
+    uint16_t *link;
+
+    // a prefix entry is removed along with the full address entry that follows it
+    VerifyOrExit(aChild.mIp6PrefixId[aIndex] != Child::kInvalidPrefixId &&
+                 aChild.mIp6PrefixId[aIndex] != Child::kPrefixEntryId, ;);
+
+    link = &mChildAddressHash[HashChildAddress(aChild.mIp6PrefixId[aIndex], aChild.mIp6Iid[aIndex])];
+
+    while (*link < kMaxChildAddresses)
+    {
+        if (*link == entry)
+        {
+            *link = aChild.mIp6HashNext[aIndex];
+            break;
+        }
+
+        link = &mChildren[*link / Child::kMaxIp6AddressPerChild].mIp6HashNext[*link % Child::kMaxIp6AddressPerChild];
+    }
+
+    if (aChild.mIp6PrefixId[aIndex] == Child::kFullAddressPrefixId)
+    {
+        aChild.mIp6PrefixId[aIndex - 1] = Child::kInvalidPrefixId;
+    }
+
+    aChild.mIp6PrefixId[aIndex] = Child::kInvalidPrefixId;
+
+exit:
+    {}
+}
+
+void MleRouter::RemoveChildAddresses(Child &aChild)
+{
+    for (uint8_t i = 0; i < Child::kMaxIp6AddressPerChild; i++)
+    {
+        RemoveChildAddress(aChild, i);
+    }
+}
+
 uint8_t MleRouter::LqiToCost(uint8_t aLqi)
 {
     switch (aLqi)
@@ -1020,6 +1283,11 @@ ThreadError MleRouter::ProcessRouteTlv(const RouteTlv &aRoute)
             old = mRouters[i].mAllocated;
             mRouters[i].mAllocated = aRoute.IsRouterIdSet(i);
 
+            if (old != mRouters[i].mAllocated)
+            {
+                mRouteTlvDirty = true;
+            }
+
             if (old && !mRouters[i].mAllocated)
             {
                 mRouters[i].mNextHop = kMaxRouterId;
@@ -1039,7 +1307,8 @@ exit:
     return error;
 }
 
-ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const TlvIndex &aTlvs,
+                                           const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     Mac::ExtAddress macAddr;
@@ -1055,7 +1324,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
     macAddr.Set(aMessageInfo.GetPeerAddr());
 
     // Source Address
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kSourceAddress, sizeof(sourceAddress), sourceAddress));
     VerifyOrExit(sourceAddress.IsValid(), error = kThreadError_Parse);
 
     // Remove stale neighbors
@@ -1063,10 +1332,11 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
         neighbor->mValid.mRloc16 != sourceAddress.GetRloc16())
     {
         neighbor->mState = Neighbor::kStateInvalid;
+        mRouteTlvDirty = true;
     }
 
     // Leader Data
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData));
     VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
     otLogInfoMle("Received advertisement from %04x\n", sourceAddress.GetRloc16());
@@ -1098,7 +1368,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
     VerifyOrExit(GetChildId(sourceAddress.GetRloc16()) == 0, ;);
 
     // Route Data
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kRoute, sizeof(route), route));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kRoute, sizeof(route), route));
     VerifyOrExit(route.IsValid(), error = kThreadError_Parse);
 
     if ((GetDeviceState() == kDeviceStateChild &&
@@ -1159,8 +1429,12 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
         }
 
         router->mLastHeard = Timer::GetNow();
-        router->mLinkQualityIn =
-            LinkMarginToQuality(reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo)->mLinkMargin);
+
+        if (router->mLinkQualityIn != router->mLinkInfo.GetLinkQuality())
+        {
+            router->mLinkQualityIn = router->mLinkInfo.GetLinkQuality();
+            mRouteTlvDirty = true;
+        }
 
         ExitNow();
 
@@ -1186,8 +1460,13 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
         }
 
         router->mLastHeard = Timer::GetNow();
-        router->mLinkQualityIn =
-            LinkMarginToQuality(reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo)->mLinkMargin);
+
+        if (router->mLinkQualityIn != router->mLinkInfo.GetLinkQuality())
+        {
+            router->mLinkQualityIn = router->mLinkInfo.GetLinkQuality();
+            mRouteTlvDirty = true;
+        }
+
         break;
     }
 
@@ -1199,119 +1478,121 @@ exit:
 
 void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 {
+    uint8_t routerIds[kMaxRouterId];
+    uint8_t routeIndexes[kMaxRouterId];
+    uint8_t numRoutes = 0;
+    uint8_t routeCount = 0;
+    uint8_t linkCost;
     uint8_t curCost;
     uint8_t newCost;
-    uint8_t oldNextHop;
     uint8_t cost;
-    uint8_t lqi;
-    bool update;
+    uint8_t oldNextHop;
+    uint8_t oldCost;
+    Router *router;
 
-    // update routes
-    do
+    // map router ids to route data entries, taking the link quality reported for this router first
+    // so that every route below is evaluated against the final cost of the link to aRouterId
+    for (uint8_t i = 0; i < kMaxRouterId; i++)
     {
-        update = false;
-
-        for (int i = 0, routeCount = 0; i < kMaxRouterId; i++)
+        if (!aRoute.IsRouterIdSet(i))
         {
-            if (aRoute.IsRouterIdSet(i) == false)
-            {
-                continue;
-            }
-
-            if (mRouters[i].mAllocated == false)
-            {
-                routeCount++;
-                continue;
-            }
+            continue;
+        }
 
+        if (mRouters[i].mAllocated)
+        {
             if (i == mRouterId)
             {
-                lqi = aRoute.GetLinkQualityIn(routeCount);
-
-                if (mRouters[aRouterId].mLinkQualityOut != lqi)
+                if (mRouters[aRouterId].mLinkQualityOut != aRoute.GetLinkQualityIn(routeCount))
                 {
-                    mRouters[aRouterId].mLinkQualityOut = lqi;
-                    update = true;
+                    mRouters[aRouterId].mLinkQualityOut = aRoute.GetLinkQualityIn(routeCount);
+                    mRouteTlvDirty = true;
                 }
             }
             else
             {
-                oldNextHop = mRouters[i].mNextHop;
+                routerIds[numRoutes] = i;
+                routeIndexes[numRoutes] = routeCount;
+                numRoutes++;
+            }
+        }
 
-                if (i == aRouterId)
-                {
-                    cost = 0;
-                }
-                else
-                {
-                    cost = aRoute.GetRouteCost(routeCount);
+        routeCount++;
+    }
 
-                    if (cost == 0)
-                    {
-                        cost = kMaxRouteCost;
-                    }
-                }
+    linkCost = GetLinkCost(aRouterId);
+
+    // update routes
+    for (uint8_t j = 0; j < numRoutes; j++)
+    {
+        router = &mRouters[routerIds[j]];
+        oldNextHop = router->mNextHop;
+        oldCost = router->mCost;
 
-                if (i != aRouterId && cost == 0 && mRouters[i].mNextHop == aRouterId)
+        if (routerIds[j] == aRouterId)
+        {
+            cost = 0;
+        }
+        else
+        {
+            cost = aRoute.GetRouteCost(routeIndexes[j]);
+
+            if (cost == 0)
+            {
+                cost = kMaxRouteCost;
+            }
+        }
+
+        if (router->mNextHop == kMaxRouterId || router->mNextHop == aRouterId)
+        {
+            // route has no nexthop or nexthop is neighbor
+            newCost = cost + linkCost;
+
+            if (routerIds[j] == aRouterId)
+            {
+                if (router->mNextHop == kMaxRouterId)
                 {
-                    // route nexthop is neighbor, but neighbor no longer has route
                     ResetAdvertiseInterval();
-                    mRouters[i].mNextHop = kMaxRouterId;
-                    mRouters[i].mCost = 0;
-                    mRouters[i].mLastHeard = Timer::GetNow();
                 }
-                else if (mRouters[i].mNextHop == kMaxRouterId || mRouters[i].mNextHop == aRouterId)
-                {
-                    // route has no nexthop or nexthop is neighbor
-                    newCost = cost + GetLinkCost(aRouterId);
-
-                    if (i == aRouterId)
-                    {
-                        if (mRouters[i].mNextHop == kMaxRouterId)
-                        {
-                            ResetAdvertiseInterval();
-                        }
-
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = 0;
-                    }
-                    else if (newCost <= kMaxRouteCost)
-                    {
-                        if (mRouters[i].mNextHop == kMaxRouterId)
-                        {
-                            ResetAdvertiseInterval();
-                        }
-
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = cost;
-                    }
-                    else if (mRouters[i].mNextHop != kMaxRouterId)
-                    {
-                        ResetAdvertiseInterval();
-                        mRouters[i].mNextHop = kMaxRouterId;
-                        mRouters[i].mCost = 0;
-                        mRouters[i].mLastHeard = Timer::GetNow();
-                    }
-                }
-                else
+
+                router->mNextHop = aRouterId;
+                router->mCost = 0;
+            }
+            else if (newCost <= kMaxRouteCost)
+            {
+                if (router->mNextHop == kMaxRouterId)
                 {
-                    curCost = mRouters[i].mCost + GetLinkCost(mRouters[i].mNextHop);
-                    newCost = cost + GetLinkCost(aRouterId);
-
-                    if (newCost < curCost || (newCost == curCost && i == aRouterId))
-                    {
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = cost;
-                    }
+                    ResetAdvertiseInterval();
                 }
 
-                update |= mRouters[i].mNextHop != oldNextHop;
+                router->mNextHop = aRouterId;
+                router->mCost = cost;
             }
+            else if (router->mNextHop != kMaxRouterId)
+            {
+                ResetAdvertiseInterval();
+                router->mNextHop = kMaxRouterId;
+                router->mCost = 0;
+                router->mLastHeard = Timer::GetNow();
+            }
+        }
+        else
+        {
+            curCost = router->mCost + GetLinkCost(router->mNextHop);
+            newCost = cost + linkCost;
+
+            if (newCost < curCost || (newCost == curCost && routerIds[j] == aRouterId))
+            {
+                router->mNextHop = aRouterId;
+                router->mCost = cost;
+            }
+        }
 
-            routeCount++;
+        if (router->mNextHop != oldNextHop || router->mCost != oldCost)
+        {
+            mRouteTlvDirty = true;
         }
     }
-    while (update);
 
 #if 1
 
@@ -1329,7 +1610,8 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 #endif
 }
 
-ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                           const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     Mac::ExtAddress macAddr;
@@ -1357,11 +1639,11 @@ ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::M
     macAddr.Set(aMessageInfo.GetPeerAddr());
 
     // Version
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kVersion, sizeof(version), version));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kVersion, sizeof(version), version));
     VerifyOrExit(version.IsValid() && version.GetVersion() == kVersion, error = kThreadError_Parse);
 
     // Scan Mask
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kScanMask, sizeof(scanMask), scanMask));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kScanMask, sizeof(scanMask), scanMask));
     VerifyOrExit(scanMask.IsValid(), error = kThreadError_Parse);
 
     switch (GetDeviceState())
@@ -1381,14 +1663,24 @@ ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::M
     }
 
     VerifyOrExit((child = FindChild(macAddr)) != NULL || (child = NewChild()) != NULL, ;);
+
+    if (child->mState == Neighbor::kStateValid)
+    {
+        RemoveStoredChild(child->mMacAddr);
+    }
+
+    RemoveChildFromHash(*child);
+    RemoveChildAddresses(*child);
     memset(child, 0, sizeof(*child));
+    memset(child->mIp6PrefixId, Child::kInvalidPrefixId, sizeof(child->mIp6PrefixId));
 
     // Challenge
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kChallenge, sizeof(challenge), challenge));
     VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
 
     // MAC Address
     memcpy(&child->mMacAddr, &macAddr, sizeof(child->mMacAddr));
+    AddChildToHash(*child);
 
     child->mState = Neighbor::kStateParentRequest;
     child->mDataRequest = false;
@@ -1454,6 +1746,8 @@ void MleRouter::HandleStateUpdateTimer(void)
 
         if ((Timer::GetNow() - mChildren[i].mLastHeard) >= Timer::SecToMsec(mChildren[i].mTimeout))
         {
+            RemoveStoredChild(mChildren[i].mMacAddr);
+            RemoveChildAddresses(mChildren[i]);
             mChildren[i].mState = Neighbor::kStateInvalid;
         }
     }
@@ -1470,6 +1764,7 @@ void MleRouter::HandleStateUpdateTimer(void)
                 mRouters[i].mLinkQualityIn = 0;
                 mRouters[i].mLinkQualityOut = 0;
                 mRouters[i].mLastHeard = Timer::GetNow();
+                mRouteTlvDirty = true;
             }
         }
 
@@ -1545,34 +1840,161 @@ ThreadError MleRouter::UpdateChildAddresses(const AddressRegistrationTlv &aTlv,
 {
     const AddressRegistrationEntry *entry;
     Lowpan::Context context;
+    Ip6::Address address;
+    uint8_t prefixId;
+    uint8_t count = 0;
 
-    memset(aChild.mIp6Address, 0, sizeof(aChild.mIp6Address));
+    RemoveChildAddresses(aChild);
 
-    for (size_t count = 0; count < sizeof(aChild.mIp6Address) / sizeof(aChild.mIp6Address[0]); count++)
+    for (uint8_t i = 0; count < Child::kMaxIp6AddressPerChild && (entry = aTlv.GetAddressEntry(i)) != NULL; i++)
     {
-        if ((entry = aTlv.GetAddressEntry(count)) == NULL)
+        if (entry->IsCompressed())
+        {
+            if (mNetworkData.GetContext(entry->GetContextId(), context) != kThreadError_None)
+            {
+                continue;
+            }
+
+            memset(&address, 0, sizeof(address));
+            memcpy(&address, context.mPrefix, BitVectorBytes(context.mPrefixLength));
+            address.SetIid(entry->GetIid());
+        }
+        else
+        {
+            memcpy(&address, entry->GetIp6Address(), sizeof(address));
+        }
+
+        if ((prefixId = AllocateChildPrefixId(address)) == Child::kInvalidPrefixId)
+        {
+            // the prefix table is full, store the full address in two entries
+            if (count + 2 > Child::kMaxIp6AddressPerChild)
+            {
+                continue;
+            }
+
+            memcpy(aChild.mIp6Iid[count], address.m8, sizeof(aChild.mIp6Iid[count]));
+            aChild.mIp6PrefixId[count++] = Child::kPrefixEntryId;
+            prefixId = Child::kFullAddressPrefixId;
+        }
+
+        memcpy(aChild.mIp6Iid[count], address.GetIid(), sizeof(aChild.mIp6Iid[count]));
+        aChild.mIp6PrefixId[count] = prefixId;
+        AddChildAddressToHash(aChild, count++);
+    }
+
+    return kThreadError_None;
+}
+
+uint8_t MleRouter::GetChildPrefixId(const Ip6::Address &aAddress)
+{
+    uint8_t rval = Child::kInvalidPrefixId;
+
+    for (uint8_t i = 0; i < kMaxChildPrefixes; i++)
+    {
+        if (mChildPrefixes[i].mAllocated &&
+            memcmp(mChildPrefixes[i].mPrefix, aAddress.m8, sizeof(mChildPrefixes[i].mPrefix)) == 0)
+        {
+            ExitNow(rval = i);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+uint8_t MleRouter::AllocateChildPrefixId(const Ip6::Address &aAddress)
+{
+    uint8_t rval;
+    bool referenced[kMaxChildPrefixes];
+    uint8_t i;
+
+    VerifyOrExit((rval = GetChildPrefixId(aAddress)) == Child::kInvalidPrefixId, ;);
+
+    for (i = 0; i < kMaxChildPrefixes; i++)
+    {
+        if (!mChildPrefixes[i].mAllocated)
         {
             break;
         }
+    }
 
-        if (entry->IsCompressed())
+    if (i == kMaxChildPrefixes)
+    {
+        // reclaim a prefix that is no longer used by any child
+        memset(referenced, 0, sizeof(referenced));
+
+        for (int j = 0; j < kMaxChildren; j++)
         {
-            // xxx check if context id exists
-            mNetworkData.GetContext(entry->GetContextId(), context);
-            memcpy(&aChild.mIp6Address[count], context.mPrefix, BitVectorBytes(context.mPrefixLength));
-            aChild.mIp6Address[count].SetIid(entry->GetIid());
+            for (int k = 0; k < Child::kMaxIp6AddressPerChild; k++)
+            {
+                if (mChildren[j].mState != Neighbor::kStateInvalid &&
+                    mChildren[j].mIp6PrefixId[k] < kMaxChildPrefixes)
+                {
+                    referenced[mChildren[j].mIp6PrefixId[k]] = true;
+                }
+            }
         }
-        else
+
+        for (i = 0; i < kMaxChildPrefixes; i++)
         {
-            memcpy(&aChild.mIp6Address[count], entry->GetIp6Address(), sizeof(aChild.mIp6Address[count]));
+            if (!referenced[i])
+            {
+                break;
+            }
         }
+
+        VerifyOrExit(i < kMaxChildPrefixes, ;);
     }
 
-    return kThreadError_None;
+    memcpy(mChildPrefixes[i].mPrefix, aAddress.m8, sizeof(mChildPrefixes[i].mPrefix));
+    mChildPrefixes[i].mAllocated = true;
+    rval = i;
+
+exit:
+    return rval;
 }
 
-ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                            uint32_t aKeySequence)
+ThreadError MleRouter::SavePendingChildIdRequest(const Child &aChild, const TlvRequestTlv &aTlvRequest)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t childIndex = GetChildIndex(aChild);
+    PendingChildIdRequest *pending = NULL;
+    uint8_t length;
+
+    for (int i = 0; i < kMaxPendingChildIdRequests; i++)
+    {
+        PendingChildIdRequest &entry = mPendingChildIdRequests[i];
+
+        if (entry.mChildIndex == childIndex)
+        {
+            pending = &entry;
+            break;
+        }
+
+        // an entry is released once its child leaves the Child ID Request state
+        if (pending == NULL &&
+            (entry.mChildIndex >= kMaxChildren ||
+             mChildren[entry.mChildIndex].mState != Neighbor::kStateChildIdRequest))
+        {
+            pending = &entry;
+        }
+    }
+
+    VerifyOrExit(pending != NULL, error = kThreadError_NoBufs);
+
+    length = aTlvRequest.GetLength() < sizeof(pending->mRequestTlvs) ?
+             aTlvRequest.GetLength() : sizeof(pending->mRequestTlvs);
+
+    pending->mChildIndex = childIndex;
+    memcpy(pending->mRequestTlvs, aTlvRequest.GetTlvs(), length);
+    memset(pending->mRequestTlvs + length, Tlv::kInvalid, sizeof(pending->mRequestTlvs) - length);
+
+exit:
+    return error;
+}
+
+ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                            const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence)
 {
     ThreadError error = kThreadError_None;
     Mac::ExtAddress macAddr;
@@ -1593,17 +2015,17 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
     VerifyOrExit((child = FindChild(macAddr)) != NULL, ;);
 
     // Response
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kResponse, sizeof(response), response));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kResponse, sizeof(response), response));
     VerifyOrExit(response.IsValid() &&
                  memcmp(response.GetResponse(), child->mPending.mChallenge, sizeof(child->mPending.mChallenge)) == 0, ;);
 
     // Link-Layer Frame Counter
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter),
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter),
                                       linkFrameCounter));
     VerifyOrExit(linkFrameCounter.IsValid(), error = kThreadError_Parse);
 
     // MLE Frame Counter
-    if (Tlv::GetTlv(aMessage, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) ==
+    if (Tlv::GetTlv(aTlvs, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) ==
         kThreadError_None)
     {
         VerifyOrExit(mleFrameCounter.IsValid(), error = kThreadError_Parse);
@@ -1614,11 +2036,11 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
     }
 
     // Mode
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kMode, sizeof(mode), mode));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kMode, sizeof(mode), mode));
     VerifyOrExit(mode.IsValid(), error = kThreadError_Parse);
 
     // Timeout
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kTimeout, sizeof(timeout), timeout));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kTimeout, sizeof(timeout), timeout));
     VerifyOrExit(timeout.IsValid(), error = kThreadError_Parse);
 
     // Ip6 Address
@@ -1626,14 +2048,20 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
 
     if ((mode.GetMode() & ModeTlv::kModeFFD) == 0)
     {
-        SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kAddressRegistration, sizeof(address), address));
+        SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kAddressRegistration, sizeof(address), address));
         VerifyOrExit(address.IsValid(), error = kThreadError_Parse);
     }
 
     // TLV Request
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest));
     VerifyOrExit(tlvRequest.IsValid(), error = kThreadError_Parse);
 
+    if (GetDeviceState() == kDeviceStateChild)
+    {
+        // answered once the upgrade to router completes
+        SuccessOrExit(error = SavePendingChildIdRequest(*child, tlvRequest));
+    }
+
     // Remove from router table
     for (int i = 0; i < kMaxRouterId; i++)
     {
@@ -1641,6 +2069,7 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
             memcmp(&mRouters[i].mMacAddr, &macAddr, sizeof(mRouters[i].mMacAddr)) == 0)
         {
             mRouters[i].mState = Neighbor::kStateInvalid;
+            mRouteTlvDirty = true;
             break;
         }
     }
@@ -1667,16 +2096,6 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
            aKeySequence == mKeyManager.GetPreviousKeySequence());
     child->mPreviousKey = aKeySequence == mKeyManager.GetPreviousKeySequence();
 
-    for (uint8_t i = 0; i < tlvRequest.GetLength(); i++)
-    {
-        child->mRequestTlvs[i] = tlvRequest.GetTlvs()[i];
-    }
-
-    for (uint8_t i = tlvRequest.GetLength(); i < sizeof(child->mRequestTlvs); i++)
-    {
-        child->mRequestTlvs[i] = Tlv::kInvalid;
-    }
-
     switch (GetDeviceState())
     {
     case kDeviceStateDisabled:
@@ -1690,7 +2109,7 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
 
     case kDeviceStateRouter:
     case kDeviceStateLeader:
-        SuccessOrExit(error = SendChildIdResponse(child));
+        SuccessOrExit(error = SendChildIdResponse(child, tlvRequest.GetTlvs(), tlvRequest.GetLength()));
         break;
     }
 
@@ -1698,7 +2117,8 @@ exit:
     return error;
 }
 
-ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                                const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
     Mac::ExtAddress macAddr;
@@ -1729,20 +2149,20 @@ ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const I
     tlvs[tlvslength++] = Tlv::kLeaderData;
 
     // Mode
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kMode, sizeof(mode), mode));
+    SuccessOrExit(error = Tlv::GetTlv(aTlvs, Tlv::kMode, sizeof(mode), mode));
     VerifyOrExit(mode.IsValid(), error = kThreadError_Parse);
     child->mMode = mode.GetMode();
     tlvs[tlvslength++] = Tlv::kMode;
 
     // Challenge
-    if (Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kChallenge, sizeof(challenge), challenge) == kThreadError_None)
     {
         VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
         tlvs[tlvslength++] = Tlv::kResponse;
     }
 
     // Ip6 Address TLV
-    if (Tlv::GetTlv(aMessage, Tlv::kAddressRegistration, sizeof(address), address) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kAddressRegistration, sizeof(address), address) == kThreadError_None)
     {
         VerifyOrExit(address.IsValid(), error = kThreadError_Parse);
         UpdateChildAddresses(address, *child);
@@ -1750,7 +2170,7 @@ ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const I
     }
 
     // Leader Data
-    if (Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kLeaderData, sizeof(leaderData), leaderData) == kThreadError_None)
     {
         VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
@@ -1765,7 +2185,7 @@ ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const I
     }
 
     // Timeout
-    if (Tlv::GetTlv(aMessage, Tlv::kTimeout, sizeof(timeout), timeout) == kThreadError_None)
+    if (Tlv::GetTlv(aTlvs, Tlv::kTimeout, sizeof(timeout), timeout) == kThreadError_None)
     {
         VerifyOrExit(timeout.IsValid(), error = kThreadError_Parse);
         child->mTimeout = timeout.GetTimeout();
@@ -1791,13 +2211,13 @@ ThreadError MleRouter::HandleNetworkDataUpdateRouter(void)
     destination.m16[0] = HostSwap16(0xff02);
     destination.m16[7] = HostSwap16(0x0001);
 
-    SendDataResponse(destination, tlvs, sizeof(tlvs));
+    SendDataResponse(destination, tlvs, sizeof(tlvs), NULL);
 
 exit:
     return kThreadError_None;
 }
 
-ThreadError MleRouter::SendChildIdResponse(Child *aChild)
+ThreadError MleRouter::SendChildIdResponse(Child *aChild, const uint8_t *aRequestTlvs, uint8_t aRequestTlvsLength)
 {
     ThreadError error = kThreadError_None;
     Ip6::Address destination;
@@ -1808,20 +2228,13 @@ ThreadError MleRouter::SendChildIdResponse(Child *aChild)
     SuccessOrExit(error = AppendSourceAddress(*message));
     SuccessOrExit(error = AppendLeaderData(*message));
 
-    aChild->mValid.mRloc16 = mMac.GetShortAddress() | mNextChildId;
-
-    mNextChildId++;
-
-    if (mNextChildId >= 512)
-    {
-        mNextChildId = 1;
-    }
+    aChild->mValid.mRloc16 = mMac.GetShortAddress() | AllocateChildId(*aChild);
 
     SuccessOrExit(error = AppendAddress16(*message, aChild->mValid.mRloc16));
 
-    for (uint8_t i = 0; i < sizeof(aChild->mRequestTlvs); i++)
+    for (uint8_t i = 0; i < aRequestTlvsLength; i++)
     {
-        switch (aChild->mRequestTlvs[i])
+        switch (aRequestTlvs[i])
         {
         case Tlv::kNetworkData:
             SuccessOrExit(error = AppendNetworkData(*message, (aChild->mMode & ModeTlv::kModeFullNetworkData) == 0));
@@ -1839,6 +2252,7 @@ ThreadError MleRouter::SendChildIdResponse(Child *aChild)
     }
 
     aChild->mState = Neighbor::kStateValid;
+    StoreChild(*aChild);
 
     memset(&destination, 0, sizeof(destination));
     destination.m16[0] = HostSwap16(0xfe80);
@@ -1917,29 +2331,28 @@ exit:
 
 Child *MleRouter::GetChild(uint16_t aAddress)
 {
-    for (int i = 0; i < kMaxChildren; i++)
-    {
-        if (mChildren[i].mState == Neighbor::kStateValid && mChildren[i].mValid.mRloc16 == aAddress)
-        {
-            return &mChildren[i];
-        }
-    }
+    Child *rval = NULL;
+    uint16_t childId = GetChildId(aAddress);
 
-    return NULL;
+    VerifyOrExit(childId != 0, ;);
+
+    rval = &mChildren[(childId - 1) % kMaxChildren];
+    VerifyOrExit(rval->mState == Neighbor::kStateValid && rval->mValid.mRloc16 == aAddress, rval = NULL);
+
+exit:
+    return rval;
 }
 
 Child *MleRouter::GetChild(const Mac::ExtAddress &aAddress)
 {
-    for (int i = 0; i < kMaxChildren; i++)
+    Child *rval = FindChild(aAddress);
+
+    if (rval != NULL && rval->mState != Neighbor::kStateValid)
     {
-        if (mChildren[i].mState == Neighbor::kStateValid &&
-            memcmp(&mChildren[i].mMacAddr, &aAddress, sizeof(mChildren[i].mMacAddr)) == 0)
-        {
-            return &mChildren[i];
-        }
+        rval = NULL;
     }
 
-    return NULL;
+    return rval;
 }
 
 Child *MleRouter::GetChild(const Mac::Address &aAddress)
@@ -1956,12 +2369,70 @@ Child *MleRouter::GetChild(const Mac::Address &aAddress)
     return NULL;
 }
 
-int MleRouter::GetChildIndex(const Child &child)
+Child *MleRouter::GetChild(const Ip6::Address &aAddress)
+{
+    return FindChildAddress(aAddress, false);
+}
+
+Child *MleRouter::GetMtdChild(const Ip6::Address &aAddress)
+{
+    return FindChildAddress(aAddress, true);
+}
+
+Child *MleRouter::FindChildAddress(const Ip6::Address &aAddress, bool aMtdOnly)
 {
-    return &child - mChildren;
+    Child *rval = NULL;
+    uint8_t prefixId = GetChildPrefixId(aAddress);
+
+    if (prefixId != Child::kInvalidPrefixId)
+    {
+        rval = FindChildAddress(prefixId, aAddress, aMtdOnly);
+    }
+
+    // registered while the prefix table was full
+    if (rval == NULL)
+    {
+        rval = FindChildAddress(Child::kFullAddressPrefixId, aAddress, aMtdOnly);
+    }
+
+    return rval;
 }
 
-Child *MleRouter::GetChildren(uint8_t *numChildren)
+Child *MleRouter::FindChildAddress(uint8_t aPrefixId, const Ip6::Address &aAddress, bool aMtdOnly)
+{
+    Child *rval = NULL;
+    Child *child;
+    uint8_t index;
+
+    for (uint16_t entry = mChildAddressHash[HashChildAddress(aPrefixId, aAddress.GetIid())];
+         entry < kMaxChildAddresses;
+         entry = child->mIp6HashNext[index])
+    {
+        child = &mChildren[entry / Child::kMaxIp6AddressPerChild];
+        index = entry % Child::kMaxIp6AddressPerChild;
+
+        if (child->mState != Neighbor::kStateValid || child->mIp6PrefixId[index] != aPrefixId ||
+            (aMtdOnly && (child->mMode & ModeTlv::kModeFFD) != 0))
+        {
+            continue;
+        }
+
+        if (child->MatchesIp6Address(index, aPrefixId, aAddress))
+        {
+            ExitNow(rval = child);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+uint16_t MleRouter::GetChildIndex(const Child &child)
+{
+    return static_cast<uint16_t>(&child - mChildren);
+}
+
+Child *MleRouter::GetChildren(uint16_t *numChildren)
 {
     if (numChildren != NULL)
     {
@@ -1985,12 +2456,9 @@ Neighbor *MleRouter::GetNeighbor(uint16_t aAddress)
         ExitNow();
     }
 
-    for (int i = 0; i < kMaxChildren; i++)
+    if ((rval = GetChild(aAddress)) != NULL)
     {
-        if (mChildren[i].mState == Neighbor::kStateValid && mChildren[i].mValid.mRloc16 == aAddress)
-        {
-            ExitNow(rval = &mChildren[i]);
-        }
+        ExitNow();
     }
 
     for (int i = 0; i < kMaxRouterId; i++)
@@ -2014,13 +2482,9 @@ Neighbor *MleRouter::GetNeighbor(const Mac::ExtAddress &aAddress)
         ExitNow();
     }
 
-    for (int i = 0; i < kMaxChildren; i++)
+    if ((rval = GetChild(aAddress)) != NULL)
     {
-        if (mChildren[i].mState == Neighbor::kStateValid &&
-            memcmp(&mChildren[i].mMacAddr, &aAddress, sizeof(mChildren[i].mMacAddr)) == 0)
-        {
-            ExitNow(rval = &mChildren[i]);
-        }
+        ExitNow();
     }
 
     for (int i = 0; i < kMaxRouterId; i++)
@@ -2061,7 +2525,6 @@ Neighbor *MleRouter::GetNeighbor(const Ip6::Address &aAddress)
 {
     Mac::Address macaddr;
     Lowpan::Context context;
-    Child *child;
     Router *router;
     Neighbor *rval = NULL;
 
@@ -2088,31 +2551,18 @@ Neighbor *MleRouter::GetNeighbor(const Ip6::Address &aAddress)
         context.mContextId = 0xff;
     }
 
-    for (int i = 0; i < kMaxChildren; i++)
+    if (context.mContextId == 0 &&
+        aAddress.m16[4] == HostSwap16(0x0000) &&
+        aAddress.m16[5] == HostSwap16(0x00ff) &&
+        aAddress.m16[6] == HostSwap16(0xfe00) &&
+        (rval = GetChild(HostSwap16(aAddress.m16[7]))) != NULL)
     {
-        child = &mChildren[i];
-
-        if (child->mState != Neighbor::kStateValid)
-        {
-            continue;
-        }
-
-        if (context.mContextId == 0 &&
-            aAddress.m16[4] == HostSwap16(0x0000) &&
-            aAddress.m16[5] == HostSwap16(0x00ff) &&
-            aAddress.m16[6] == HostSwap16(0xfe00) &&
-            aAddress.m16[7] == HostSwap16(child->mValid.mRloc16))
-        {
-            ExitNow(rval = child);
-        }
+        ExitNow();
+    }
 
-        for (int j = 0; j < Child::kMaxIp6AddressPerChild; j++)
-        {
-            if (memcmp(&child->mIp6Address[j], aAddress.m8, sizeof(child->mIp6Address[j])) == 0)
-            {
-                ExitNow(rval = child);
-            }
-        }
+    if ((rval = GetChild(aAddress)) != NULL)
+    {
+        ExitNow();
     }
 
     VerifyOrExit(context.mContextId == 0, rval = NULL);
@@ -2201,14 +2651,14 @@ void MleRouter::HandleMacDataRequest(const Child &aChild)
     {
         if (aChild.mNetworkDataVersion != mNetworkData.GetVersion())
         {
-            SendDataResponse(destination, tlvs, sizeof(tlvs));
+            SendDataResponse(destination, tlvs, sizeof(tlvs), NULL);
         }
     }
     else
     {
         if (aChild.mNetworkDataVersion != mNetworkData.GetStableVersion())
         {
-            SendDataResponse(destination, tlvs, sizeof(tlvs));
+            SendDataResponse(destination, tlvs, sizeof(tlvs), NULL);
         }
     }
 
@@ -2384,6 +2834,7 @@ void MleRouter::HandleAddressSolicitResponse(Message &aMessage)
     ThreadRloc16Tlv rlocTlv;
     ThreadRouterMaskTlv routerMaskTlv;
     bool old;
+    TlvIndex tlvs;
 
     SuccessOrExit(header.FromMessage(aMessage));
     VerifyOrExit(header.GetType() == Coap::Header::kTypeAcknowledgment &&
@@ -2395,13 +2846,15 @@ void MleRouter::HandleAddressSolicitResponse(Message &aMessage)
 
     otLogInfoMle("Received address reply\n");
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kStatus, sizeof(statusTlv), statusTlv));
+    tlvs.Init(aMessage);
+
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kStatus, sizeof(statusTlv), statusTlv));
     VerifyOrExit(statusTlv.IsValid() && statusTlv.GetStatus() == statusTlv.kSuccess, ;);
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv));
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv));
     VerifyOrExit(rlocTlv.IsValid(), ;);
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kRouterMask, sizeof(routerMaskTlv), routerMaskTlv));
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kRouterMask, sizeof(routerMaskTlv), routerMaskTlv));
     VerifyOrExit(routerMaskTlv.IsValid(), ;);
 
     // assign short address
@@ -2413,6 +2866,7 @@ void MleRouter::HandleAddressSolicitResponse(Message &aMessage)
     // copy router id information
     mRouterIdSequence = routerMaskTlv.GetIdSequence();
     mRouterIdSequenceLastUpdated = Timer::GetNow();
+    mRouteTlvDirty = true;
 
     for (int i = 0; i < kMaxRouterId; i++)
     {
@@ -2430,12 +2884,17 @@ void MleRouter::HandleAddressSolicitResponse(Message &aMessage)
     ResetAdvertiseInterval();
 
     // send child id responses
-    for (int i = 0; i < kMaxChildren; i++)
+    for (int i = 0; i < kMaxPendingChildIdRequests; i++)
     {
-        if (mChildren[i].mState == Neighbor::kStateChildIdRequest)
+        PendingChildIdRequest &pending = mPendingChildIdRequests[i];
+
+        if (pending.mChildIndex < kMaxChildren &&
+            mChildren[pending.mChildIndex].mState == Neighbor::kStateChildIdRequest)
         {
-            SendChildIdResponse(&mChildren[i]);
+            SendChildIdResponse(&mChildren[pending.mChildIndex], pending.mRequestTlvs, sizeof(pending.mRequestTlvs));
         }
+
+        pending.mChildIndex = kMaxChildren;
     }
 
 exit:
@@ -2455,13 +2914,16 @@ void MleRouter::HandleAddressSolicit(Coap::Header &aHeader, Message &aMessage, c
     ThreadExtMacAddressTlv macAddr64Tlv;
     ThreadRloc16Tlv rlocTlv;
     int routerId;
+    TlvIndex tlvs;
 
     VerifyOrExit(aHeader.GetType() == Coap::Header::kTypeConfirmable &&
                  aHeader.GetCode() == Coap::Header::kCodePost, ;);
 
     otLogInfoMle("Received address solicit\n");
 
-    SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kExtMacAddress, sizeof(macAddr64Tlv), macAddr64Tlv));
+    tlvs.Init(aMessage);
+
+    SuccessOrExit(error = ThreadTlv::GetTlv(tlvs, ThreadTlv::kExtMacAddress, sizeof(macAddr64Tlv), macAddr64Tlv));
     VerifyOrExit(macAddr64Tlv.IsValid(), error = kThreadError_Parse);
 
     routerId = -1;
@@ -2477,7 +2939,7 @@ void MleRouter::HandleAddressSolicit(Coap::Header &aHeader, Message &aMessage, c
         }
     }
 
-    if (ThreadTlv::GetTlv(aMessage, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv) == kThreadError_None)
+    if (ThreadTlv::GetTlv(tlvs, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv) == kThreadError_None)
     {
         // specific Router ID requested
         VerifyOrExit(rlocTlv.IsValid(), error = kThreadError_Parse);
@@ -2604,16 +3066,19 @@ void MleRouter::HandleAddressRelease(Coap::Header &aHeader, Message &aMessage,
     ThreadExtMacAddressTlv macAddr64Tlv;
     uint8_t routerId;
     Router *router;
+    TlvIndex tlvs;
 
     VerifyOrExit(aHeader.GetType() == Coap::Header::kTypeConfirmable &&
                  aHeader.GetCode() == Coap::Header::kCodePost, ;);
 
     otLogInfoMle("Received address release\n");
 
-    SuccessOrExit(ThreadTlv::GetTlv(aMessage, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv));
+    tlvs.Init(aMessage);
+
+    SuccessOrExit(ThreadTlv::GetTlv(tlvs, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv));
     VerifyOrExit(rlocTlv.IsValid(), ;);
 
-    SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kExtMacAddress, sizeof(macAddr64Tlv), macAddr64Tlv));
+    SuccessOrExit(error = ThreadTlv::GetTlv(tlvs, ThreadTlv::kExtMacAddress, sizeof(macAddr64Tlv), macAddr64Tlv));
     VerifyOrExit(macAddr64Tlv.IsValid(), error = kThreadError_Parse);
 
     routerId = GetRouterId(rlocTlv.GetRloc16());
@@ -2659,20 +3124,26 @@ ThreadError MleRouter::AppendConnectivity(Message &aMessage)
 {
     ThreadError error;
     ConnectivityTlv tlv;
+    uint16_t numChildren;
     uint8_t cost;
     uint8_t lqi;
 
     tlv.Init();
-    tlv.SetMaxChildCount(kMaxChildren);
+    tlv.SetMaxChildCount(kMaxChildren < 0xff ? kMaxChildren : 0xff);
 
     // compute number of children
-    tlv.SetChildCount(0);
+    numChildren = 0;
 
     for (int i = 0; i < kMaxChildren; i++)
     {
-        tlv.SetChildCount(tlv.GetChildCount() + mChildren[i].mState == Neighbor::kStateValid);
+        if (mChildren[i].mState == Neighbor::kStateValid)
+        {
+            numChildren++;
+        }
     }
 
+    tlv.SetChildCount(numChildren < 0xff ? static_cast<uint8_t>(numChildren) : 0xff);
+
     // compute leader cost and link qualities
     tlv.SetLinkQuality1(0);
     tlv.SetLinkQuality2(0);
@@ -2760,25 +3231,45 @@ ThreadError MleRouter::AppendChildAddresses(Message &aMessage, Child &aChild)
     Tlv tlv;
     AddressRegistrationEntry entry;
     Lowpan::Context context;
+    Ip6::Address address;
+    uint8_t prefixId;
     uint8_t length = 0;
-    uint8_t startOffset = aMessage.GetLength();
+    uint16_t startOffset = aMessage.GetLength();
 
     tlv.SetType(Tlv::kAddressRegistration);
     SuccessOrExit(error = aMessage.Append(&tlv, sizeof(tlv)));
 
-    for (size_t i = 0; i < sizeof(aChild.mIp6Address) / sizeof(aChild.mIp6Address[0]); i++)
+    for (uint8_t i = 0; i < Child::kMaxIp6AddressPerChild; i++)
     {
-        if (mNetworkData.GetContext(aChild.mIp6Address[i], context) == kThreadError_None)
+        prefixId = aChild.mIp6PrefixId[i];
+
+        if (prefixId == Child::kInvalidPrefixId || prefixId == Child::kPrefixEntryId)
+        {
+            continue;
+        }
+
+        if (prefixId == Child::kFullAddressPrefixId)
+        {
+            memcpy(&address, aChild.mIp6Iid[i - 1], sizeof(aChild.mIp6Iid[i - 1]));
+        }
+        else
+        {
+            memcpy(&address, mChildPrefixes[prefixId].mPrefix, sizeof(mChildPrefixes[prefixId].mPrefix));
+        }
+
+        address.SetIid(aChild.mIp6Iid[i]);
+
+        if (mNetworkData.GetContext(address, context) == kThreadError_None)
         {
             // compressed entry
             entry.SetContextId(context.mContextId);
-            entry.SetIid(aChild.mIp6Address[i].GetIid());
+            entry.SetIid(aChild.mIp6Iid[i]);
         }
         else
         {
             // uncompressed entry
             entry.SetUncompressed();
-            entry.SetIp6Address(aChild.mIp6Address[i]);
+            entry.SetIp6Address(address);
         }
 
         SuccessOrExit(error = aMessage.Append(&entry, entry.GetLength()));
@@ -2794,13 +3285,14 @@ exit:
 
 ThreadError MleRouter::AppendRoute(Message &aMessage)
 {
-    ThreadError error;
-    RouteTlv tlv;
+    RouteTlv &tlv = mRouteTlv;
     int routeCount = 0;
     uint8_t cost;
 
+    // the encoded Route TLV is reused until the routing state changes
+    VerifyOrExit(mRouteTlvDirty, ;);
+
     tlv.Init();
-    tlv.SetRouterIdSequence(mRouterIdSequence);
     tlv.ClearRouterIdMask();
 
     for (int i = 0; i < kMaxRouterId; i++)
@@ -2843,10 +3335,12 @@ ThreadError MleRouter::AppendRoute(Message &aMessage)
     }
 
     tlv.SetRouteDataLength(routeCount);
-    SuccessOrExit(error = aMessage.Append(&tlv, sizeof(Tlv) + tlv.GetLength()));
+    mRouteTlvDirty = false;
 
 exit:
-    return error;
+    // a new Router ID Sequence alone does not change the routes
+    tlv.SetRouterIdSequence(mRouterIdSequence);
+    return aMessage.Append(&tlv, sizeof(Tlv) + tlv.GetLength());
 }
 
 }  // namespace Mle
@@ -66,6 +66,7 @@ class NetworkDataLeader;
 class MleRouter: public Mle
 {
     friend class Mle;
+    friend class MleRouterTest;
 
 public:
     /**
@@ -219,15 +220,57 @@ public:
      */
     Child *GetChild(const Mac::Address &aAddress);
 
+    /**
+     * This method returns a pointer to the Child that has registered an IPv6 address.
+     *
+     * @param[in]  aAddress  A reference to the IPv6 address.
+     *
+     * @returns A pointer to the valid Child that registered @p aAddress, NULL otherwise.
+     *
+     */
+    Child *GetChild(const Ip6::Address &aAddress);
+
+    /**
+     * This method returns a pointer to a Minimal Thread Device child that has registered an IPv6 address.
+     *
+     * Unlike GetChild(), full-function children that registered @p aAddress are passed over.
+     *
+     * @param[in]  aAddress  A reference to the IPv6 address.
+     *
+     * @returns A pointer to the valid MTD Child that registered @p aAddress, NULL otherwise.
+     *
+     */
+    Child *GetMtdChild(const Ip6::Address &aAddress);
+
     /**
      * This method returns a child index for the Child object.
      *
      * @param[in]  aChild  A reference to the Child object.
      *
-     * @returns A pointer to the Child corresponding to @p aAddress, NULL otherwise.
+     * @returns The index of @p aChild in the child table.
+     *
+     */
+    uint16_t GetChildIndex(const Child &aChild);
+
+    /**
+     * This method returns the prefix identifier under which children register IPv6 addresses with a given prefix.
+     *
+     * @param[in]  aAddress  A reference to the IPv6 address.
+     *
+     * @returns The prefix identifier, or Child::kInvalidPrefixId if children can only have registered @p aAddress in
+     *          full.
+     *
+     */
+    uint8_t GetChildPrefixId(const Ip6::Address &aAddress);
+
+    /**
+     * This method removes a registered IPv6 address from a child.
+     *
+     * @param[in]  aChild  A reference to the Child object.
+     * @param[in]  aIndex  The index of the registered address.
      *
      */
-    int GetChildIndex(const Child &aChild);
+    void RemoveChildAddress(Child &aChild, uint8_t aIndex);
 
     /**
      * This method returns a pointer to a Child array.
@@ -237,7 +280,7 @@ public:
      * @returns A pointer to the Child array.
      *
      */
-    Child *GetChildren(uint8_t *aNumChildren);
+    Child *GetChildren(uint16_t *aNumChildren);
 
     /**
      * This method returns a pointer to a Neighbor object.
@@ -321,10 +364,50 @@ public:
      */
     ThreadError SendLinkReject(const Ip6::Address &aDestination);
 
+    /**
+     * This method indicates that the routing state has changed and the Route TLV must be encoded again.
+     *
+     */
+    void SetRouteTlvDirty(void) { mRouteTlvDirty = true; }
+
 private:
     enum
     {
-        kStateUpdatePeriod = 1000u,  ///< State update period in milliseconds.
+        kStateUpdatePeriod     = 1000u,  ///< State update period in milliseconds.
+        kMaxChildIdRequestTlvs = 4,      ///< Maximum number of TLVs held for a pending Child ID Request.
+        kMaxChildAddresses     = kMaxChildren * Child::kMaxIp6AddressPerChild,  ///< Also the end of a hash chain.
+    };
+
+    /**
+     * This structure holds a 64-bit prefix used by child addresses.
+     *
+     */
+    struct ChildPrefix
+    {
+        uint8_t mPrefix[8];  ///< The 64-bit prefix
+        bool    mAllocated;  ///< Indicates whether or not this entry is allocated
+    };
+
+    /**
+     * This structure holds a Child ID Request received while upgrading to a router.
+     *
+     */
+    struct PendingChildIdRequest
+    {
+        uint16_t mChildIndex;                          ///< The requesting child, or kMaxChildren when unused
+        uint8_t  mRequestTlvs[kMaxChildIdRequestTlvs]; ///< Requested MLE TLVs
+    };
+
+    /**
+     * This structure holds a child entry as stored in non-volatile memory.
+     *
+     */
+    struct ChildInfo
+    {
+        Mac::ExtAddress mExtAddress;  ///< The child's IEEE 802.15.4 Extended Address
+        uint32_t        mTimeout;     ///< The child timeout
+        uint16_t        mRloc16;      ///< The child's RLOC16
+        uint8_t         mMode;        ///< The child's MLE device mode
     };
 
     ThreadError AppendConnectivity(Message &aMessage);
@@ -333,18 +416,22 @@ private:
     uint8_t GetLinkCost(uint8_t aRouterId);
     ThreadError HandleDetachStart(void);
     ThreadError HandleChildStart(otMleAttachFilter aFilter);
-    ThreadError HandleLinkRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleLinkAccept(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence);
-    ThreadError HandleLinkAccept(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence,
-                                 bool request);
-    ThreadError HandleLinkAcceptAndRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                           uint32_t aKeySequence);
+    ThreadError HandleLinkRequest(const Message &aMessage, const TlvIndex &aTlvs, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleLinkAccept(const Message &aMessage, const TlvIndex &aTlvs, const Ip6::MessageInfo &aMessageInfo,
+                                 uint32_t aKeySequence);
+    ThreadError HandleLinkAccept(const Message &aMessage, const TlvIndex &aTlvs, const Ip6::MessageInfo &aMessageInfo,
+                                 uint32_t aKeySequence, bool request);
+    ThreadError HandleLinkAcceptAndRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                           const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence);
     ThreadError HandleLinkReject(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleAdvertisement(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleParentRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
-    ThreadError HandleChildIdRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
-                                     uint32_t aKeySequence);
-    ThreadError HandleChildUpdateRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleAdvertisement(const Message &aMessage, const TlvIndex &aTlvs,
+                                    const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleParentRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                    const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleChildIdRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                     const Ip6::MessageInfo &aMessageInfo, uint32_t aKeySequence);
+    ThreadError HandleChildUpdateRequest(const Message &aMessage, const TlvIndex &aTlvs,
+                                         const Ip6::MessageInfo &aMessageInfo);
     ThreadError HandleNetworkDataUpdateRouter(void);
 
     ThreadError ProcessRouteTlv(const RouteTlv &aRoute);
@@ -358,12 +445,14 @@ private:
     ThreadError SendLinkAccept(const Ip6::MessageInfo &aMessageInfo, Neighbor *aNeighbor,
                                const TlvRequestTlv &aTlvRequest, const ChallengeTlv &aChallenge);
     ThreadError SendParentResponse(Child *aChild, const ChallengeTlv &aChallenge);
-    ThreadError SendChildIdResponse(Child *aChild);
+    ThreadError SendChildIdResponse(Child *aChild, const uint8_t *aRequestTlvs, uint8_t aRequestTlvsLength);
     ThreadError SendChildUpdateResponse(Child *aChild, const Ip6::MessageInfo &aMessageInfo,
                                         const uint8_t *aTlvs, uint8_t aTlvsLength,  const ChallengeTlv *challenge);
     ThreadError SetStateRouter(uint16_t aRloc16);
     ThreadError SetStateLeader(uint16_t aRloc16);
     ThreadError UpdateChildAddresses(const AddressRegistrationTlv &aTlv, Child &aChild);
+    uint8_t AllocateChildPrefixId(const Ip6::Address &aAddress);
+    ThreadError SavePendingChildIdRequest(const Child &aChild, const TlvRequestTlv &aTlvRequest);
     void UpdateRoutes(const RouteTlv &aTlv, uint8_t aRouterId);
 
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
@@ -380,10 +469,27 @@ private:
 
     Child *NewChild(void);
     Child *FindChild(const Mac::ExtAddress &aMacAddr);
+    uint16_t AllocateChildId(const Child &aChild);
+
+    static uint8_t HashExtAddress(const Mac::ExtAddress &aMacAddr);
+    void AddChildToHash(Child &aChild);
+    void RemoveChildFromHash(Child &aChild);
+    void ClearChildHash(void);
+
+    static uint8_t HashChildAddress(uint8_t aPrefixId, const uint8_t *aIid);
+    void AddChildAddressToHash(Child &aChild, uint8_t aIndex);
+    Child *FindChildAddress(const Ip6::Address &aAddress, bool aMtdOnly);
+    Child *FindChildAddress(uint8_t aPrefixId, const Ip6::Address &aAddress, bool aMtdOnly);
+    void RemoveChildAddresses(Child &aChild);
 
     int AllocateRouterId(void);
     int AllocateRouterId(uint8_t aRouterId);
     bool InRouterIdMask(uint8_t aRouterId);
+    void SetRouterId(uint8_t aRouterId);
+
+    ThreadError StoreChild(const Child &aChild);
+    ThreadError RemoveStoredChild(const Mac::ExtAddress &aMacAddr);
+    void RestoreChildren(void);
 
     static void HandleAdvertiseTimer(void *aContext);
     void HandleAdvertiseTimer(void);
@@ -400,7 +506,13 @@ private:
     uint8_t mRouterIdSequence;
     uint32_t mRouterIdSequenceLastUpdated;
     Router mRouters[kMaxRouterId];
+    RouteTlv mRouteTlv;
+    bool mRouteTlvDirty;
     Child mChildren[kMaxChildren];
+    uint16_t mChildHash[kChildHashSize];
+    uint16_t mChildAddressHash[kChildAddressHashSize];
+    PendingChildIdRequest mPendingChildIdRequests[kMaxPendingChildIdRequests];
+    ChildPrefix mChildPrefixes[kMaxChildPrefixes];
 
     uint8_t mChallenge[8];
     uint16_t mNextChildId;
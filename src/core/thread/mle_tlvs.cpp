@@ -38,31 +38,112 @@
 namespace Thread {
 namespace Mle {
 
+void Tlv::InitIndex(TlvIndex &aIndex, const Message &aMessage)
+{
+#if OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE > 255
+    aIndex.Init(aMessage, kNetworkData);
+#else
+    aIndex.Init(aMessage);
+#endif
+}
+
+ThreadError Tlv::Find(const Message &aMessage, Type aType, uint16_t &aOffset, uint16_t &aValueOffset,
+                      uint16_t &aLength)
+{
+#if OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE > 255
+    return TlvIndex::Find(aMessage, aType, kNetworkData, aOffset, aValueOffset, aLength);
+#else
+    return TlvIndex::Find(aMessage, aType, aOffset, aValueOffset, aLength);
+#endif
+}
+
 ThreadError Tlv::GetTlv(const Message &aMessage, Type aType, uint16_t aMaxLength, Tlv &aTlv)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset = aMessage.GetOffset();
-    uint16_t end = aMessage.GetLength();
+    ThreadError error;
+    uint16_t offset;
+    uint16_t valueOffset;
+    uint16_t length;
+
+    SuccessOrExit(error = Find(aMessage, aType, offset, valueOffset, length));
+    error = Read(aMessage, offset, valueOffset, length, aMaxLength, aTlv);
+
+exit:
+    return error;
+}
+
+ThreadError Tlv::GetTlv(const TlvIndex &aIndex, Type aType, uint16_t aMaxLength, Tlv &aTlv)
+{
+    ThreadError error;
+    uint16_t offset;
+    uint16_t valueOffset;
+    uint16_t length;
+
+    SuccessOrExit(error = aIndex.Find(aType, offset, valueOffset, length));
+    error = Read(aIndex.GetMessage(), offset, valueOffset, length, aMaxLength, aTlv);
+
+exit:
+    return error;
+}
+
+ThreadError Tlv::GetValueOffset(const Message &aMessage, Type aType, uint16_t &aOffset, uint16_t &aLength)
+{
+    uint16_t offset;
 
-    while (offset < end)
+    return Find(aMessage, aType, offset, aOffset, aLength);
+}
+
+ThreadError Tlv::GetValueOffset(const TlvIndex &aIndex, Type aType, uint16_t &aOffset, uint16_t &aLength)
+{
+    uint16_t offset;
+
+    return aIndex.Find(aType, offset, aOffset, aLength);
+}
+
+ThreadError Tlv::Read(const Message &aMessage, uint16_t aOffset, uint16_t aValueOffset, uint16_t aLength,
+                      uint16_t aMaxLength, Tlv &aTlv)
+{
+    ThreadError error = kThreadError_None;
+
+    // extended TLVs do not fit the fixed-size TLV classes
+    VerifyOrExit(aValueOffset == aOffset + sizeof(aTlv), error = kThreadError_Parse);
+
+    if (aMaxLength > sizeof(aTlv) + aLength)
     {
-        aMessage.Read(offset, sizeof(Tlv), &aTlv);
+        aMaxLength = sizeof(aTlv) + aLength;
+    }
 
-        if (aTlv.GetType() == aType && (offset + sizeof(aTlv) + aTlv.GetLength()) <= end)
-        {
-            if (aMaxLength > sizeof(aTlv) + aTlv.GetLength())
-            {
-                aMaxLength = sizeof(aTlv) + aTlv.GetLength();
-            }
+    aMessage.Read(aOffset, aMaxLength, &aTlv);
 
-            aMessage.Read(offset, aMaxLength, &aTlv);
+exit:
+    return error;
+}
+
+ThreadError Tlv::Append(Message &aMessage, Type aType, const void *aValue, uint16_t aLength)
+{
+    ThreadError error;
+    Tlv tlv;
 
-            ExitNow(error = kThreadError_None);
-        }
+    tlv.SetType(aType);
 
-        offset += sizeof(aTlv) + aTlv.GetLength();
+#if OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE > 255
+
+    if (aType == kNetworkData && aLength >= kExtendedLength)
+    {
+        uint16_t length = HostSwap16(aLength);
+
+        tlv.SetLength(kExtendedLength);
+        SuccessOrExit(error = aMessage.Append(&tlv, sizeof(tlv)));
+        SuccessOrExit(error = aMessage.Append(&length, sizeof(length)));
+        ExitNow(error = aMessage.Append(aValue, aLength));
     }
 
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE > 255
+
+    VerifyOrExit(aLength <= 0xff, error = kThreadError_InvalidArgs);
+    tlv.SetLength(static_cast<uint8_t>(aLength));
+    SuccessOrExit(error = aMessage.Append(&tlv, sizeof(tlv)));
+    SuccessOrExit(error = aMessage.Append(aValue, aLength));
+
 exit:
     return error;
 }
@@ -39,6 +39,7 @@
 #include <openthread-types.h>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/tlv_index.hpp>
 #include <net/ip6_address.hpp>
 #include <thread/mle_constants.hpp>
 
@@ -92,6 +93,7 @@ public:
         kStatus              = 17,   ///< Status TLV
         kVersion             = 18,   ///< Version TLV
         kAddressRegistration = 19,   ///< Address Registration TLV
+        kNetworkDataDelta    = 128,  ///< Network Data Delta TLV (non-standard)
         kInvalid             = 255,
     };
 
@@ -125,6 +127,18 @@ public:
      */
     void SetLength(uint8_t aLength) { mLength = aLength; }
 
+    /**
+     * This static method indexes the MLE TLVs in @p aMessage.
+     *
+     * Only the Network Data TLV may use the extended length format, and only when
+     * OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE exceeds 255 bytes.
+     *
+     * @param[out]  aIndex    A reference to the TLV index.
+     * @param[in]   aMessage  A reference to the message.
+     *
+     */
+    static void InitIndex(TlvIndex &aIndex, const Message &aMessage);
+
     /**
      * This static method reads the requested TLV out of @p aMessage.
      *
@@ -139,7 +153,79 @@ public:
      */
     static ThreadError GetTlv(const Message &aMessage, Type aType, uint16_t aMaxLength, Tlv &aTlv);
 
+    /**
+     * This static method reads the requested TLV using a TLV index of the message.
+     *
+     * @param[in]   aIndex      A reference to the TLV index.
+     * @param[in]   aType       The Type value to search for.
+     * @param[in]   aMaxLength  Maximum number of bytes to read.
+     * @param[out]  aTlv        A reference to the TLV that will be copied to.
+     *
+     * @retval kThreadError_None   Successfully copied the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    static ThreadError GetTlv(const TlvIndex &aIndex, Type aType, uint16_t aMaxLength, Tlv &aTlv);
+
+    /**
+     * This static method locates the Value of the requested TLV in @p aMessage.
+     *
+     * Unlike GetTlv(), this method supports a Network Data TLV using the extended length format.
+     *
+     * @param[in]   aMessage  A reference to the message.
+     * @param[in]   aType     The Type value to search for.
+     * @param[out]  aOffset   The offset of the Value in @p aMessage.
+     * @param[out]  aLength   The length of the Value in bytes.
+     *
+     * @retval kThreadError_None   Successfully located the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    static ThreadError GetValueOffset(const Message &aMessage, Type aType, uint16_t &aOffset, uint16_t &aLength);
+
+    /**
+     * This static method locates the Value of the requested TLV using a TLV index of the message.
+     *
+     * @param[in]   aIndex   A reference to the TLV index.
+     * @param[in]   aType    The Type value to search for.
+     * @param[out]  aOffset  The offset of the Value in the message.
+     * @param[out]  aLength  The length of the Value in bytes.
+     *
+     * @retval kThreadError_None   Successfully located the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    static ThreadError GetValueOffset(const TlvIndex &aIndex, Type aType, uint16_t &aOffset, uint16_t &aLength);
+
+    /**
+     * This static method appends a TLV to @p aMessage.
+     *
+     * When OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE exceeds 255 bytes, Network Data TLV values of kExtendedLength bytes
+     * or more are encoded using the extended length format.  Other values are limited to 255 bytes.
+     *
+     * @param[in]  aMessage  A reference to the message.
+     * @param[in]  aType     The Type value.
+     * @param[in]  aValue    A pointer to the Value.
+     * @param[in]  aLength   The length of the Value in bytes.
+     *
+     * @retval kThreadError_None         Successfully appended the TLV.
+     * @retval kThreadError_InvalidArgs  @p aLength does not fit the TLV Length.
+     * @retval kThreadError_NoBufs       Insufficient buffers available to append the TLV.
+     *
+     */
+    static ThreadError Append(Message &aMessage, Type aType, const void *aValue, uint16_t aLength);
+
+    enum
+    {
+        kExtendedLength = 255,  ///< Length value indicating that a 16-bit Length follows the TLV header.
+    };
+
 private:
+    static ThreadError Find(const Message &aMessage, Type aType, uint16_t &aOffset, uint16_t &aValueOffset,
+                            uint16_t &aLength);
+    static ThreadError Read(const Message &aMessage, uint16_t aOffset, uint16_t aValueOffset, uint16_t aLength,
+                            uint16_t aMaxLength, Tlv &aTlv);
+
     uint8_t mType;
     uint8_t mLength;
 } __attribute__((packed));
@@ -777,17 +863,25 @@ private:
 } __attribute__((packed));
 
 /**
- * This class implements Source Address TLV generation and parsing.
+ * This class implements Network Data Delta TLV generation and parsing.
+ *
+ * In a Data Request, the TLV carries only the Network Data version held by the requester.  In a Data Response, the
+ * version is followed by the edits that bring the Network Data from that version to the current one.
  *
  */
-class NetworkDataTlv: public Tlv
+class NetworkDataDeltaTlv: public Tlv
 {
 public:
+    enum
+    {
+        kMaxLength = 255,  ///< Maximum length of the TLV Value (bytes).
+    };
+
     /**
      * This method initializes the TLV.
      *
      */
-    void Init(void) { SetType(kNetworkData); SetLength(sizeof(*this) - sizeof(Tlv)); }
+    void Init(void) { SetType(kNetworkDataDelta); SetLength(sizeof(*this) - sizeof(Tlv)); }
 
     /**
      * This method indicates whether or not the TLV appears to be well-formed.
@@ -796,26 +890,34 @@ public:
      * @retval FALSE  If the TLV does not appear to be well-formed.
      *
      */
-    bool IsValid(void) const { return GetLength() <= sizeof(*this) - sizeof(Tlv); }
+    bool IsValid(void) const { return GetLength() >= sizeof(uint8_t) && GetLength() <= sizeof(*this) - sizeof(Tlv); }
 
     /**
-     * This method returns a pointer to the Network Data.
+     * This method returns the Network Data version the deltas apply to.
      *
-     * @returns A pointer to the Network Data.
+     * @returns The Network Data version.
      *
      */
-    uint8_t *GetNetworkData(void) { return mNetworkData; }
+    uint8_t GetVersion(void) const { return mDeltas[0]; }
 
     /**
-     * This method sets the Network Data.
+     * This method sets the Network Data version the deltas apply to.
      *
-     * @param[in]  aNetworkData  A pointer to the Network Data.
+     * @param[in]  aVersion  The Network Data version.
      *
      */
-    void SetNetworkData(const uint8_t *aNetworkData) { memcpy(mNetworkData, aNetworkData, GetLength()); }
+    void SetVersion(uint8_t aVersion) { mDeltas[0] = aVersion; }
+
+    /**
+     * This method returns a pointer to the Network Data deltas.
+     *
+     * @returns A pointer to the Network Data deltas.
+     *
+     */
+    uint8_t *GetDeltas(void) { return mDeltas; }
 
 private:
-    uint8_t mNetworkData[255];
+    uint8_t mDeltas[kMaxLength];
 } __attribute__((packed));
 
 /**
@@ -1352,13 +1454,12 @@ public:
         const uint8_t *end = cur + GetLength();
 
         while (cur < end) {
-            entry = reinterpret_cast<const AddressRegistrationEntry *>(cur);
-
             if (aIndex == 0) {
+                entry = reinterpret_cast<const AddressRegistrationEntry *>(cur);
                 break;
             }
 
-            cur += entry->GetLength();
+            cur += reinterpret_cast<const AddressRegistrationEntry *>(cur)->GetLength();
             aIndex--;
         }
 
@@ -44,7 +44,7 @@ NetworkData::NetworkData(void)
     mLength = 0;
 }
 
-void NetworkData::GetNetworkData(bool aStable, uint8_t *aData, uint8_t &aDataLength)
+void NetworkData::GetNetworkData(bool aStable, uint8_t *aData, uint16_t &aDataLength)
 {
     assert(aData != NULL);
 
@@ -57,153 +57,146 @@ void NetworkData::GetNetworkData(bool aStable, uint8_t *aData, uint8_t &aDataLen
     }
 }
 
-void NetworkData::RemoveTemporaryData(uint8_t *aData, uint8_t &aDataLength)
+void NetworkData::RemoveTemporaryData(uint8_t *aData, uint16_t &aDataLength)
 {
-    NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aData);
-    NetworkDataTlv *end;
+    uint8_t *cur = aData;
+    uint8_t *end = aData + aDataLength;
+    uint8_t *dst = aData;
+    NetworkDataTlv *tlv;
     PrefixTlv *prefix;
-    uint8_t length;
-    uint8_t *dst;
-    uint8_t *src;
+    ContextTlv *context;
+    uint16_t length;
+    uint8_t headerLength;
+    uint8_t subTlvsLength;
+    uint8_t contextId;
 
-    while (1)
+    // kept TLVs are moved towards the front as they are visited, so each byte is moved at most once
+    while (cur < end)
     {
-        end = reinterpret_cast<NetworkDataTlv *>(aData + aDataLength);
-
-        if (cur >= end)
-        {
-            break;
-        }
+        tlv = reinterpret_cast<NetworkDataTlv *>(cur);
+        length = sizeof(NetworkDataTlv) + tlv->GetLength();
 
-        switch (cur->GetType())
+        switch (tlv->GetType())
         {
         case NetworkDataTlv::kTypePrefix:
         {
             prefix = reinterpret_cast<PrefixTlv *>(cur);
-            RemoveTemporaryData(aData, aDataLength, *prefix);
+            context = FindContext(*prefix);
+            contextId = (context != NULL) ? context->GetContextId() : 0;
+            headerLength = static_cast<uint8_t>(prefix->GetSubTlvs() - cur);
+            subTlvsLength = prefix->GetSubTlvsLength();
 
-            if (prefix->GetSubTlvsLength() == 0)
+            memmove(dst, cur, headerLength);
+            prefix = reinterpret_cast<PrefixTlv *>(dst);
+            subTlvsLength = CopyStableSubTlvs(cur + headerLength, subTlvsLength, contextId, dst + headerLength);
+
+            // remove prefix tlv if empty
+            if (subTlvsLength > 0)
             {
-                length = sizeof(NetworkDataTlv) + cur->GetLength();
-                dst = reinterpret_cast<uint8_t *>(cur);
-                src = reinterpret_cast<uint8_t *>(cur->GetNext());
-                memmove(dst, src, aDataLength - (src - aData));
-                aDataLength -= length;
-                continue;
+                prefix->SetSubTlvsLength(subTlvsLength);
+                dst += sizeof(NetworkDataTlv) + prefix->GetLength();
             }
 
-            otDumpDebgNetData("remove prefix done", mTlvs, mLength);
             break;
         }
 
         default:
         {
             // remove temporary tlv
-            if (!cur->IsStable())
+            if (tlv->IsStable())
             {
-                length = sizeof(NetworkDataTlv) + cur->GetLength();
-                dst = reinterpret_cast<uint8_t *>(cur);
-                src = reinterpret_cast<uint8_t *>(cur->GetNext());
-                memmove(dst, src, aDataLength - (src - aData));
-                aDataLength -= length;
-                continue;
+                memmove(dst, cur, length);
+                dst += length;
             }
 
             break;
         }
         }
 
-        cur = cur->GetNext();
+        cur += length;
     }
 
+    aDataLength = static_cast<uint16_t>(dst - aData);
+
     otDumpDebgNetData("remove done", aData, aDataLength);
 }
 
-void NetworkData::RemoveTemporaryData(uint8_t *aData, uint8_t &aDataLength, PrefixTlv &aPrefix)
+uint8_t NetworkData::CopyStableSubTlvs(uint8_t *aSubTlvs, uint8_t aSubTlvsLength, uint8_t aContextId,
+                                       uint8_t *aDst)
 {
-    NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aPrefix.GetSubTlvs());
-    NetworkDataTlv *end;
+    uint8_t *cur = aSubTlvs;
+    uint8_t *end = aSubTlvs + aSubTlvsLength;
+    uint8_t *dst = aDst;
+    NetworkDataTlv *tlv;
     BorderRouterTlv *borderRouter;
     HasRouteTlv *hasRoute;
-    ContextTlv *context;
     BorderRouterEntry *borderRouterEntry;
-    HasRouteEntry *hasRouteEntry;
-    uint8_t length;
-    uint8_t contextId;
-    uint8_t *dst;
-    uint8_t *src;
+    uint16_t length;
 
-    while (1)
+    while (cur < end)
     {
-        end = reinterpret_cast<NetworkDataTlv *>(aPrefix.GetSubTlvs() + aPrefix.GetSubTlvsLength());
+        tlv = reinterpret_cast<NetworkDataTlv *>(cur);
+        length = sizeof(NetworkDataTlv) + tlv->GetLength();
 
-        if (cur >= end)
+        // remove temporary tlv
+        if (!tlv->IsStable())
         {
-            break;
+            cur += length;
+            continue;
         }
 
-        if (cur->IsStable())
+        memmove(dst, cur, length);
+        tlv = reinterpret_cast<NetworkDataTlv *>(dst);
+
+        switch (tlv->GetType())
         {
-            switch (cur->GetType())
-            {
-            case NetworkDataTlv::kTypeBorderRouter:
+        case NetworkDataTlv::kTypeBorderRouter:
+        {
+            borderRouter = static_cast<BorderRouterTlv *>(tlv);
+
+            // replace p_border_router_16
+            for (int i = 0; i < borderRouter->GetNumEntries(); i++)
             {
-                borderRouter = FindBorderRouter(aPrefix);
-                context = FindContext(aPrefix);
-                contextId = context->GetContextId();
+                borderRouterEntry = borderRouter->GetEntry(i);
 
-                // replace p_border_router_16
-                for (int i = 0; i < borderRouter->GetNumEntries(); i++)
+                if (borderRouterEntry->IsDhcp() || borderRouterEntry->IsConfigure())
                 {
-                    borderRouterEntry = borderRouter->GetEntry(i);
-
-                    if (borderRouterEntry->IsDhcp() || borderRouterEntry->IsConfigure())
-                    {
-                        borderRouterEntry->SetRloc(0xfc00 | contextId);
-                    }
-                    else
-                    {
-                        borderRouterEntry->SetRloc(0xfffe);
-                    }
+                    borderRouterEntry->SetRloc(0xfc00 | aContextId);
                 }
-
-                break;
-            }
-
-            case NetworkDataTlv::kTypeHasRoute:
-            {
-                hasRoute = FindHasRoute(aPrefix);
-
-                // replace r_border_router_16
-                for (int j = 0; j < hasRoute->GetNumEntries(); j++)
+                else
                 {
-                    hasRouteEntry = hasRoute->GetEntry(j);
-                    hasRouteEntry->SetRloc(0xfffe);
+                    borderRouterEntry->SetRloc(0xfffe);
                 }
-
-                break;
             }
 
-            default:
+            break;
+        }
+
+        case NetworkDataTlv::kTypeHasRoute:
+        {
+            hasRoute = static_cast<HasRouteTlv *>(tlv);
+
+            // replace r_border_router_16
+            for (int j = 0; j < hasRoute->GetNumEntries(); j++)
             {
-                break;
-            }
+                hasRoute->GetEntry(j)->SetRloc(0xfffe);
             }
 
-            // keep stable tlv
-            cur = cur->GetNext();
+            break;
         }
-        else
+
+        default:
         {
-            // remove temporary tlv
-            length = sizeof(NetworkDataTlv) + cur->GetLength();
-            dst = reinterpret_cast<uint8_t *>(cur);
-            src = reinterpret_cast<uint8_t *>(cur->GetNext());
-            memmove(dst, src, aDataLength - (src - aData));
-            aPrefix.SetSubTlvsLength(aPrefix.GetSubTlvsLength() - length);
-            aDataLength -= length;
+            break;
+        }
         }
+
+        // keep stable tlv
+        dst += length;
+        cur += length;
     }
+
+    return static_cast<uint8_t>(dst - aDst);
 }
 
 BorderRouterTlv *NetworkData::FindBorderRouter(PrefixTlv &aPrefix)
@@ -362,7 +355,29 @@ int8_t NetworkData::PrefixMatch(const uint8_t *a, const uint8_t *b, uint8_t aLen
     return (rval >= aLength) ? rval : -1;
 }
 
-ThreadError NetworkData::Insert(uint8_t *aStart, uint8_t aLength)
+bool NetworkData::IsPrefixMatch(const uint8_t *aPrefix, uint8_t aPrefixLength, const uint8_t *aAddress)
+{
+    uint8_t bytes = aPrefixLength / 8;
+    uint8_t bits = aPrefixLength % 8;
+    bool rval = false;
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+        VerifyOrExit(aPrefix[i] == aAddress[i], ;);
+    }
+
+    if (bits != 0)
+    {
+        VerifyOrExit(((aPrefix[bytes] ^ aAddress[bytes]) & (0xff << (8 - bits))) == 0, ;);
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
+ThreadError NetworkData::Insert(uint8_t *aStart, uint16_t aLength)
 {
     assert(aLength + mLength <= sizeof(mTlvs) &&
            mTlvs <= aStart &&
@@ -372,7 +387,7 @@ ThreadError NetworkData::Insert(uint8_t *aStart, uint8_t aLength)
     return kThreadError_None;
 }
 
-ThreadError NetworkData::Remove(uint8_t *aStart, uint8_t aLength)
+ThreadError NetworkData::Remove(uint8_t *aStart, uint16_t aLength)
 {
     assert(aLength <= mLength &&
            mTlvs <= aStart &&
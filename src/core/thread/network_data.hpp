@@ -34,6 +34,7 @@
 #ifndef NETWORK_DATA_HPP_
 #define NETWORK_DATA_HPP_
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
 #include <thread/lowpan.hpp>
 #include <thread/network_data_tlvs.hpp>
@@ -84,7 +85,7 @@ class NetworkData
 public:
     enum
     {
-        kMaxSize = 255,  ///< Maximum size of Thread Network Data in bytes.
+        kMaxSize = OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE,  ///< Maximum size of Thread Network Data in bytes.
     };
 
     /**
@@ -101,7 +102,7 @@ public:
      * @param[inout]  aDataLength  On entry, size of the data buffer pointed to by @p aData.
      *                             On exit, number of copied bytes.
      */
-    void GetNetworkData(bool aStable, uint8_t *aData, uint8_t &aDataLength);
+    void GetNetworkData(bool aStable, uint8_t *aData, uint16_t &aDataLength);
 
 protected:
     /**
@@ -177,7 +178,7 @@ protected:
      * @retval kThreadError_NoBufs       Insufficient buffer space to insert bytes.
      *
      */
-    ThreadError Insert(uint8_t *aStart, uint8_t aLength);
+    ThreadError Insert(uint8_t *aStart, uint16_t aLength);
 
     /**
      * This method removes bytes from the Network Data.
@@ -188,28 +189,33 @@ protected:
      * @retval kThreadError_None    Successfully removed bytes.
      *
      */
-    ThreadError Remove(uint8_t *aStart, uint8_t aLength);
+    ThreadError Remove(uint8_t *aStart, uint16_t aLength);
 
     /**
      * This method strips non-stable data from the Thread Network Data.
      *
+     * The remaining TLVs are compacted in a single pass.
+     *
      * @param[inout]  aData        A pointer to the Network Data to modify.
      * @param[inout]  aDataLength  On entry, the size of the Network Data in bytes.  On exit, the size of the
      *                             resulting Network Data in bytes.
      *
      */
-    void RemoveTemporaryData(uint8_t *aData, uint8_t &aDataLength);
+    void RemoveTemporaryData(uint8_t *aData, uint16_t &aDataLength);
 
     /**
-     * This method strips non-stable Sub-TLVs from a Prefix TLV.
+     * This method copies the stable Sub-TLVs of a Prefix TLV, replacing the RLOC16 values as required for stable
+     * Network Data.
      *
-     * @param[inout]  aData        A pointer to the Network Data to modify.
-     * @param[inout]  aDataLength  On entry, the size of the Network Data in bytes.  On exit, the size of the
-     *                             resulting Network Data in bytes.
-     * @param[inout]  aPrefix      A reference to the Prefix TLV to modify.
+     * @param[in]  aSubTlvs        A pointer to the Sub-TLVs.
+     * @param[in]  aSubTlvsLength  The length of the Sub-TLVs in bytes.
+     * @param[in]  aContextId      The Context ID of the Prefix TLV.
+     * @param[in]  aDst            A pointer to the destination, at or before @p aSubTlvs.
+     *
+     * @returns The number of bytes written to @p aDst.
      *
      */
-    void RemoveTemporaryData(uint8_t *aData, uint8_t &aDataLength, PrefixTlv &aPrefix);
+    static uint8_t CopyStableSubTlvs(uint8_t *aSubTlvs, uint8_t aSubTlvsLength, uint8_t aContextId, uint8_t *aDst);
 
     /**
      * This method computes the number of IPv6 Prefix bits that match.
@@ -223,8 +229,21 @@ protected:
      */
     int8_t PrefixMatch(const uint8_t *a, const uint8_t *b, uint8_t aLength);
 
-    uint8_t mTlvs[kMaxSize];  ///< The Network Data buffer.
-    uint8_t mLength;          ///< The number of valid bytes in @var mTlvs.
+    /**
+     * This method indicates whether an IPv6 address falls within an IPv6 Prefix.
+     *
+     * @param[in]  aPrefix        A pointer to the IPv6 Prefix.
+     * @param[in]  aPrefixLength  The length of the IPv6 Prefix in bits.
+     * @param[in]  aAddress       A pointer to the IPv6 address.
+     *
+     * @retval TRUE   If the first @p aPrefixLength bits of @p aAddress match @p aPrefix.
+     * @retval FALSE  If the first @p aPrefixLength bits of @p aAddress do not match @p aPrefix.
+     *
+     */
+    static bool IsPrefixMatch(const uint8_t *aPrefix, uint8_t aPrefixLength, const uint8_t *aAddress);
+
+    uint8_t  mTlvs[kMaxSize];  ///< The Network Data buffer.
+    uint16_t mLength;          ///< The number of valid bytes in @var mTlvs.
 };
 
 }  // namespace NetworkData
@@ -39,6 +39,7 @@
 #include <common/message.hpp>
 #include <common/timer.hpp>
 #include <mac/mac_frame.hpp>
+#include <net/ip6.hpp>
 #include <platform/random.h>
 #include <thread/mle_router.hpp>
 #include <thread/network_data_leader.hpp>
@@ -53,6 +54,8 @@ namespace NetworkData {
 
 Leader::Leader(ThreadNetif &aThreadNetif):
     mTimer(&HandleTimer, this),
+    mCoalesceTimer(&HandleCoalesceTimer, this),
+    mCoalesceWindow(OPENTHREAD_CONFIG_NETWORK_DATA_COALESCE_WINDOW),
     mServerData(OPENTHREAD_URI_SERVER_DATA, &HandleServerData, this),
     mCoapServer(aThreadNetif.GetCoapServer()),
     mNetif(aThreadNetif),
@@ -68,8 +71,23 @@ void Leader::Reset(void)
     mVersion = otPlatRandomGet();
     mStableVersion = otPlatRandomGet();
     mLength = 0;
+    mStableTlvsValid = false;
+    UpdateIndex();
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+    mDeltaStart = 0;
+    mNumDeltas = 0;
+    mDeltaBaseLength = 0;
+    mDeltaBaseVersion = mVersion;
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
     mContextUsed = 0;
     mContextIdReuseDelay = kContextIdReuseDelay;
+    mSuppressedVersionBumps = 0;
+    mRegistrations = 0;
+    mVersionBumps = 0;
+    mVersionPending = false;
+    mStableVersionPending = false;
+    mCoalesceTimer.Stop();
+    ClearRegistrations();
 }
 
 void Leader::Start(void)
@@ -79,6 +97,8 @@ void Leader::Start(void)
 
 void Leader::Stop(void)
 {
+    mCoalesceTimer.Stop();
+    ClearRegistrations();
 }
 
 uint8_t Leader::GetVersion(void) const
@@ -91,6 +111,215 @@ uint8_t Leader::GetStableVersion(void) const
     return mStableVersion;
 }
 
+void Leader::SetCoalesceWindow(uint32_t aWindow)
+{
+    mCoalesceWindow = aWindow;
+
+    if (mCoalesceWindow == 0)
+    {
+        IncrementVersions();
+    }
+}
+
+const uint8_t *Leader::GetTlvs(uint16_t &aDataLength) const
+{
+    aDataLength = mLength;
+    return mTlvs;
+}
+
+const uint8_t *Leader::GetStableTlvs(uint16_t &aDataLength)
+{
+    if (!mStableTlvsValid || mStableTlvsVersion != mStableVersion)
+    {
+        GetNetworkData(true, mStableTlvs, mStableLength);
+        mStableTlvsVersion = mStableVersion;
+        mStableTlvsValid = true;
+    }
+
+    aDataLength = mStableLength;
+    return mStableTlvs;
+}
+
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+ThreadError Leader::GetDeltas(uint8_t aVersion, uint8_t *aDeltas, uint8_t &aDeltasLength) const
+{
+    ThreadError error = kThreadError_Error;
+    uint16_t checksum = ComputeChecksum(mTlvs, mLength);
+    uint8_t length = kDeltaHeaderSize;
+    uint8_t i;
+
+    // the retained edits form a single chain ending at the current version
+    for (i = 0; i < mNumDeltas; i++)
+    {
+        if (mDeltas[(mDeltaStart + i) % kDeltaHistory].mFromVersion == aVersion)
+        {
+            error = kThreadError_None;
+            break;
+        }
+    }
+
+    SuccessOrExit(error);
+    VerifyOrExit(aDeltasLength >= kDeltaHeaderSize, error = kThreadError_NoBufs);
+
+    aDeltas[0] = aVersion;
+    aDeltas[1] = static_cast<uint8_t>(checksum >> 8);
+    aDeltas[2] = static_cast<uint8_t>(checksum);
+
+    for (; i < mNumDeltas; i++)
+    {
+        const Delta &delta = mDeltas[(mDeltaStart + i) % kDeltaHistory];
+
+        VerifyOrExit(aDeltasLength - length >= kDeltaEditSize + delta.mInsertLength, error = kThreadError_NoBufs);
+
+        aDeltas[length++] = delta.mVersion;
+        aDeltas[length++] = static_cast<uint8_t>(delta.mOffset >> 8);
+        aDeltas[length++] = static_cast<uint8_t>(delta.mOffset);
+        aDeltas[length++] = static_cast<uint8_t>(delta.mRemoveLength >> 8);
+        aDeltas[length++] = static_cast<uint8_t>(delta.mRemoveLength);
+        aDeltas[length++] = delta.mInsertLength;
+        memcpy(aDeltas + length, delta.mInsert, delta.mInsertLength);
+        length += delta.mInsertLength;
+    }
+
+    aDeltasLength = length;
+
+exit:
+    return error;
+}
+
+ThreadError Leader::ApplyDeltas(uint8_t aVersion, uint8_t aStableVersion, const uint8_t *aDeltas,
+                                uint8_t aDeltasLength)
+{
+    ThreadError error = kThreadError_None;
+    uint8_t version;
+    uint16_t checksum;
+    bool applying;
+    bool restore = false;
+    uint8_t cur = kDeltaHeaderSize;
+
+    // the edits are applied in place, mDeltaBase holds the Network Data to restore on failure
+    VerifyOrExit(mDeltaBaseVersion == mVersion && !mVersionPending, error = kThreadError_Error);
+    VerifyOrExit(aDeltasLength >= kDeltaHeaderSize, error = kThreadError_Parse);
+    restore = true;
+
+    version = aDeltas[0];
+    checksum = static_cast<uint16_t>((aDeltas[1] << 8) | aDeltas[2]);
+    applying = (version == mVersion);
+
+    while (cur < aDeltasLength)
+    {
+        uint16_t offset;
+        uint16_t removeLength;
+        uint8_t insertLength;
+
+        VerifyOrExit(aDeltasLength - cur >= kDeltaEditSize, error = kThreadError_Parse);
+
+        offset = static_cast<uint16_t>((aDeltas[cur + 1] << 8) | aDeltas[cur + 2]);
+        removeLength = static_cast<uint16_t>((aDeltas[cur + 3] << 8) | aDeltas[cur + 4]);
+        insertLength = aDeltas[cur + 5];
+
+        VerifyOrExit(aDeltasLength - cur - kDeltaEditSize >= insertLength, error = kThreadError_Parse);
+
+        if (applying)
+        {
+            VerifyOrExit(offset <= mLength && removeLength <= mLength - offset &&
+                         mLength - removeLength + insertLength <= kMaxSize, error = kThreadError_Parse);
+
+            memmove(mTlvs + offset + insertLength, mTlvs + offset + removeLength, mLength - offset - removeLength);
+            memcpy(mTlvs + offset, aDeltas + cur + kDeltaEditSize, insertLength);
+            mLength = mLength - removeLength + insertLength;
+        }
+
+        version = aDeltas[cur];
+        cur += kDeltaEditSize + insertLength;
+
+        // a receiver that already holds an intermediate version starts with the following edit
+        if (version == mVersion)
+        {
+            applying = true;
+        }
+    }
+
+    VerifyOrExit(applying && version == aVersion, error = kThreadError_Error);
+    VerifyOrExit(ComputeChecksum(mTlvs, mLength) == checksum, error = kThreadError_Parse);
+
+    UpdateNetworkData(aVersion, aStableVersion, false);
+
+exit:
+
+    if (error != kThreadError_None && restore)
+    {
+        memcpy(mTlvs, mDeltaBase, mDeltaBaseLength);
+        mLength = mDeltaBaseLength;
+    }
+
+    return error;
+}
+
+void Leader::RecordDelta(bool aRetain)
+{
+    uint16_t prefix = 0;
+    uint16_t suffix = 0;
+    uint16_t common = mDeltaBaseLength < mLength ? mDeltaBaseLength : mLength;
+    Delta *delta;
+
+    VerifyOrExit(aRetain && mVersion != mDeltaBaseVersion, mNumDeltas = 0);
+
+    while (prefix < common && mDeltaBase[prefix] == mTlvs[prefix])
+    {
+        prefix++;
+    }
+
+    while (suffix < common - prefix &&
+           mDeltaBase[mDeltaBaseLength - 1 - suffix] == mTlvs[mLength - 1 - suffix])
+    {
+        suffix++;
+    }
+
+    // a change too large to retain restarts the history at the current version
+    VerifyOrExit(mLength - prefix - suffix <= kMaxDeltaLength, mNumDeltas = 0);
+
+    if (mNumDeltas == kDeltaHistory)
+    {
+        mDeltaStart = (mDeltaStart + 1) % kDeltaHistory;
+        mNumDeltas--;
+    }
+
+    delta = &mDeltas[(mDeltaStart + mNumDeltas) % kDeltaHistory];
+    delta->mFromVersion = mDeltaBaseVersion;
+    delta->mVersion = mVersion;
+    delta->mOffset = prefix;
+    delta->mRemoveLength = mDeltaBaseLength - prefix - suffix;
+    delta->mInsertLength = static_cast<uint8_t>(mLength - prefix - suffix);
+    memcpy(delta->mInsert, mTlvs + prefix, delta->mInsertLength);
+    mNumDeltas++;
+
+exit:
+    memcpy(mDeltaBase, mTlvs, mLength);
+    mDeltaBaseLength = mLength;
+    mDeltaBaseVersion = mVersion;
+}
+
+uint16_t Leader::ComputeChecksum(const uint8_t *aData, uint16_t aDataLength)
+{
+    return Ip6::Ip6::UpdateChecksum(aDataLength, aData, aDataLength);
+}
+#else  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+ThreadError Leader::GetDeltas(uint8_t, uint8_t *, uint8_t &) const
+{
+    return kThreadError_Error;
+}
+
+ThreadError Leader::ApplyDeltas(uint8_t, uint8_t, const uint8_t *, uint8_t)
+{
+    return kThreadError_Error;
+}
+
+void Leader::RecordDelta(bool)
+{
+}
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+
 uint32_t Leader::GetContextIdReuseDelay(void) const
 {
     return mContextIdReuseDelay;
@@ -116,35 +345,25 @@ ThreadError Leader::GetContext(const Ip6::Address &aAddress, Lowpan::Context &aC
         aContext.mContextId = 0;
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    for (int i = 0; i < mNumIndexedPrefixes; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
-
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
-
-        if (PrefixMatch(prefix->GetPrefix(), aAddress.m8, prefix->GetPrefixLength()) < 0)
+        if (mPrefixIndex[i].mContext == kInvalidOffset)
         {
             continue;
         }
 
-        contextTlv = FindContext(*prefix);
+        prefix = &GetPrefix(mPrefixIndex[i]);
 
-        if (contextTlv == NULL)
+        if (prefix->GetPrefixLength() <= aContext.mPrefixLength ||
+            !IsPrefixMatch(prefix->GetPrefix(), prefix->GetPrefixLength(), aAddress.m8))
         {
             continue;
         }
 
-        if (prefix->GetPrefixLength() > aContext.mPrefixLength)
-        {
-            aContext.mPrefix = prefix->GetPrefix();
-            aContext.mPrefixLength = prefix->GetPrefixLength();
-            aContext.mContextId = contextTlv->GetContextId();
-        }
+        contextTlv = reinterpret_cast<ContextTlv *>(mTlvs + mPrefixIndex[i].mContext);
+        aContext.mPrefix = prefix->GetPrefix();
+        aContext.mPrefixLength = prefix->GetPrefixLength();
+        aContext.mContextId = contextTlv->GetContextId();
     }
 
     return (aContext.mPrefixLength > 0) ? kThreadError_None : kThreadError_Error;
@@ -164,28 +383,21 @@ ThreadError Leader::GetContext(uint8_t aContextId, Lowpan::Context &aContext)
         ExitNow(error = kThreadError_None);
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    for (int i = 0; i < mNumIndexedPrefixes; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        if (mPrefixIndex[i].mContext == kInvalidOffset)
         {
             continue;
         }
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
-        contextTlv = FindContext(*prefix);
-
-        if (contextTlv == NULL)
-        {
-            continue;
-        }
+        contextTlv = reinterpret_cast<ContextTlv *>(mTlvs + mPrefixIndex[i].mContext);
 
         if (contextTlv->GetContextId() != aContextId)
         {
             continue;
         }
 
+        prefix = &GetPrefix(mPrefixIndex[i]);
         aContext.mPrefix = prefix->GetPrefix();
         aContext.mPrefixLength = prefix->GetPrefixLength();
         aContext.mContextId = contextTlv->GetContextId();
@@ -198,8 +410,6 @@ exit:
 
 ThreadError Leader::ConfigureAddresses(void)
 {
-    PrefixTlv *prefix;
-
     // clear out addresses that are not on-mesh
     for (size_t i = 0; i < sizeof(mAddresses) / sizeof(mAddresses[0]); i++)
     {
@@ -214,17 +424,9 @@ ThreadError Leader::ConfigureAddresses(void)
     }
 
     // configure on-mesh addresses
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    for (int i = 0; i < mNumIndexedPrefixes; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
-
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
-        ConfigureAddress(*prefix);
+        ConfigureAddress(GetPrefix(mPrefixIndex[i]));
     }
 
     return kThreadError_None;
@@ -255,7 +457,13 @@ ThreadError Leader::ConfigureAddress(PrefixTlv &aPrefix)
             mAddresses[i].mPrefixLength == aPrefix.GetPrefixLength() &&
             PrefixMatch(mAddresses[i].mAddress.m8, aPrefix.GetPrefix(), aPrefix.GetPrefixLength()) >= 0)
         {
-            mAddresses[i].mPreferredLifetime = entry->IsPreferred() ? 0xffffffff : 0;
+            if (mAddresses[i].mPreferredLifetime != (entry->IsPreferred() ? 0xffffffff : 0))
+            {
+                // re-add so that source address selection picks up the changed lifetime
+                mAddresses[i].mPreferredLifetime = entry->IsPreferred() ? 0xffffffff : 0;
+                mNetif.AddUnicastAddress(mAddresses[i]);
+            }
+
             ExitNow();
         }
     }
@@ -297,28 +505,19 @@ bool Leader::IsOnMesh(const Ip6::Address &aAddress)
         ExitNow(rval = true);
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    for (int i = 0; i < mNumIndexedPrefixes; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        if (mPrefixIndex[i].mBorderRouter[0] == kInvalidOffset)
         {
             continue;
         }
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        prefix = &GetPrefix(mPrefixIndex[i]);
 
-        if (PrefixMatch(prefix->GetPrefix(), aAddress.m8, prefix->GetPrefixLength()) < 0)
+        if (IsPrefixMatch(prefix->GetPrefix(), prefix->GetPrefixLength(), aAddress.m8))
         {
-            continue;
+            ExitNow(rval = true);
         }
-
-        if (FindBorderRouter(*prefix) == NULL)
-        {
-            continue;
-        }
-
-        ExitNow(rval = true);
     }
 
 exit:
@@ -331,25 +530,18 @@ ThreadError Leader::RouteLookup(const Ip6::Address &aSource, const Ip6::Address
     ThreadError error = kThreadError_NoRoute;
     PrefixTlv *prefix;
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    for (int i = 0; i < mNumIndexedPrefixes; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
-
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        prefix = &GetPrefix(mPrefixIndex[i]);
 
-        if (PrefixMatch(prefix->GetPrefix(), aSource.m8, prefix->GetPrefixLength()) >= 0)
+        if (IsPrefixMatch(prefix->GetPrefix(), prefix->GetPrefixLength(), aSource.m8))
         {
             if (ExternalRouteLookup(prefix->GetDomainId(), aDestination, aPrefixMatch, aRloc16) == kThreadError_None)
             {
                 ExitNow(error = kThreadError_None);
             }
 
-            if (DefaultRouteLookup(*prefix, aRloc16) == kThreadError_None)
+            if (DefaultRouteLookup(mPrefixIndex[i], aRloc16) == kThreadError_None)
             {
                 if (aPrefixMatch)
                 {
@@ -375,18 +567,15 @@ ThreadError Leader::ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &a
     HasRouteEntry *rvalRoute = NULL;
     int8_t rval_plen = 0;
     int8_t plen;
-    NetworkDataTlv *cur;
 
-    for (cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    for (int i = 0; i < mNumIndexedPrefixes; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        if (mPrefixIndex[i].mHasRoute[0] == kInvalidOffset)
         {
             continue;
         }
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        prefix = &GetPrefix(mPrefixIndex[i]);
 
         if (prefix->GetDomainId() != aDomainId)
         {
@@ -398,20 +587,13 @@ ThreadError Leader::ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &a
         if (plen > rval_plen)
         {
             // select border router
-            for (cur = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs());
-                 cur < reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs() + prefix->GetSubTlvsLength());
-                 cur = cur->GetNext())
+            for (int j = 0; j < 2 && mPrefixIndex[i].mHasRoute[j] != kInvalidOffset; j++)
             {
-                if (cur->GetType() != NetworkDataTlv::kTypeHasRoute)
-                {
-                    continue;
-                }
+                hasRoute = reinterpret_cast<HasRouteTlv *>(mTlvs + mPrefixIndex[i].mHasRoute[j]);
 
-                hasRoute = reinterpret_cast<HasRouteTlv *>(cur);
-
-                for (int i = 0; i < hasRoute->GetNumEntries(); i++)
+                for (int k = 0; k < hasRoute->GetNumEntries(); k++)
                 {
-                    entry = hasRoute->GetEntry(i);
+                    entry = hasRoute->GetEntry(k);
 
                     if (rvalRoute == NULL ||
                         entry->GetPreference() > rvalRoute->GetPreference() ||
@@ -422,7 +604,6 @@ ThreadError Leader::ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &a
                         rval_plen = plen;
                     }
                 }
-
             }
         }
     }
@@ -445,27 +626,20 @@ ThreadError Leader::ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &a
     return error;
 }
 
-ThreadError Leader::DefaultRouteLookup(PrefixTlv &aPrefix, uint16_t *aRloc16)
+ThreadError Leader::DefaultRouteLookup(const PrefixIndexEntry &aEntry, uint16_t *aRloc16)
 {
     ThreadError error = kThreadError_NoRoute;
     BorderRouterTlv *borderRouter;
     BorderRouterEntry *entry;
     BorderRouterEntry *route = NULL;
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aPrefix.GetSubTlvs());
-         cur < reinterpret_cast<NetworkDataTlv *>(aPrefix.GetSubTlvs() + aPrefix.GetSubTlvsLength());
-         cur = cur->GetNext())
+    for (int i = 0; i < 2 && aEntry.mBorderRouter[i] != kInvalidOffset; i++)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypeBorderRouter)
-        {
-            continue;
-        }
+        borderRouter = reinterpret_cast<BorderRouterTlv *>(mTlvs + aEntry.mBorderRouter[i]);
 
-        borderRouter = reinterpret_cast<BorderRouterTlv *>(cur);
-
-        for (int i = 0; i < borderRouter->GetNumEntries(); i++)
+        for (int j = 0; j < borderRouter->GetNumEntries(); j++)
         {
-            entry = borderRouter->GetEntry(i);
+            entry = borderRouter->GetEntry(j);
 
             if (entry->IsDefaultRoute() == false)
             {
@@ -495,19 +669,116 @@ ThreadError Leader::DefaultRouteLookup(PrefixTlv &aPrefix, uint16_t *aRloc16)
     return error;
 }
 
+void Leader::UpdateIndex(void)
+{
+    NetworkDataTlv *cur;
+    NetworkDataTlv *end = reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
+    NetworkDataTlv *subCur;
+    NetworkDataTlv *subEnd;
+    PrefixTlv *prefix;
+    PrefixIndexEntry *entry;
+    uint8_t numBorderRouters;
+    uint8_t numHasRoutes;
+
+    mNumIndexedPrefixes = 0;
+
+    for (cur = reinterpret_cast<NetworkDataTlv *>(mTlvs); cur < end; cur = cur->GetNext())
+    {
+        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        {
+            continue;
+        }
+
+        if (mNumIndexedPrefixes >= kMaxIndexedPrefixes)
+        {
+            otLogWarnNetData("Network data index is full\n");
+            break;
+        }
+
+        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        entry = &mPrefixIndex[mNumIndexedPrefixes++];
+        memset(entry, kInvalidOffset, sizeof(*entry));
+        entry->mPrefix = static_cast<uint16_t>(reinterpret_cast<uint8_t *>(prefix) - mTlvs);
+        numBorderRouters = 0;
+        numHasRoutes = 0;
+
+        subCur = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs());
+        subEnd = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs() + prefix->GetSubTlvsLength());
+
+        for (; subCur < subEnd; subCur = subCur->GetNext())
+        {
+            uint16_t offset = static_cast<uint16_t>(reinterpret_cast<uint8_t *>(subCur) - mTlvs);
+
+            switch (subCur->GetType())
+            {
+            case NetworkDataTlv::kTypeBorderRouter:
+                if (numBorderRouters < 2)
+                {
+                    entry->mBorderRouter[numBorderRouters++] = offset;
+                }
+
+                break;
+
+            case NetworkDataTlv::kTypeHasRoute:
+                if (numHasRoutes < 2)
+                {
+                    entry->mHasRoute[numHasRoutes++] = offset;
+                }
+
+                break;
+
+            case NetworkDataTlv::kTypeContext:
+                if (entry->mContext == kInvalidOffset)
+                {
+                    entry->mContext = offset;
+                }
+
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+}
+
 void Leader::SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStable,
-                            const uint8_t *aData, uint8_t aDataLength)
+                            const uint8_t *aData, uint16_t aDataLength)
 {
-    mVersion = aVersion;
-    mStableVersion = aStableVersion;
     memcpy(mTlvs, aData, aDataLength);
     mLength = aDataLength;
+    UpdateNetworkData(aVersion, aStableVersion, aStable);
+}
+
+ThreadError Leader::SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStable,
+                                   const Message &aMessage, uint16_t aOffset, uint16_t aLength)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(aLength <= kMaxSize, error = kThreadError_Parse);
+
+    aMessage.Read(aOffset, aLength, mTlvs);
+    mLength = aLength;
+    UpdateNetworkData(aVersion, aStableVersion, aStable);
+
+exit:
+    return error;
+}
+
+void Leader::UpdateNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStable)
+{
+    mVersion = aVersion;
+    mStableVersion = aStableVersion;
 
     if (aStable)
     {
         RemoveTemporaryData(mTlvs, mLength);
     }
 
+    // stable-only Network Data cannot serve as the base of full Network Data edits
+    RecordDelta(!aStable);
+    UpdateIndex();
+
     otDumpDebgNetData("set network data", mTlvs, mLength);
 
     ConfigureAddresses();
@@ -516,9 +787,32 @@ void Leader::SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStab
 
 void Leader::RemoveBorderRouter(uint16_t aRloc16)
 {
+    uint8_t numEntries;
+    uint8_t numStableEntries;
+
+    // the removed device's queued registration is dropped, the others are applied before the removal
+    DiscardRegistration(aRloc16);
+    ApplyRegistrations();
+
+    numEntries = CountEntries(aRloc16, mTlvs, mLength, false);
+    numStableEntries = CountEntries(aRloc16, mTlvs, mLength, true);
+
+    VerifyOrExit(numEntries > 0, ;);
+
     RemoveRloc(aRloc16);
-    ConfigureAddresses();
-    mMle.HandleNetworkDataUpdate();
+    UpdateIndex();
+
+    mVersionPending = true;
+
+    if (numStableEntries > 0)
+    {
+        mStableVersionPending = true;
+    }
+
+    IncrementVersions();
+
+exit:
+    return;
 }
 
 void Leader::HandleServerData(void *aContext, Coap::Header &aHeader, Message &aMessage,
@@ -531,23 +825,27 @@ void Leader::HandleServerData(void *aContext, Coap::Header &aHeader, Message &aM
 void Leader::HandleServerData(Coap::Header &aHeader, Message &aMessage,
                               const Ip6::MessageInfo &aMessageInfo)
 {
-    uint8_t tlvsLength;
+    uint16_t tlvsLength;
     uint8_t tlvs[kMaxSize];
     uint16_t rloc16;
 
     otLogInfoNetData("Received network data registration\n");
 
     tlvsLength = aMessage.GetLength() - aMessage.GetOffset();
+    VerifyOrExit(tlvsLength <= sizeof(tlvs), ;);
 
     aMessage.Read(aMessage.GetOffset(), tlvsLength, tlvs);
     rloc16 = HostSwap16(aMessageInfo.mPeerAddr.m16[7]);
 
     SendServerDataResponse(aHeader, aMessageInfo, tlvs, tlvsLength);
     RegisterNetworkData(rloc16, tlvs, tlvsLength);
+
+exit:
+    return;
 }
 
 void Leader::SendServerDataResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
-                                    const uint8_t *aTlvs, uint8_t aTlvsLength)
+                                    const uint8_t *aTlvs, uint16_t aTlvsLength)
 {
     ThreadError error = kThreadError_None;
     Coap::Header responseHeader;
@@ -577,24 +875,326 @@ exit:
     }
 }
 
-ThreadError Leader::RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength)
+ThreadError Leader::RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength)
+{
+    ThreadError error = kThreadError_None;
+
+    // queued registrations are applied together with the version increment when the window expires
+    if (mCoalesceWindow > 0 && QueueRegistration(aRloc16, aTlvs, aTlvsLength) == kThreadError_None)
+    {
+        if (!mCoalesceTimer.IsRunning())
+        {
+            mCoalesceTimer.Start(mCoalesceWindow);
+        }
+
+        ExitNow();
+    }
+
+    ApplyRegistrations();
+    error = ApplyRegistration(aRloc16, aTlvs, aTlvsLength);
+    IncrementVersions();
+
+exit:
+    return error;
+}
+
+ThreadError Leader::QueueRegistration(uint16_t aRloc16, const uint8_t *aTlvs, uint16_t aTlvsLength)
+{
+    ThreadError error = kThreadError_None;
+    Message *message;
+
+    VerifyOrExit((message = Message::New(Message::kTypeIp6, 0)) != NULL, error = kThreadError_NoBufs);
+
+    if ((error = message->Append(&aRloc16, sizeof(aRloc16))) != kThreadError_None ||
+        (error = message->Append(aTlvs, aTlvsLength)) != kThreadError_None)
+    {
+        Message::Free(*message);
+        ExitNow();
+    }
+
+    // a later registration from the same device replaces the queued one
+    DiscardRegistration(aRloc16);
+    mRegistrationQueue.Enqueue(*message);
+
+exit:
+    return error;
+}
+
+void Leader::DiscardRegistration(uint16_t aRloc16)
+{
+    Message *next;
+    uint16_t rloc16;
+
+    for (Message *message = mRegistrationQueue.GetHead(); message; message = next)
+    {
+        next = message->GetNext();
+        message->Read(0, sizeof(rloc16), &rloc16);
+
+        if (rloc16 == aRloc16)
+        {
+            mRegistrationQueue.Dequeue(*message);
+            Message::Free(*message);
+        }
+    }
+}
+
+void Leader::ClearRegistrations(void)
+{
+    Message *message;
+
+    while ((message = mRegistrationQueue.GetHead()) != NULL)
+    {
+        mRegistrationQueue.Dequeue(*message);
+        Message::Free(*message);
+    }
+}
+
+void Leader::ApplyRegistrations(void)
+{
+    Message *message;
+    uint16_t tlvsLength;
+    uint16_t rloc16;
+
+    // a member buffer, since this runs below HandleServerData() which already holds a registration on the stack
+    while ((message = mRegistrationQueue.GetHead()) != NULL)
+    {
+        mRegistrationQueue.Dequeue(*message);
+        message->Read(0, sizeof(rloc16), &rloc16);
+        tlvsLength = message->Read(sizeof(rloc16), sizeof(mRegistrationTlvs), mRegistrationTlvs);
+        Message::Free(*message);
+
+        ApplyRegistration(rloc16, mRegistrationTlvs, tlvsLength);
+    }
+}
+
+ThreadError Leader::ApplyRegistration(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength)
 {
     ThreadError error = kThreadError_None;
+    bool stableChanged;
+
+    // re-registering identical content must not cause every device to fetch the Network Data again
+    if (IsRegistered(aRloc16, aTlvs, aTlvsLength, false))
+    {
+        otLogInfoNetData("Network data registration unchanged\n");
+        mSuppressedVersionBumps += 2;
+        ExitNow();
+    }
+
+    stableChanged = !IsRegistered(aRloc16, aTlvs, aTlvsLength, true);
 
     SuccessOrExit(error = RemoveRloc(aRloc16));
     SuccessOrExit(error = AddNetworkData(aTlvs, aTlvsLength));
+    UpdateIndex();
+
+    mRegistrations++;
+    mVersionPending = true;
+
+    if (stableChanged)
+    {
+        mStableVersionPending = true;
+    }
+
+exit:
+    return error;
+}
+
+void Leader::HandleCoalesceTimer(void *aContext)
+{
+    Leader *obj = reinterpret_cast<Leader *>(aContext);
+    obj->IncrementVersions();
+}
+
+void Leader::IncrementVersions(void)
+{
+    mCoalesceTimer.Stop();
+    ApplyRegistrations();
+
+    VerifyOrExit(mVersionPending, ;);
 
     mVersion++;
-    mStableVersion++;
+    mVersionBumps++;
+
+    if (mStableVersionPending)
+    {
+        mStableVersion++;
+    }
+    else
+    {
+        mSuppressedVersionBumps++;
+    }
+
+    mVersionPending = false;
+    mStableVersionPending = false;
 
+    RecordDelta(true);
     ConfigureAddresses();
     mMle.HandleNetworkDataUpdate();
 
 exit:
-    return error;
+    return;
+}
+
+bool Leader::IsRegistered(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength, bool aStable)
+{
+    // every entry being registered is already present and no other entries are held for aRloc16
+    return ContainsEntries(aTlvs, aTlvsLength, aStable) &&
+           CountEntries(aRloc16, mTlvs, mLength, aStable) == CountEntries(aRloc16, aTlvs, aTlvsLength, aStable);
+}
+
+bool Leader::ContainsEntries(uint8_t *aTlvs, uint16_t aTlvsLength, bool aStable)
+{
+    NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aTlvs);
+    NetworkDataTlv *end = reinterpret_cast<NetworkDataTlv *>(aTlvs + aTlvsLength);
+    NetworkDataTlv *subCur;
+    NetworkDataTlv *subEnd;
+    PrefixTlv *prefix;
+    PrefixTlv *dstPrefix;
+    HasRouteTlv *hasRoute;
+    HasRouteTlv *dstHasRoute;
+    BorderRouterTlv *borderRouter;
+    BorderRouterTlv *dstBorderRouter;
+    bool rval = false;
+    bool found;
+
+    for (; cur < end; cur = cur->GetNext())
+    {
+        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        {
+            continue;
+        }
+
+        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        dstPrefix = FindPrefix(prefix->GetPrefix(), prefix->GetPrefixLength());
+        subCur = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs());
+        subEnd = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs() + prefix->GetSubTlvsLength());
+
+        for (; subCur < subEnd; subCur = subCur->GetNext())
+        {
+            if (aStable && !subCur->IsStable())
+            {
+                continue;
+            }
+
+            switch (subCur->GetType())
+            {
+            case NetworkDataTlv::kTypeHasRoute:
+                hasRoute = reinterpret_cast<HasRouteTlv *>(subCur);
+                VerifyOrExit(dstPrefix != NULL &&
+                             (dstHasRoute = FindHasRoute(*dstPrefix, hasRoute->IsStable())) != NULL, ;);
+
+                for (int i = 0; i < hasRoute->GetNumEntries(); i++)
+                {
+                    found = false;
+
+                    for (int j = 0; j < dstHasRoute->GetNumEntries() && !found; j++)
+                    {
+                        found = memcmp(hasRoute->GetEntry(i), dstHasRoute->GetEntry(j), sizeof(HasRouteEntry)) == 0;
+                    }
+
+                    VerifyOrExit(found, ;);
+                }
+
+                break;
+
+            case NetworkDataTlv::kTypeBorderRouter:
+                borderRouter = reinterpret_cast<BorderRouterTlv *>(subCur);
+                VerifyOrExit(dstPrefix != NULL &&
+                             (dstBorderRouter = FindBorderRouter(*dstPrefix, borderRouter->IsStable())) != NULL, ;);
+
+                for (int i = 0; i < borderRouter->GetNumEntries(); i++)
+                {
+                    found = false;
+
+                    for (int j = 0; j < dstBorderRouter->GetNumEntries() && !found; j++)
+                    {
+                        found = memcmp(borderRouter->GetEntry(i), dstBorderRouter->GetEntry(j),
+                                       sizeof(BorderRouterEntry)) == 0;
+                    }
+
+                    VerifyOrExit(found, ;);
+                }
+
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
+uint8_t Leader::CountEntries(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength, bool aStable)
+{
+    NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aTlvs);
+    NetworkDataTlv *end = reinterpret_cast<NetworkDataTlv *>(aTlvs + aTlvsLength);
+    NetworkDataTlv *subCur;
+    NetworkDataTlv *subEnd;
+    PrefixTlv *prefix;
+    HasRouteTlv *hasRoute;
+    BorderRouterTlv *borderRouter;
+    uint8_t rval = 0;
+
+    for (; cur < end; cur = cur->GetNext())
+    {
+        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        {
+            continue;
+        }
+
+        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        subCur = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs());
+        subEnd = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs() + prefix->GetSubTlvsLength());
+
+        for (; subCur < subEnd; subCur = subCur->GetNext())
+        {
+            if (aStable && !subCur->IsStable())
+            {
+                continue;
+            }
+
+            switch (subCur->GetType())
+            {
+            case NetworkDataTlv::kTypeHasRoute:
+                hasRoute = reinterpret_cast<HasRouteTlv *>(subCur);
+
+                for (int i = 0; i < hasRoute->GetNumEntries(); i++)
+                {
+                    if (hasRoute->GetEntry(i)->GetRloc() == aRloc16)
+                    {
+                        rval++;
+                    }
+                }
+
+                break;
+
+            case NetworkDataTlv::kTypeBorderRouter:
+                borderRouter = reinterpret_cast<BorderRouterTlv *>(subCur);
+
+                for (int i = 0; i < borderRouter->GetNumEntries(); i++)
+                {
+                    if (borderRouter->GetEntry(i)->GetRloc() == aRloc16)
+                    {
+                        rval++;
+                    }
+                }
+
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    return rval;
 }
 
-ThreadError Leader::AddNetworkData(uint8_t *aTlvs, uint8_t aTlvsLength)
+ThreadError Leader::AddNetworkData(uint8_t *aTlvs, uint16_t aTlvsLength)
 {
     NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aTlvs);
     NetworkDataTlv *end = reinterpret_cast<NetworkDataTlv *>(aTlvs + aTlvsLength);
@@ -776,43 +1376,73 @@ exit:
 ThreadError Leader::FreeContext(uint8_t aContextId)
 {
     otLogInfoNetData("Free Context Id = %d\n", aContextId);
+    ApplyRegistrations();
     RemoveContext(aContextId);
+    UpdateIndex();
     mContextUsed &= ~(1 << aContextId);
-    mVersion++;
-    mStableVersion++;
-    mMle.HandleNetworkDataUpdate();
+    mVersionPending = true;
+    mStableVersionPending = true;
+    IncrementVersions();
     return kThreadError_None;
 }
 
 ThreadError Leader::RemoveRloc(uint16_t aRloc16)
 {
-    NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-    NetworkDataTlv *end;
+    uint8_t *cur = mTlvs;
+    uint8_t *end = mTlvs + mLength;
+    uint8_t *dst = mTlvs;
     PrefixTlv *prefix;
+    ContextTlv *context;
+    uint16_t length;
+    uint8_t headerLength;
+    uint8_t subTlvsLength;
 
-    while (1)
+    // kept TLVs are moved towards the front as they are visited, so each byte is moved at most once
+    while (cur < end)
     {
-        end = reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-
-        if (cur >= end)
-        {
-            break;
-        }
+        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        length = sizeof(NetworkDataTlv) + prefix->GetLength();
 
-        switch (cur->GetType())
+        switch (prefix->GetType())
         {
         case NetworkDataTlv::kTypePrefix:
         {
-            prefix = reinterpret_cast<PrefixTlv *>(cur);
-            RemoveRloc(*prefix, aRloc16);
+            headerLength = static_cast<uint8_t>(prefix->GetSubTlvs() - cur);
+            subTlvsLength = prefix->GetSubTlvsLength();
 
-            if (prefix->GetSubTlvsLength() == 0)
+            memmove(dst, cur, headerLength);
+            prefix = reinterpret_cast<PrefixTlv *>(dst);
+            subTlvsLength = RemoveRloc(cur + headerLength, subTlvsLength, aRloc16, dst + headerLength);
+            prefix->SetSubTlvsLength(subTlvsLength);
+
+            // remove prefix tlv if empty
+            if (subTlvsLength == 0)
             {
-                Remove(reinterpret_cast<uint8_t *>(prefix), sizeof(NetworkDataTlv) + prefix->GetLength());
-                continue;
+                break;
             }
 
-            otDumpDebgNetData("remove prefix done", mTlvs, mLength);
+            if ((context = FindContext(*prefix)) != NULL)
+            {
+                if (subTlvsLength == sizeof(ContextTlv))
+                {
+                    context->ClearCompress();
+                    mContextLastUsed[context->GetContextId() - kMinContextId] = Timer::GetNow();
+
+                    if (mContextLastUsed[context->GetContextId() - kMinContextId] == 0)
+                    {
+                        mContextLastUsed[context->GetContextId() - kMinContextId] = 1;
+                    }
+
+                    mTimer.Start(kStateUpdatePeriod);
+                }
+                else
+                {
+                    context->SetCompress();
+                    mContextLastUsed[context->GetContextId() - kMinContextId] = 0;
+                }
+            }
+
+            dst += sizeof(NetworkDataTlv) + prefix->GetLength();
             break;
         }
 
@@ -823,136 +1453,107 @@ ThreadError Leader::RemoveRloc(uint16_t aRloc16)
         }
         }
 
-        cur = cur->GetNext();
+        cur += length;
     }
 
+    mLength = static_cast<uint16_t>(dst - mTlvs);
+
     otDumpDebgNetData("remove done", mTlvs, mLength);
 
     return kThreadError_None;
 }
 
-ThreadError Leader::RemoveRloc(PrefixTlv &prefix, uint16_t aRloc16)
+uint8_t Leader::RemoveRloc(uint8_t *aSubTlvs, uint8_t aSubTlvsLength, uint16_t aRloc16, uint8_t *aDst)
 {
-    NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(prefix.GetSubTlvs());
-    NetworkDataTlv *end;
-    ContextTlv *context;
+    uint8_t *cur = aSubTlvs;
+    uint8_t *end = aSubTlvs + aSubTlvsLength;
+    uint8_t *dst = aDst;
+    uint8_t *entries;
+    NetworkDataTlv *tlv;
+    HasRouteTlv *hasRoute;
+    BorderRouterTlv *borderRouter;
+    uint16_t length;
+    uint8_t numEntries;
 
-    while (1)
+    while (cur < end)
     {
-        end = reinterpret_cast<NetworkDataTlv *>(prefix.GetSubTlvs() + prefix.GetSubTlvsLength());
-
-        if (cur >= end)
-        {
-            break;
-        }
+        tlv = reinterpret_cast<NetworkDataTlv *>(cur);
+        length = sizeof(NetworkDataTlv) + tlv->GetLength();
 
-        switch (cur->GetType())
+        switch (tlv->GetType())
         {
         case NetworkDataTlv::kTypeHasRoute:
-            RemoveRloc(prefix, *reinterpret_cast<HasRouteTlv *>(cur), aRloc16);
+        {
+            // remove rloc from has route tlv
+            hasRoute = reinterpret_cast<HasRouteTlv *>(cur);
+            numEntries = hasRoute->GetNumEntries();
+            memmove(dst, cur, sizeof(HasRouteTlv));
+            entries = dst + sizeof(HasRouteTlv);
 
-            // remove has route tlv if empty
-            if (cur->GetLength() == 0)
+            for (uint8_t i = 0; i < numEntries; i++)
             {
-                prefix.SetSubTlvsLength(prefix.GetSubTlvsLength() - sizeof(HasRouteTlv));
-                Remove(reinterpret_cast<uint8_t *>(cur), sizeof(HasRouteTlv));
-                continue;
-            }
-
-            break;
+                HasRouteEntry *entry = reinterpret_cast<HasRouteEntry *>(cur + sizeof(HasRouteTlv)) + i;
 
-        case NetworkDataTlv::kTypeBorderRouter:
-            RemoveRloc(prefix, *reinterpret_cast<BorderRouterTlv *>(cur), aRloc16);
+                if (entry->GetRloc() != aRloc16)
+                {
+                    memmove(entries, entry, sizeof(HasRouteEntry));
+                    entries += sizeof(HasRouteEntry);
+                }
+            }
 
-            // remove border router tlv if empty
-            if (cur->GetLength() == 0)
+            // remove has route tlv if empty
+            if (entries > dst + sizeof(HasRouteTlv))
             {
-                prefix.SetSubTlvsLength(prefix.GetSubTlvsLength() - sizeof(BorderRouterTlv));
-                Remove(reinterpret_cast<uint8_t *>(cur), sizeof(BorderRouterTlv));
-                continue;
+                reinterpret_cast<HasRouteTlv *>(dst)->SetLength(
+                    static_cast<uint8_t>(entries - dst - sizeof(HasRouteTlv)));
+                dst = entries;
             }
 
             break;
-
-        case NetworkDataTlv::kTypeContext:
-            break;
-
-        default:
-            assert(false);
-            break;
         }
 
-        cur = cur->GetNext();
-    }
-
-    if ((context = FindContext(prefix)) != NULL)
-    {
-        if (prefix.GetSubTlvsLength() == sizeof(ContextTlv))
+        case NetworkDataTlv::kTypeBorderRouter:
         {
-            context->ClearCompress();
-            mContextLastUsed[context->GetContextId() - kMinContextId] = Timer::GetNow();
+            // remove rloc from border router tlv
+            borderRouter = reinterpret_cast<BorderRouterTlv *>(cur);
+            numEntries = borderRouter->GetNumEntries();
+            memmove(dst, cur, sizeof(BorderRouterTlv));
+            entries = dst + sizeof(BorderRouterTlv);
 
-            if (mContextLastUsed[context->GetContextId() - kMinContextId] == 0)
+            for (uint8_t i = 0; i < numEntries; i++)
             {
-                mContextLastUsed[context->GetContextId() - kMinContextId] = 1;
-            }
-
-            mTimer.Start(kStateUpdatePeriod);
-        }
-        else
-        {
-            context->SetCompress();
-            mContextLastUsed[context->GetContextId() - kMinContextId] = 0;
-        }
-    }
+                BorderRouterEntry *entry = reinterpret_cast<BorderRouterEntry *>(cur + sizeof(BorderRouterTlv)) + i;
 
-    return kThreadError_None;
-}
-
-ThreadError Leader::RemoveRloc(PrefixTlv &aPrefix, HasRouteTlv &aHasRoute, uint16_t aRloc16)
-{
-    HasRouteEntry *entry;
+                if (entry->GetRloc() != aRloc16)
+                {
+                    memmove(entries, entry, sizeof(BorderRouterEntry));
+                    entries += sizeof(BorderRouterEntry);
+                }
+            }
 
-    // remove rloc from has route tlv
-    for (int i = 0; i < aHasRoute.GetNumEntries(); i++)
-    {
-        entry = aHasRoute.GetEntry(i);
+            // remove border router tlv if empty
+            if (entries > dst + sizeof(BorderRouterTlv))
+            {
+                reinterpret_cast<BorderRouterTlv *>(dst)->SetLength(
+                    static_cast<uint8_t>(entries - dst - sizeof(BorderRouterTlv)));
+                dst = entries;
+            }
 
-        if (entry->GetRloc() != aRloc16)
-        {
-            continue;
+            break;
         }
 
-        aHasRoute.SetLength(aHasRoute.GetLength() - sizeof(HasRouteEntry));
-        aPrefix.SetSubTlvsLength(aPrefix.GetSubTlvsLength() - sizeof(HasRouteEntry));
-        Remove(reinterpret_cast<uint8_t *>(entry), sizeof(*entry));
-        break;
-    }
-
-    return kThreadError_None;
-}
-
-ThreadError Leader::RemoveRloc(PrefixTlv &aPrefix, BorderRouterTlv &aBorderRouter, uint16_t aRloc16)
-{
-    BorderRouterEntry *entry;
-
-    // remove rloc from border router tlv
-    for (int i = 0; i < aBorderRouter.GetNumEntries(); i++)
-    {
-        entry = aBorderRouter.GetEntry(i);
-
-        if (entry->GetRloc() != aRloc16)
+        default:
         {
-            continue;
+            memmove(dst, cur, length);
+            dst += length;
+            break;
+        }
         }
 
-        aBorderRouter.SetLength(aBorderRouter.GetLength() - sizeof(BorderRouterEntry));
-        aPrefix.SetSubTlvsLength(aPrefix.GetSubTlvsLength() - sizeof(BorderRouterEntry));
-        Remove(reinterpret_cast<uint8_t *>(entry), sizeof(*entry));
-        break;
+        cur += length;
     }
 
-    return kThreadError_None;
+    return static_cast<uint8_t>(dst - aDst);
 }
 
 ThreadError Leader::RemoveContext(uint8_t aContextId)
@@ -65,6 +65,11 @@ namespace NetworkData {
 class Leader: public NetworkData
 {
 public:
+    enum
+    {
+        kDeltaHistory = OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY,  ///< Number of retained Network Data edits.
+    };
+
     /**
      * This constructor initializes the object.
      *
@@ -107,6 +112,100 @@ public:
      */
     uint8_t GetStableVersion(void) const;
 
+    /**
+     * This method returns a pointer to the full Thread Network Data.
+     *
+     * @param[out]  aDataLength  The length of the Thread Network Data in bytes.
+     *
+     * @returns A pointer to the Thread Network Data.
+     *
+     */
+    const uint8_t *GetTlvs(uint16_t &aDataLength) const;
+
+    /**
+     * This method returns a pointer to the stable Thread Network Data.
+     *
+     * The stable subset is kept pre-filtered and only regenerated after the stable version changes.
+     *
+     * @param[out]  aDataLength  The length of the stable Thread Network Data in bytes.
+     *
+     * @returns A pointer to the stable Thread Network Data.
+     *
+     */
+    const uint8_t *GetStableTlvs(uint16_t &aDataLength);
+
+    /**
+     * This method writes the edits that bring the full Thread Network Data from a given version to the current one.
+     *
+     * @param[in]     aVersion       The Network Data version held by the receiver.
+     * @param[out]    aDeltas        A pointer to a buffer for the edits.
+     * @param[inout]  aDeltasLength  On entry, the size of @p aDeltas in bytes.  On exit, the number of bytes written.
+     *
+     * @retval kThreadError_None      Successfully wrote the edits.
+     * @retval kThreadError_Error     The edits from @p aVersion are not retained.
+     * @retval kThreadError_NoBufs    The edits do not fit in @p aDeltas.
+     *
+     */
+    ThreadError GetDeltas(uint8_t aVersion, uint8_t *aDeltas, uint8_t &aDeltasLength) const;
+
+    /**
+     * This method is used by non-Leader devices to apply edits received from a neighbor to the full Network Data.
+     *
+     * @param[in]  aVersion        The Version value.
+     * @param[in]  aStableVersion  The Stable Version value.
+     * @param[in]  aDeltas         A pointer to the edits.
+     * @param[in]  aDeltasLength   The length of the edits in bytes.
+     *
+     * @retval kThreadError_None      Successfully applied the edits.
+     * @retval kThreadError_Error     The edits do not start from the current version or do not reach @p aVersion.
+     * @retval kThreadError_Parse     The edits are malformed or do not reproduce the Leader's Network Data.
+     *
+     */
+    ThreadError ApplyDeltas(uint8_t aVersion, uint8_t aStableVersion, const uint8_t *aDeltas, uint8_t aDeltasLength);
+
+    /**
+     * This method returns the number of version increments skipped because a registration left the corresponding
+     * (full or stable) Thread Network Data unchanged.
+     *
+     * @returns The number of suppressed version increments.
+     *
+     */
+    uint32_t GetSuppressedVersionBumps(void) const { return mSuppressedVersionBumps; }
+
+    /**
+     * This method returns the number of Server Data registrations that changed the Thread Network Data.
+     *
+     * @returns The number of applied registrations.
+     *
+     */
+    uint32_t GetRegistrations(void) const { return mRegistrations; }
+
+    /**
+     * This method returns the number of times the Thread Network Data version was incremented.
+     *
+     * @returns The number of version increments.
+     *
+     */
+    uint32_t GetVersionBumps(void) const { return mVersionBumps; }
+
+    /**
+     * This method returns the Server Data registration coalescing window.
+     *
+     * @returns The coalescing window in milliseconds.
+     *
+     */
+    uint32_t GetCoalesceWindow(void) const { return mCoalesceWindow; }
+
+    /**
+     * This method sets the Server Data registration coalescing window.
+     *
+     * Registrations received within the window are applied together with a single version increment.
+     *
+     * @param[in]  aWindow  The coalescing window in milliseconds (0 applies each registration immediately).
+     *
+     */
+    void SetCoalesceWindow(uint32_t aWindow);
+
     /**
      * This method returns CONTEXT_ID_RESUSE_DELAY value.
      *
@@ -186,7 +285,24 @@ public:
      *
      */
     void SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStableOnly, const uint8_t *aData,
-                        uint8_t aDataLength);
+                        uint16_t aDataLength);
+
+    /**
+     * This method is used by non-Leader devices to set newly received Network Data from the Leader.
+     *
+     * @param[in]  aVersion        The Version value.
+     * @param[in]  aStableVersion  The Stable Version value.
+     * @param[in]  aStableOnly     TRUE if storing only the stable data, FALSE otherwise.
+     * @param[in]  aMessage        A reference to the message containing the Network Data.
+     * @param[in]  aOffset         The offset of the Network Data in @p aMessage.
+     * @param[in]  aLength         The length of the Network Data in bytes.
+     *
+     * @retval kThreadError_None   Successfully set the Network Data.
+     * @retval kThreadError_Parse  The Network Data is larger than the Network Data capacity.
+     *
+     */
+    ThreadError SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStableOnly, const Message &aMessage,
+                               uint16_t aOffset, uint16_t aLength);
 
     /**
      * This method removes Network Data associated with a given RLOC16.
@@ -201,16 +317,77 @@ private:
                                  const Ip6::MessageInfo &aMessageInfo);
     void HandleServerData(Coap::Header &aHeader, Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     void SendServerDataResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
-                                const uint8_t *aTlvs, uint8_t aTlvsLength);
+                                const uint8_t *aTlvs, uint16_t aTlvsLength);
 
     static void HandleTimer(void *aContext);
     void HandleTimer(void);
 
-    ThreadError RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength);
+    static void HandleCoalesceTimer(void *aContext);
+    void IncrementVersions(void);
+
+    enum
+    {
+        kInvalidOffset = 0xffff,
+
+        // the smallest useful Prefix TLV carries a single Has Route entry
+        kMaxIndexedPrefixes = kMaxSize / (sizeof(PrefixTlv) + sizeof(HasRouteTlv) + sizeof(HasRouteEntry)),
+    };
+
+    /**
+     * This structure locates the sub-TLVs of a Prefix TLV within the Network Data.
+     *
+     */
+    struct PrefixIndexEntry
+    {
+        uint16_t mPrefix;           ///< Offset of the Prefix TLV.
+        uint16_t mBorderRouter[2];  ///< Offsets of the Border Router TLVs, or kInvalidOffset.
+        uint16_t mHasRoute[2];      ///< Offsets of the Has Route TLVs, or kInvalidOffset.
+        uint16_t mContext;          ///< Offset of the Context TLV, or kInvalidOffset.
+    };
+
+    enum
+    {
+        kMaxDeltaLength     = OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_MAX_LENGTH,
+        kDeltaHeaderSize    = sizeof(uint8_t) + sizeof(uint16_t),  ///< Base version and checksum.
+        kDeltaEditSize      = 6,                                   ///< Version, offset, remove and insert lengths.
+    };
+
+    /**
+     * This structure represents the change between two consecutive Network Data versions as a single replaced range.
+     *
+     */
+    struct Delta
+    {
+        uint8_t mFromVersion;              ///< The version the edit applies to.
+        uint8_t mVersion;                  ///< The version resulting from the edit.
+        uint16_t mOffset;                  ///< Offset of the replaced range.
+        uint16_t mRemoveLength;            ///< Number of bytes removed at mOffset.
+        uint8_t mInsertLength;             ///< Number of bytes inserted at mOffset.
+        uint8_t mInsert[kMaxDeltaLength];  ///< The inserted bytes.
+    };
+
+    void UpdateNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStableOnly);
+    void RecordDelta(bool aRetain);
+    static uint16_t ComputeChecksum(const uint8_t *aData, uint16_t aDataLength);
+
+    void UpdateIndex(void);
+    PrefixTlv &GetPrefix(const PrefixIndexEntry &aEntry) {
+        return *reinterpret_cast<PrefixTlv *>(mTlvs + aEntry.mPrefix);
+    }
+
+    ThreadError RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength);
+    ThreadError QueueRegistration(uint16_t aRloc16, const uint8_t *aTlvs, uint16_t aTlvsLength);
+    void DiscardRegistration(uint16_t aRloc16);
+    void ClearRegistrations(void);
+    void ApplyRegistrations(void);
+    ThreadError ApplyRegistration(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength);
+    bool IsRegistered(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength, bool aStable);
+    bool ContainsEntries(uint8_t *aTlvs, uint16_t aTlvsLength, bool aStable);
+    static uint8_t CountEntries(uint16_t aRloc16, uint8_t *aTlvs, uint16_t aTlvsLength, bool aStable);
 
     ThreadError AddHasRoute(PrefixTlv &aPrefix, HasRouteTlv &aHasRoute);
     ThreadError AddBorderRouter(PrefixTlv &aPrefix, BorderRouterTlv &aBorderRouter);
-    ThreadError AddNetworkData(uint8_t *aTlv, uint8_t aTlvLength);
+    ThreadError AddNetworkData(uint8_t *aTlv, uint16_t aTlvLength);
     ThreadError AddPrefix(PrefixTlv &aTlv);
 
     int AllocateContext(void);
@@ -223,13 +400,11 @@ private:
     ThreadError RemoveContext(PrefixTlv &aPrefix, uint8_t aContextId);
 
     ThreadError RemoveRloc(uint16_t aRloc16);
-    ThreadError RemoveRloc(PrefixTlv &aPrefix, uint16_t aRloc16);
-    ThreadError RemoveRloc(PrefixTlv &aPrefix, HasRouteTlv &aHasRoute, uint16_t aRloc16);
-    ThreadError RemoveRloc(PrefixTlv &aPrefix, BorderRouterTlv &aBorderRouter, uint16_t aRloc16);
+    uint8_t RemoveRloc(uint8_t *aSubTlvs, uint8_t aSubTlvsLength, uint16_t aRloc16, uint8_t *aDst);
 
     ThreadError ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &destination,
                                     uint8_t *aPrefixMatch, uint16_t *aRloc16);
-    ThreadError DefaultRouteLookup(PrefixTlv &aPrefix, uint16_t *aRloc16);
+    ThreadError DefaultRouteLookup(const PrefixIndexEntry &aEntry, uint16_t *aRloc16);
 
     /**
      * Thread Specification Constants
@@ -246,12 +421,38 @@ private:
     uint32_t mContextLastUsed[kNumContextIds];
     uint32_t mContextIdReuseDelay;
     Timer mTimer;
+    Timer mCoalesceTimer;
+    uint32_t mCoalesceWindow;
+    MessageQueue mRegistrationQueue;
+    uint8_t mRegistrationTlvs[kMaxSize];
+    bool mVersionPending;
+    bool mStableVersionPending;
 
     Ip6::NetifUnicastAddress mAddresses[4];
 
+    PrefixIndexEntry mPrefixIndex[kMaxIndexedPrefixes];
+    uint8_t mNumIndexedPrefixes;
+
+#if OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+    Delta mDeltas[kDeltaHistory];
+    uint8_t mDeltaStart;
+    uint8_t mNumDeltas;
+    uint8_t mDeltaBase[kMaxSize];
+    uint16_t mDeltaBaseLength;
+    uint8_t mDeltaBaseVersion;
+#endif  // OPENTHREAD_CONFIG_NETWORK_DATA_DELTA_HISTORY > 0
+
+    uint8_t mStableTlvs[kMaxSize];
+    uint16_t mStableLength;
+    uint8_t mStableTlvsVersion;
+    bool mStableTlvsValid;
+
     Coap::Resource  mServerData;
     uint8_t         mStableVersion;
     uint8_t         mVersion;
+    uint32_t        mSuppressedVersionBumps;
+    uint32_t        mRegistrations;
+    uint32_t        mVersionBumps;
 
     Coap::Server   &mCoapServer;
     Ip6::Netif     &mNetif;
@@ -37,31 +37,49 @@
 
 namespace Thread {
 
-ThreadError ThreadTlv::GetTlv(const Message &message, Type type, uint16_t maxLength, ThreadTlv &tlv)
+ThreadError ThreadTlv::GetTlv(const Message &aMessage, Type aType, uint16_t aMaxLength, ThreadTlv &aTlv)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset = message.GetOffset();
-    uint16_t end = message.GetLength();
+    ThreadError error;
+    uint16_t offset;
+    uint16_t valueOffset;
+    uint16_t length;
 
-    while (offset < end)
-    {
-        message.Read(offset, sizeof(ThreadTlv), &tlv);
+    SuccessOrExit(error = TlvIndex::Find(aMessage, aType, offset, valueOffset, length));
+    error = Read(aMessage, offset, valueOffset, length, aMaxLength, aTlv);
+
+exit:
+    return error;
+}
+
+ThreadError ThreadTlv::GetTlv(const TlvIndex &aIndex, Type aType, uint16_t aMaxLength, ThreadTlv &aTlv)
+{
+    ThreadError error;
+    uint16_t offset;
+    uint16_t valueOffset;
+    uint16_t length;
 
-        if (tlv.GetType() == type && (offset + sizeof(tlv) + tlv.GetLength()) <= end)
-        {
-            if (maxLength > sizeof(tlv) + tlv.GetLength())
-            {
-                maxLength = sizeof(tlv) + tlv.GetLength();
-            }
+    SuccessOrExit(error = aIndex.Find(aType, offset, valueOffset, length));
+    error = Read(aIndex.GetMessage(), offset, valueOffset, length, aMaxLength, aTlv);
 
-            message.Read(offset, maxLength, &tlv);
+exit:
+    return error;
+}
 
-            ExitNow(error = kThreadError_None);
-        }
+ThreadError ThreadTlv::Read(const Message &aMessage, uint16_t aOffset, uint16_t aValueOffset, uint16_t aLength,
+                            uint16_t aMaxLength, ThreadTlv &aTlv)
+{
+    ThreadError error = kThreadError_None;
 
-        offset += sizeof(tlv) + tlv.GetLength();
+    // extended TLVs do not fit the fixed-size TLV classes
+    VerifyOrExit(aValueOffset == aOffset + sizeof(aTlv), error = kThreadError_Parse);
+
+    if (aMaxLength > sizeof(aTlv) + aLength)
+    {
+        aMaxLength = sizeof(aTlv) + aLength;
     }
 
+    aMessage.Read(aOffset, aMaxLength, &aTlv);
+
 exit:
     return error;
 }
@@ -37,6 +37,7 @@
 #include <openthread-types.h>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/tlv_index.hpp>
 #include <net/ip6_address.hpp>
 #include <thread/mle.hpp>
 
@@ -116,7 +117,24 @@ public:
      */
     static ThreadError GetTlv(const Message &aMessage, Type aType, uint16_t aMaxLength, ThreadTlv &aTlv);
 
+    /**
+     * This static method reads the requested TLV using a TLV index of the message.
+     *
+     * @param[in]   aIndex      A reference to the TLV index.
+     * @param[in]   aType       The Type value to search for.
+     * @param[in]   aMaxLength  Maximum number of bytes to read.
+     * @param[out]  aTlv        A reference to the TLV that will be copied to.
+     *
+     * @retval kThreadError_None   Successfully copied the TLV.
+     * @retval kThreadError_Parse  Could not find the TLV with Type @p aType.
+     *
+     */
+    static ThreadError GetTlv(const TlvIndex &aIndex, Type aType, uint16_t aMaxLength, ThreadTlv &aTlv);
+
 private:
+    static ThreadError Read(const Message &aMessage, uint16_t aOffset, uint16_t aValueOffset, uint16_t aLength,
+                            uint16_t aMaxLength, ThreadTlv &aTlv);
+
     uint8_t mType;
     uint8_t mLength;
 } __attribute__((packed));
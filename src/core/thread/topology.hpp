@@ -34,9 +34,12 @@
 #ifndef TOPOLOGY_HPP_
 #define TOPOLOGY_HPP_
 
+#include <string.h>
+
 #include <openthread-core-config.h>
 #include <mac/mac_frame.hpp>
 #include <net/ip6.hpp>
+#include <thread/link_quality.hpp>
 #include <thread/mle_tlvs.hpp>
 
 namespace Thread {
@@ -82,6 +85,7 @@ public:
     bool    mPreviousKey : 1;            ///< Indicates whether or not the neighbor is still using a previous key
     bool    mDataRequest : 1;            ///< Indicates whether or not a Data Poll was received
     int8_t  mRssi;                       ///< Received Signal Strengh Indicator
+    LinkQualityInfo mLinkInfo;           ///< Link quality estimate
 };
 
 /**
@@ -94,12 +98,66 @@ public:
     enum
     {
         kMaxIp6AddressPerChild = OPENTHREAD_CONFIG_IP_ADDRS_PER_CHILD,
+        kPrefixEntryId         = 0xfd,  ///< Marks an entry holding the prefix of the following full address entry
+        kFullAddressPrefixId   = 0xfe,  ///< Marks a full address entry, its prefix is held in the preceding entry
+        kInvalidPrefixId       = 0xff,  ///< Marks an unused registered address entry
     };
-    Ip6::Address mIp6Address[kMaxIp6AddressPerChild];  ///< Registered IPv6 addresses
-    uint32_t     mTimeout;                             ///< Child timeout
-    uint16_t     mFragmentOffset;                      ///< 6LoWPAN fragment offset
-    uint8_t      mRequestTlvs[4];                      ///< Requested MLE TLVs
-    uint8_t      mNetworkDataVersion;                  ///< Current Network Data version
+
+    /**
+     * This method indicates whether or not a registered address entry matches an IPv6 address.
+     *
+     * @param[in]  aIndex     The index of the registered address entry.
+     * @param[in]  aPrefixId  The identifier of the address prefix, as assigned by the parent router.
+     * @param[in]  aAddress   A reference to the IPv6 address.
+     *
+     * @retval TRUE   If the entry holds @p aAddress.
+     * @retval FALSE  If the entry does not hold @p aAddress.
+     *
+     */
+    bool MatchesIp6Address(uint8_t aIndex, uint8_t aPrefixId, const Ip6::Address &aAddress) const {
+        if (memcmp(mIp6Iid[aIndex], aAddress.GetIid(), sizeof(mIp6Iid[aIndex])) != 0)
+        {
+            return false;
+        }
+
+        if (mIp6PrefixId[aIndex] == kFullAddressPrefixId)
+        {
+            return memcmp(mIp6Iid[aIndex - 1], aAddress.m8, sizeof(mIp6Iid[aIndex - 1])) == 0;
+        }
+
+        return aPrefixId != kInvalidPrefixId && mIp6PrefixId[aIndex] == aPrefixId;
+    }
+
+    /**
+     * This method returns the index of a registered IPv6 address.
+     *
+     * @param[in]  aPrefixId  The identifier of the address prefix, as assigned by the parent router.
+     * @param[in]  aAddress   A reference to the IPv6 address.
+     *
+     * @returns The index of the matching registered address, or kMaxIp6AddressPerChild if there is none.
+     *
+     */
+    uint8_t FindIp6Address(uint8_t aPrefixId, const Ip6::Address &aAddress) const {
+        uint8_t i;
+
+        for (i = 0; i < kMaxIp6AddressPerChild; i++)
+        {
+            if (MatchesIp6Address(i, aPrefixId, aAddress))
+            {
+                break;
+            }
+        }
+
+        return i;
+    }
+
+    uint32_t mTimeout;                                  ///< Child timeout
+    uint16_t mFragmentOffset;                           ///< 6LoWPAN fragment offset
+    uint16_t mHashNext;                                 ///< Next child in the same extended address hash bucket
+    uint8_t  mIp6Iid[kMaxIp6AddressPerChild][Ip6::Address::kInterfaceIdentifierSize];  ///< Registered IPv6 IIDs
+    uint8_t  mIp6PrefixId[kMaxIp6AddressPerChild];     ///< Prefix identifier of each registered IPv6 address
+    uint16_t mIp6HashNext[kMaxIp6AddressPerChild];     ///< Next registered address in the same address hash bucket
+    uint8_t  mNetworkDataVersion;                       ///< Current Network Data version
 };
 
 /**
@@ -0,0 +1,114 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, Nest Labs, Inc.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+
+import time
+import unittest
+
+import node
+
+LEADER = 1
+ROUTER1 = 2
+ROUTER2 = 3
+ROUTER3 = 4
+
+NUM_PINGS = 20
+MPL_TIMER_EXPIRATIONS = 3
+
+class Test_Mpl(unittest.TestCase):
+    def setUp(self):
+        self.nodes = {}
+        for i in range(1,5):
+            self.nodes[i] = node.Node(i)
+
+        self.nodes[LEADER].set_panid(0xface)
+        self.nodes[LEADER].set_mode('rsdn')
+        self.nodes[LEADER].add_whitelist(self.nodes[ROUTER1].get_addr64())
+        self.nodes[LEADER].enable_whitelist()
+
+        self.nodes[ROUTER1].set_panid(0xface)
+        self.nodes[ROUTER1].set_mode('rsdn')
+        self.nodes[ROUTER1].add_whitelist(self.nodes[LEADER].get_addr64())
+        self.nodes[ROUTER1].add_whitelist(self.nodes[ROUTER2].get_addr64())
+        self.nodes[ROUTER1].enable_whitelist()
+
+        self.nodes[ROUTER2].set_panid(0xface)
+        self.nodes[ROUTER2].set_mode('rsdn')
+        self.nodes[ROUTER2].add_whitelist(self.nodes[ROUTER1].get_addr64())
+        self.nodes[ROUTER2].add_whitelist(self.nodes[ROUTER3].get_addr64())
+        self.nodes[ROUTER2].enable_whitelist()
+
+        self.nodes[ROUTER3].set_panid(0xface)
+        self.nodes[ROUTER3].set_mode('rsdn')
+        self.nodes[ROUTER3].add_whitelist(self.nodes[ROUTER2].get_addr64())
+        self.nodes[ROUTER3].enable_whitelist()
+
+    def tearDown(self):
+        for node in self.nodes.itervalues():
+            node.stop()
+        del self.nodes
+
+    def test(self):
+        self.nodes[LEADER].start()
+        self.nodes[LEADER].set_state('leader')
+        self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
+
+        for i in range(ROUTER1, ROUTER3 + 1):
+            self.nodes[i].start()
+            time.sleep(3)
+            self.assertEqual(self.nodes[i].get_state(), 'router')
+
+        # allow routes to the far end of the chain to converge
+        time.sleep(10)
+
+        before = {}
+        for i in range(LEADER, ROUTER3 + 1):
+            before[i] = self.nodes[i].get_mpl_counters()
+
+        # send realm-local pings without waiting for the echo replies, so that delivery is measured by MPL alone
+        for i in range(NUM_PINGS):
+            self.nodes[LEADER].ping('ff03::1', num_responses=0)
+            time.sleep(1)
+
+        # let the trickle retransmissions of the last datagram run out
+        time.sleep(5)
+
+        retransmissions = 0
+        for i in range(LEADER, ROUTER3 + 1):
+            after = self.nodes[i].get_mpl_counters()
+            retransmissions += after['Retransmissions'] - before[i]['Retransmissions']
+
+            # every datagram reaches every router across the three-hop chain exactly once
+            if i != LEADER:
+                self.assertEqual(after['Received'] - before[i]['Received'], NUM_PINGS)
+
+        # the forwarders retransmit each datagram, but no more than the remaining trickle intervals allow
+        self.assertTrue(retransmissions > 0)
+        self.assertTrue(retransmissions <= NUM_PINGS * (ROUTER3 - LEADER + 1) * (MPL_TIMER_EXPIRATIONS - 1))
+
+if __name__ == '__main__':
+    unittest.main()
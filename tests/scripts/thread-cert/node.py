@@ -58,6 +58,12 @@ class Node:
         else:
             cmd = './soc'
         cmd += ' --nodeid=%d -S' % nodeid
+
+        # start from factory settings, a previous test may have left network information behind
+        settings = 'tmp/%d.settings' % nodeid
+        if os.path.exists(settings):
+            os.remove(settings)
+
         print cmd
 
         self.pexpect = pexpect.spawn(cmd, timeout=2)
@@ -302,6 +308,15 @@ class Node:
 
         return results
 
+    def get_mpl_counters(self):
+        self.send_command('mplcounters')
+        counters = {}
+        for name in ['Received', 'Retransmissions', 'Duplicate Drops', 'Seed Set Evictions']:
+            self.pexpect.expect(name + ': (\d+)')
+            counters[name] = int(self.pexpect.match.groups()[0])
+        self.pexpect.expect('Done')
+        return counters
+
     def ping(self, ipaddr, num_responses=1, size=None):
         cmd = 'ping ' + ipaddr
         if size != None:
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "test_util.h"
+#include <openthread.h>
+#include <thread/link_quality.hpp>
+
+void TestLinkQualityFirstSample(void)
+{
+    Thread::LinkQualityInfo info;
+
+    info.Clear();
+    VerifyOrQuit(info.GetLinkMarginSamples() == 0 && info.GetLinkQuality() == 0,
+                 "LinkQualityInfo::Clear failed\n");
+
+    info.AddLinkMargin(15);
+    VerifyOrQuit(info.GetAverageLinkMargin() == 15, "LinkQualityInfo::AddLinkMargin average failed\n");
+    VerifyOrQuit(info.GetLinkQuality() == 2, "LinkQualityInfo::AddLinkMargin did not use first sample\n");
+    VerifyOrQuit(info.GetLinkMarginSamples() == 1, "LinkQualityInfo::GetLinkMarginSamples failed\n");
+
+    info.Clear();
+    info.AddRss(-120);
+    VerifyOrQuit(info.GetAverageLinkMargin() == 0 && info.GetLinkQuality() == 0,
+                 "LinkQualityInfo::AddRss below noise floor failed\n");
+
+    info.Clear();
+    info.AddRss(-70);
+    VerifyOrQuit(info.GetAverageLinkMargin() == 30 && info.GetLinkQuality() == 3,
+                 "LinkQualityInfo::AddRss failed\n");
+}
+
+void TestLinkQualitySmoothing(void)
+{
+    Thread::LinkQualityInfo info;
+
+    info.Clear();
+    info.AddLinkMargin(25);
+
+    // a single weak frame does not change the link quality
+    info.AddLinkMargin(0);
+    VerifyOrQuit(info.GetLinkQuality() == 3, "LinkQualityInfo changed quality on a single sample\n");
+
+    for (int i = 0; i < 4; i++)
+    {
+        info.AddLinkMargin(25);
+    }
+
+    // a sustained drop does
+    for (int i = 0; i < 32; i++)
+    {
+        info.AddLinkMargin(15);
+    }
+
+    VerifyOrQuit(info.GetAverageLinkMargin() == 15, "LinkQualityInfo average did not converge\n");
+    VerifyOrQuit(info.GetLinkQuality() == 2, "LinkQualityInfo did not follow sustained drop\n");
+    VerifyOrQuit(info.GetLinkMarginSamples() == 38, "LinkQualityInfo::GetLinkMarginSamples failed\n");
+}
+
+void TestLinkQualityHysteresis(void)
+{
+    Thread::LinkQualityInfo info;
+
+    info.Clear();
+    info.AddLinkMargin(19);
+    VerifyOrQuit(info.GetLinkQuality() == 2, "LinkQualityInfo::AddLinkMargin failed\n");
+
+    // margins just above the threshold do not upgrade the link
+    for (int i = 0; i < 64; i++)
+    {
+        info.AddLinkMargin((i & 1) ? 21 : 22);
+    }
+
+    VerifyOrQuit(info.GetLinkQuality() == 2, "LinkQualityInfo upgraded within hysteresis\n");
+
+    for (int i = 0; i < 64; i++)
+    {
+        info.AddLinkMargin(24);
+    }
+
+    VerifyOrQuit(info.GetLinkQuality() == 3, "LinkQualityInfo did not upgrade\n");
+
+    // margins just below the threshold do not downgrade the link
+    for (int i = 0; i < 64; i++)
+    {
+        info.AddLinkMargin((i & 1) ? 19 : 20);
+    }
+
+    VerifyOrQuit(info.GetLinkQuality() == 3, "LinkQualityInfo downgraded within hysteresis\n");
+
+    for (int i = 0; i < 64; i++)
+    {
+        info.AddLinkMargin(17);
+    }
+
+    VerifyOrQuit(info.GetLinkQuality() == 2, "LinkQualityInfo did not downgrade\n");
+}
+
+void TestLinkQualityTxFailures(void)
+{
+    Thread::LinkQualityInfo info;
+
+    info.Clear();
+    info.AddLinkMargin(30);
+
+    for (int i = 0; i < 8; i++)
+    {
+        info.AddTxResult(true);
+    }
+
+    VerifyOrQuit(info.GetTxFailureRate() == 0 && info.GetLinkQuality() == 3,
+                 "LinkQualityInfo::AddTxResult failed\n");
+
+    for (int i = 0; i < 64; i++)
+    {
+        info.AddTxResult(false);
+        info.AddLinkMargin(30);
+    }
+
+    VerifyOrQuit(info.GetTxAttempts() == 72 && info.GetTxFailures() == 64,
+                 "LinkQualityInfo tx counters failed\n");
+    VerifyOrQuit(info.GetTxFailureRate() > 0xf000, "LinkQualityInfo::GetTxFailureRate failed\n");
+    VerifyOrQuit(info.GetAverageLinkMargin() == 30, "LinkQualityInfo tx failures changed the average margin\n");
+    VerifyOrQuit(info.GetLinkQuality() == 0, "LinkQualityInfo did not degrade on tx failures\n");
+
+    for (int i = 0; i < 64; i++)
+    {
+        info.AddTxResult(true);
+    }
+
+    VerifyOrQuit(info.GetLinkQuality() == 3, "LinkQualityInfo did not recover from tx failures\n");
+}
+
+int main(void)
+{
+    TestLinkQualityFirstSample();
+    TestLinkQualitySmoothing();
+    TestLinkQualityHysteresis();
+    TestLinkQualityTxFailures();
+    printf("All tests passed\n");
+    return 0;
+}
@@ -30,12 +30,19 @@
 #include <openthread.h>
 #include <common/debug.hpp>
 #include <common/message.hpp>
+#include <openthread-core-config.h>
+#include <platform/random.h>
 #include <string.h>
 
 extern"C" void otSignalTaskletPending(void)
 {
 }
 
+extern"C" uint32_t otPlatRandomGet(void)
+{
+    return random();
+}
+
 void TestMessage(void)
 {
     Thread::Message *message;
@@ -65,9 +72,89 @@ void TestMessage(void)
                   "Message::Free failed\n");
 }
 
+void TestMessageChildMask(void)
+{
+    Thread::Message *messages[OPENTHREAD_CONFIG_NUM_CHILD_MASKS + 1];
+    Thread::Message *message;
+
+    Thread::Message::Init();
+
+    VerifyOrQuit((message = Thread::Message::New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+    VerifyOrQuit(!message->IsChildPending(), "Message::IsChildPending failed\n");
+
+    // a single child
+    SuccessOrQuit(message->SetChildMask(1), "Message::SetChildMask failed\n");
+    VerifyOrQuit(message->IsChildPending() && message->GetChildMask(1) && !message->GetChildMask(0),
+                 "Message::GetChildMask failed\n");
+
+    // a second child, which needs a pooled mask when the child table exceeds 64 entries
+    SuccessOrQuit(message->SetChildMask(OPENTHREAD_CONFIG_MAX_CHILDREN - 1), "Message::SetChildMask failed\n");
+    VerifyOrQuit(message->GetChildMask(1) && message->GetChildMask(OPENTHREAD_CONFIG_MAX_CHILDREN - 1) &&
+                 !message->GetChildMask(0), "Message::GetChildMask failed\n");
+
+    message->ClearChildMask(1);
+    VerifyOrQuit(message->IsChildPending() && !message->GetChildMask(1), "Message::ClearChildMask failed\n");
+    message->ClearChildMask(OPENTHREAD_CONFIG_MAX_CHILDREN - 1);
+    VerifyOrQuit(!message->IsChildPending(), "Message::ClearChildMask failed\n");
+
+    SuccessOrQuit(Thread::Message::Free(*message), "Message::Free failed\n");
+
+#if OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+
+    // every message holds its own mask of all children
+    for (int i = 0; i <= OPENTHREAD_CONFIG_NUM_CHILD_MASKS; i++)
+    {
+        VerifyOrQuit((messages[i] = Thread::Message::New(Thread::Message::kTypeIp6, 0)) != NULL,
+                     "Message::New failed\n");
+
+        for (uint16_t child = 0; child < OPENTHREAD_CONFIG_MAX_CHILDREN; child++)
+        {
+            SuccessOrQuit(messages[i]->SetChildMask(child), "Message::SetChildMask failed\n");
+        }
+    }
+
+    for (int i = 0; i <= OPENTHREAD_CONFIG_NUM_CHILD_MASKS; i++)
+    {
+        for (uint16_t child = 0; child < OPENTHREAD_CONFIG_MAX_CHILDREN; child++)
+        {
+            VerifyOrQuit(messages[i]->GetChildMask(child), "Message::GetChildMask failed\n");
+            messages[i]->ClearChildMask(child);
+        }
+
+        VerifyOrQuit(!messages[i]->IsChildPending(), "Message::ClearChildMask failed\n");
+        SuccessOrQuit(Thread::Message::Free(*messages[i]), "Message::Free failed\n");
+    }
+
+#else  // OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+
+    // every pooled mask in use
+    for (int i = 0; i <= OPENTHREAD_CONFIG_NUM_CHILD_MASKS; i++)
+    {
+        VerifyOrQuit((messages[i] = Thread::Message::New(Thread::Message::kTypeIp6, 0)) != NULL,
+                     "Message::New failed\n");
+        SuccessOrQuit(messages[i]->SetChildMask(0), "Message::SetChildMask failed\n");
+        VerifyOrQuit(messages[i]->SetChildMask(1) ==
+                     (i < OPENTHREAD_CONFIG_NUM_CHILD_MASKS ? kThreadError_None : kThreadError_NoBufs),
+                     "Message::SetChildMask failed\n");
+    }
+
+    // freeing a message returns its mask to the pool
+    SuccessOrQuit(Thread::Message::Free(*messages[0]), "Message::Free failed\n");
+    SuccessOrQuit(messages[OPENTHREAD_CONFIG_NUM_CHILD_MASKS]->SetChildMask(1), "Message::SetChildMask failed\n");
+
+    for (int i = 1; i <= OPENTHREAD_CONFIG_NUM_CHILD_MASKS; i++)
+    {
+        SuccessOrQuit(Thread::Message::Free(*messages[i]), "Message::Free failed\n");
+    }
+
+#endif  // OPENTHREAD_CONFIG_MAX_CHILDREN <= 64
+}
+
 int main(void)
 {
     TestMessage();
+    TestMessageChildMask();
     printf("All tests passed\n");
     return 0;
 }
@@ -0,0 +1,735 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <string.h>
+#include <time.h>
+#include <new>
+
+#include <openthread.h>
+#include <cmdline.h>
+#include <common/message.hpp>
+#include <thread/mle_router.hpp>
+#include <thread/thread_netif.hpp>
+
+struct gengetopt_args_info args_info;
+
+extern"C" void otSignalTaskletPending(void)
+{
+}
+
+namespace Thread {
+namespace Mle {
+
+enum
+{
+    kNumRouters = 32,
+    kNumNeighbors = 8,
+    kNumAdvertisements = 256,
+    kNumRounds = 200,
+};
+
+/**
+ * This structure holds the routing state of one router id for the reference computation.
+ *
+ */
+struct ReferenceRoute
+{
+    bool    mAllocated;
+    bool    mValid;
+    uint8_t mLinkQualityIn;
+    uint8_t mLinkQualityOut;
+    uint8_t mNextHop;
+    uint8_t mCost;
+};
+
+class MleRouterTest
+{
+public:
+    explicit MleRouterTest(MleRouter &aMle): mMle(aMle) { }
+
+    void Init(uint8_t aRouterId, const uint8_t *aRouterIds, uint8_t aNumRouterIds, uint8_t aNumNeighbors);
+    void UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId) { mMle.UpdateRoutes(aRoute, aRouterId); }
+    void UpdateReferenceRoutes(const RouteTlv &aRoute, uint8_t aRouterId);
+    bool MatchesReference(void) const;
+    const Router &GetRouter(uint8_t aRouterId) const { return mMle.mRouters[aRouterId]; }
+    Child &GetChild(uint16_t aChildIndex) { return mMle.mChildren[aChildIndex]; }
+    Child *GetChild(const Ip6::Address &aAddress) { return mMle.GetChild(aAddress); }
+    Child *GetMtdChild(const Ip6::Address &aAddress) { return mMle.GetMtdChild(aAddress); }
+    ThreadError UpdateChildAddresses(const AddressRegistrationTlv &aTlv, Child &aChild) {
+        return mMle.UpdateChildAddresses(aTlv, aChild);
+    }
+    ThreadError AppendChildAddresses(Message &aMessage, Child &aChild) {
+        return mMle.AppendChildAddresses(aMessage, aChild);
+    }
+    void RemoveChildAddress(Child &aChild, uint8_t aIndex) { mMle.RemoveChildAddress(aChild, aIndex); }
+    Child *NewChild(void) { return mMle.NewChild(); }
+    Child *FindChild(const Mac::ExtAddress &aAddress) { return mMle.FindChild(aAddress); }
+    void AddChildToHash(Child &aChild) { mMle.AddChildToHash(aChild); }
+    void ClearChildTable(void);
+
+private:
+    static uint8_t LqiToCost(uint8_t aLqi);
+    uint8_t GetReferenceLinkCost(uint8_t aRouterId) const;
+
+    MleRouter &mMle;
+    uint8_t mRouterId;
+    ReferenceRoute mReference[kMaxRouterId];
+};
+
+void MleRouterTest::Init(uint8_t aRouterId, const uint8_t *aRouterIds, uint8_t aNumRouterIds, uint8_t aNumNeighbors)
+{
+    mRouterId = aRouterId;
+    mMle.mRouterId = aRouterId;
+    memset(mReference, 0, sizeof(mReference));
+
+    for (uint8_t i = 0; i < kMaxRouterId; i++)
+    {
+        Router &router = mMle.mRouters[i];
+
+        router.mAllocated = false;
+        router.mState = Neighbor::kStateInvalid;
+        router.mNextHop = kMaxRouterId;
+        router.mCost = 0;
+        router.mLinkQualityIn = 0;
+        router.mLinkQualityOut = 0;
+        mReference[i].mNextHop = kMaxRouterId;
+    }
+
+    // the routers following the first one are neighbors with varying link quality
+    for (uint8_t i = 0; i < aNumRouterIds; i++)
+    {
+        Router &router = mMle.mRouters[aRouterIds[i]];
+
+        router.mAllocated = true;
+        mReference[aRouterIds[i]].mAllocated = true;
+
+        if (aRouterIds[i] != aRouterId && i >= 1 && i <= aNumNeighbors)
+        {
+            router.mState = Neighbor::kStateValid;
+            router.mLinkQualityIn = 1 + (i % 3);
+            router.mLinkQualityOut = 1 + ((i + 1) % 3);
+            mReference[aRouterIds[i]].mValid = true;
+            mReference[aRouterIds[i]].mLinkQualityIn = router.mLinkQualityIn;
+            mReference[aRouterIds[i]].mLinkQualityOut = router.mLinkQualityOut;
+        }
+    }
+}
+
+void MleRouterTest::ClearChildTable(void)
+{
+    for (uint16_t i = 0; i < kMaxChildren; i++)
+    {
+        mMle.mChildren[i].mState = Neighbor::kStateInvalid;
+    }
+
+    mMle.ClearChildHash();
+}
+
+uint8_t MleRouterTest::LqiToCost(uint8_t aLqi)
+{
+    static const uint8_t kCosts[] = { kMaxRouteCost, 6, 2, 1 };
+    return kCosts[aLqi & 3];
+}
+
+uint8_t MleRouterTest::GetReferenceLinkCost(uint8_t aRouterId) const
+{
+    const ReferenceRoute &route = mReference[aRouterId];
+
+    if (aRouterId == mRouterId || aRouterId == kMaxRouterId || !route.mValid)
+    {
+        return kMaxRouteCost;
+    }
+
+    return LqiToCost(route.mLinkQualityIn < route.mLinkQualityOut ? route.mLinkQualityIn : route.mLinkQualityOut);
+}
+
+void MleRouterTest::UpdateReferenceRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
+{
+    bool update;
+
+    // the fixed-point loop that UpdateRoutes used to run: repeat full passes until no next hop changes
+    do
+    {
+        update = false;
+
+        for (uint8_t i = 0, routeCount = 0; i < kMaxRouterId; i++)
+        {
+            ReferenceRoute &route = mReference[i];
+            uint8_t oldNextHop = route.mNextHop;
+            uint8_t cost;
+            uint8_t newCost;
+
+            if (!aRoute.IsRouterIdSet(i))
+            {
+                continue;
+            }
+
+            if (!route.mAllocated)
+            {
+                routeCount++;
+                continue;
+            }
+
+            if (i == mRouterId)
+            {
+                if (mReference[aRouterId].mLinkQualityOut != aRoute.GetLinkQualityIn(routeCount))
+                {
+                    mReference[aRouterId].mLinkQualityOut = aRoute.GetLinkQualityIn(routeCount);
+                    update = true;
+                }
+
+                routeCount++;
+                continue;
+            }
+
+            cost = (i == aRouterId) ? 0 : aRoute.GetRouteCost(routeCount);
+
+            if (i != aRouterId && cost == 0)
+            {
+                cost = kMaxRouteCost;
+            }
+
+            newCost = cost + GetReferenceLinkCost(aRouterId);
+
+            if (route.mNextHop == kMaxRouterId || route.mNextHop == aRouterId)
+            {
+                if (i == aRouterId)
+                {
+                    route.mNextHop = aRouterId;
+                    route.mCost = 0;
+                }
+                else if (newCost <= kMaxRouteCost)
+                {
+                    route.mNextHop = aRouterId;
+                    route.mCost = cost;
+                }
+                else if (route.mNextHop != kMaxRouterId)
+                {
+                    route.mNextHop = kMaxRouterId;
+                    route.mCost = 0;
+                }
+            }
+            else if (newCost < route.mCost + GetReferenceLinkCost(route.mNextHop) ||
+                     (newCost == route.mCost + GetReferenceLinkCost(route.mNextHop) && i == aRouterId))
+            {
+                route.mNextHop = aRouterId;
+                route.mCost = cost;
+            }
+
+            update |= route.mNextHop != oldNextHop;
+            routeCount++;
+        }
+    }
+    while (update);
+}
+
+bool MleRouterTest::MatchesReference(void) const
+{
+    for (uint8_t i = 0; i < kMaxRouterId; i++)
+    {
+        const Router &router = mMle.mRouters[i];
+
+        if (router.mNextHop != mReference[i].mNextHop ||
+            (router.mNextHop != kMaxRouterId && router.mCost != mReference[i].mCost) ||
+            router.mLinkQualityOut != mReference[i].mLinkQualityOut)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace Mle
+}  // namespace Thread
+
+using namespace Thread;
+using namespace Thread::Mle;
+
+static uint8_t sThreadNetifRaw[sizeof(ThreadNetif)] __attribute__((aligned(8)));
+static RouteTlv sAdvertisements[kNumAdvertisements];
+static uint8_t sSources[kNumAdvertisements];
+static uint32_t sSeed = 1;
+
+static uint32_t GetRandom(void)
+{
+    // xorshift keeps the advertisements reproducible across runs
+    sSeed ^= sSeed << 13;
+    sSeed ^= sSeed >> 17;
+    sSeed ^= sSeed << 5;
+    return sSeed;
+}
+
+static void InitRouteTlv(RouteTlv &aRoute, const uint8_t *aRouterIds, uint8_t aNumRouterIds)
+{
+    aRoute.Init();
+    aRoute.ClearRouterIdMask();
+
+    for (uint8_t i = 0; i < aNumRouterIds; i++)
+    {
+        aRoute.SetRouterId(aRouterIds[i]);
+    }
+
+    aRoute.SetRouteDataLength(aNumRouterIds);
+}
+
+static void InitChildAddress(Ip6::Address &aAddress, uint16_t aPrefix, uint8_t aIid)
+{
+    memset(&aAddress, 0, sizeof(aAddress));
+    aAddress.m16[0] = HostSwap16(0x2001);
+    aAddress.m16[1] = HostSwap16(0x0db8);
+    aAddress.m16[2] = HostSwap16(aPrefix);
+    aAddress.m8[15] = aIid;
+}
+
+static void InitAddressRegistrationTlv(AddressRegistrationTlv &aTlv, const Ip6::Address *aAddresses,
+                                       uint8_t aNumAddresses)
+{
+    uint8_t *start = reinterpret_cast<uint8_t *>(&aTlv) + sizeof(Tlv);
+    uint8_t *cur = start;
+    AddressRegistrationEntry entry;
+
+    aTlv.Init();
+
+    for (uint8_t i = 0; i < aNumAddresses; i++)
+    {
+        entry.SetUncompressed();
+        entry.SetIp6Address(aAddresses[i]);
+        memcpy(cur, &entry, entry.GetLength());
+        cur += entry.GetLength();
+    }
+
+    aTlv.SetLength(static_cast<uint8_t>(cur - start));
+}
+
+static void InitChildExtAddress(Mac::ExtAddress &aAddress, uint16_t aChild)
+{
+    for (size_t i = 0; i < sizeof(aAddress.m8); i++)
+    {
+        aAddress.m8[i] = static_cast<uint8_t>(0x10 + i);
+    }
+
+    aAddress.m8[6] = static_cast<uint8_t>(aChild >> 8);
+    aAddress.m8[7] = static_cast<uint8_t>(aChild);
+}
+
+static double GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+void TestUpdateRoutesLine(MleRouterTest &aTest)
+{
+    // router 0 is us, 1 and 2 are neighbors and 3 is only reachable through them
+    const uint8_t routerIds[] = { 0, 1, 2, 3 };
+    RouteTlv route;
+
+    aTest.Init(0, routerIds, sizeof(routerIds), 2);
+
+    // neighbor 1 (link cost 2) reaches router 3 at cost 4 and hears us well
+    InitRouteTlv(route, routerIds, sizeof(routerIds));
+    route.SetLinkQualityIn(0, 3);
+    route.SetRouteCost(0, 2);
+    route.SetRouteCost(1, 0);
+    route.SetRouteCost(2, 1);
+    route.SetRouteCost(3, 4);
+    aTest.UpdateRoutes(route, 1);
+
+    VerifyOrQuit(aTest.GetRouter(1).mNextHop == 1 && aTest.GetRouter(1).mCost == 0,
+                 "UpdateRoutes did not route to the advertising neighbor directly\n");
+    VerifyOrQuit(aTest.GetRouter(3).mNextHop == 1 && aTest.GetRouter(3).mCost == 4,
+                 "UpdateRoutes did not learn the route through neighbor 1\n");
+
+    // neighbor 2 reaches router 3 at cost 1, but hears us poorly so its link costs 6
+    InitRouteTlv(route, routerIds, sizeof(routerIds));
+    route.SetLinkQualityIn(0, 1);
+    route.SetRouteCost(0, 6);
+    route.SetRouteCost(1, 1);
+    route.SetRouteCost(2, 0);
+    route.SetRouteCost(3, 1);
+    aTest.UpdateRoutes(route, 2);
+
+    VerifyOrQuit(aTest.GetRouter(3).mNextHop == 1 && aTest.GetRouter(3).mCost == 4,
+                 "UpdateRoutes switched to a more expensive route\n");
+
+    // neighbor 1 loses router 3, so the route times out rather than switching next hop
+    InitRouteTlv(route, routerIds, sizeof(routerIds));
+    route.SetLinkQualityIn(0, 3);
+    route.SetRouteCost(0, 2);
+    route.SetRouteCost(1, 0);
+    route.SetRouteCost(2, 1);
+    route.SetRouteCost(3, 0);
+    aTest.UpdateRoutes(route, 1);
+
+    VerifyOrQuit(aTest.GetRouter(3).mNextHop == kMaxRouterId, "UpdateRoutes kept a route the neighbor lost\n");
+
+    // neighbor 2 now provides the only route
+    InitRouteTlv(route, routerIds, sizeof(routerIds));
+    route.SetLinkQualityIn(0, 1);
+    route.SetRouteCost(0, 6);
+    route.SetRouteCost(1, 1);
+    route.SetRouteCost(2, 0);
+    route.SetRouteCost(3, 1);
+    aTest.UpdateRoutes(route, 2);
+
+    VerifyOrQuit(aTest.GetRouter(3).mNextHop == 2 && aTest.GetRouter(3).mCost == 1,
+                 "UpdateRoutes did not learn the remaining route\n");
+}
+
+void TestUpdateRoutesMatchesFixedPoint(MleRouterTest &aTest)
+{
+    uint8_t routerIds[kNumRouters];
+    double start;
+    double elapsed;
+
+    // spread 32 router ids over the id space with our own id first: the fixed-point loop evaluated routes listed
+    // before our own entry against the link cost from before the update, the single pass never does
+    for (uint8_t i = 0; i < kNumRouters; i++)
+    {
+        routerIds[i] = static_cast<uint8_t>(i * kMaxRouterId / kNumRouters);
+    }
+
+    aTest.Init(routerIds[0], routerIds, kNumRouters, kNumNeighbors);
+
+    for (int i = 0; i < kNumAdvertisements; i++)
+    {
+        RouteTlv &route = sAdvertisements[i];
+        uint8_t source = 1 + (i % kNumNeighbors);
+
+        sSources[i] = routerIds[source];
+        InitRouteTlv(route, routerIds, kNumRouters);
+
+        for (uint8_t j = 0; j < kNumRouters; j++)
+        {
+            route.SetRouteCost(j, (j == source) ? 0 : (GetRandom() % 16));
+            route.SetLinkQualityIn(j, GetRandom() % 4);
+            route.SetLinkQualityOut(j, GetRandom() % 4);
+        }
+    }
+
+    for (int i = 0; i < kNumAdvertisements; i++)
+    {
+        aTest.UpdateRoutes(sAdvertisements[i], sSources[i]);
+        aTest.UpdateReferenceRoutes(sAdvertisements[i], sSources[i]);
+        VerifyOrQuit(aTest.MatchesReference(), "UpdateRoutes differs from the fixed-point computation\n");
+    }
+
+    start = GetNanoseconds();
+
+    for (int i = 0; i < kNumRounds; i++)
+    {
+        for (int j = 0; j < kNumAdvertisements; j++)
+        {
+            aTest.UpdateRoutes(sAdvertisements[j], sSources[j]);
+        }
+    }
+
+    elapsed = (GetNanoseconds() - start) / (kNumRounds * kNumAdvertisements);
+
+    start = GetNanoseconds();
+
+    for (int i = 0; i < kNumRounds; i++)
+    {
+        for (int j = 0; j < kNumAdvertisements; j++)
+        {
+            aTest.UpdateReferenceRoutes(sAdvertisements[j], sSources[j]);
+        }
+    }
+
+    printf("%d routers: UpdateRoutes %.1f ns, fixed-point loop %.1f ns per advertisement\n", kNumRouters,
+           elapsed, (GetNanoseconds() - start) / (kNumRounds * kNumAdvertisements));
+}
+
+void TestChildAddressPrefixTableFull(MleRouterTest &aTest)
+{
+    Child &child0 = aTest.GetChild(0);
+    Child &child1 = aTest.GetChild(1);
+    AddressRegistrationTlv tlv;
+    Ip6::Address addresses[Child::kMaxIp6AddressPerChild];
+    Ip6::Address address;
+    Message *message;
+    uint16_t offset;
+    uint16_t length;
+
+    child0.mState = Neighbor::kStateValid;
+    child1.mState = Neighbor::kStateValid;
+
+    // child 0 uses every entry of the prefix table
+    for (uint8_t i = 0; i < kMaxChildPrefixes; i++)
+    {
+        InitChildAddress(addresses[i], i, 1);
+    }
+
+    InitAddressRegistrationTlv(tlv, addresses, kMaxChildPrefixes);
+    SuccessOrQuit(aTest.UpdateChildAddresses(tlv, child0), "UpdateChildAddresses failed\n");
+
+    // child 1 registers an address from a shared prefix and two from prefixes missing from the table
+    InitChildAddress(addresses[0], 0, 2);
+    InitChildAddress(addresses[1], kMaxChildPrefixes, 2);
+    InitChildAddress(addresses[2], kMaxChildPrefixes + 1, 2);
+    InitAddressRegistrationTlv(tlv, addresses, 3);
+    SuccessOrQuit(aTest.UpdateChildAddresses(tlv, child1), "UpdateChildAddresses failed\n");
+
+    for (uint8_t i = 0; i < kMaxChildPrefixes; i++)
+    {
+        InitChildAddress(address, i, 1);
+        VerifyOrQuit(aTest.GetChild(address) == &child0, "GetChild did not find a table prefix address\n");
+    }
+
+    VerifyOrQuit(aTest.GetChild(addresses[0]) == &child1, "GetChild did not find a table prefix address\n");
+    VerifyOrQuit(aTest.GetChild(addresses[1]) == &child1, "GetChild did not find a full address\n");
+
+    // a full address takes two entries, so the last address does not fit
+    VerifyOrQuit(aTest.GetChild(addresses[2]) == NULL, "GetChild found an address that does not fit\n");
+
+    InitChildAddress(address, kMaxChildPrefixes + 2, 2);
+    VerifyOrQuit(aTest.GetChild(address) == NULL, "GetChild matched a full address with another prefix\n");
+
+    // the full address is reported back uncompressed, behind more than 255 bytes of preceding TLVs
+    VerifyOrQuit((message = Message::New(Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    SuccessOrQuit(message->SetLength(300), "Message::SetLength failed\n");
+    SuccessOrQuit(message->SetOffset(300), "Message::SetOffset failed\n");
+    SuccessOrQuit(aTest.AppendChildAddresses(*message, child1), "AppendChildAddresses failed\n");
+    SuccessOrQuit(Tlv::GetValueOffset(*message, Tlv::kAddressRegistration, offset, length),
+                  "Address Registration TLV missing\n");
+    VerifyOrQuit(length == 2 * (1 + sizeof(Ip6::Address)), "AppendChildAddresses wrote wrong length\n");
+    message->Read(offset + 1 + sizeof(Ip6::Address) + 1, sizeof(address), &address);
+    VerifyOrQuit(memcmp(&address, &addresses[1], sizeof(address)) == 0, "AppendChildAddresses wrote wrong address\n");
+    Message::Free(*message);
+
+    aTest.RemoveChildAddress(child1, child1.FindIp6Address(Child::kInvalidPrefixId, addresses[1]));
+    VerifyOrQuit(aTest.GetChild(addresses[1]) == NULL, "RemoveChildAddress did not remove a full address\n");
+
+    for (uint8_t i = 0; i < Child::kMaxIp6AddressPerChild; i++)
+    {
+        VerifyOrQuit(child1.mIp6PrefixId[i] != Child::kPrefixEntryId &&
+                     child1.mIp6PrefixId[i] != Child::kFullAddressPrefixId,
+                     "RemoveChildAddress left a full address entry\n");
+    }
+
+    child0.mState = Neighbor::kStateInvalid;
+    child1.mState = Neighbor::kStateInvalid;
+}
+
+void TestChildAddressHash(MleRouterTest &aTest)
+{
+    Child &ffdChild = aTest.GetChild(0);
+    Child &mtdChild = aTest.GetChild(1);
+    AddressRegistrationTlv tlv;
+    Ip6::Address addresses[2];
+    Ip6::Address address;
+
+    aTest.ClearChildTable();
+
+    // every child registers its own address and a shared one, the FFD last so that it heads the shared chain
+    for (uint16_t i = kMaxChildren; i > 0; i--)
+    {
+        Child &child = aTest.GetChild(i - 1);
+
+        child.mState = Neighbor::kStateValid;
+        child.mMode = (&child == &mtdChild) ? 0 : ModeTlv::kModeFFD;
+        InitChildAddress(addresses[0], 0, static_cast<uint8_t>(i));
+        InitChildAddress(addresses[1], 0, 0xff);
+        InitAddressRegistrationTlv(tlv, addresses, 2);
+        SuccessOrQuit(aTest.UpdateChildAddresses(tlv, child), "UpdateChildAddresses failed\n");
+    }
+
+    for (uint16_t i = 0; i < kMaxChildren; i++)
+    {
+        InitChildAddress(address, 0, static_cast<uint8_t>(i + 1));
+        VerifyOrQuit(aTest.GetChild(address) == &aTest.GetChild(i), "GetChild did not find a child address\n");
+    }
+
+    InitChildAddress(address, 0, 0xff);
+    VerifyOrQuit(aTest.GetChild(address) == &ffdChild, "GetChild did not find the shared address\n");
+    VerifyOrQuit(aTest.GetMtdChild(address) == &mtdChild, "GetMtdChild did not pass over an FFD child\n");
+
+    InitChildAddress(address, 0, 1);
+    VerifyOrQuit(aTest.GetMtdChild(address) == NULL, "GetMtdChild returned an FFD child\n");
+
+    InitChildAddress(address, 0, 0xfe);
+    VerifyOrQuit(aTest.GetChild(address) == NULL, "GetChild found an unregistered address\n");
+
+    // an invalid child no longer answers for its addresses
+    mtdChild.mState = Neighbor::kStateInvalid;
+    InitChildAddress(address, 0, 0xff);
+    VerifyOrQuit(aTest.GetMtdChild(address) == NULL, "GetMtdChild returned an invalid child\n");
+
+    aTest.ClearChildTable();
+}
+
+void TestFrameCounterReservation(KeyManager &aKeyManager)
+{
+    // nothing is saved, so the frame counters are not limited
+    aKeyManager.ClearStoredFrameCounters();
+    aKeyManager.SetMacFrameCounter(100);
+    aKeyManager.SetMleFrameCounter(100);
+    SuccessOrQuit(aKeyManager.CheckMacFrameCounter(), "CheckMacFrameCounter failed without a saved value\n");
+    SuccessOrQuit(aKeyManager.CheckMleFrameCounter(), "CheckMleFrameCounter failed without a saved value\n");
+
+    // the saved values are the first ones that may not be used
+    aKeyManager.SetStoredFrameCounters(101, 102);
+    SuccessOrQuit(aKeyManager.CheckMacFrameCounter(), "CheckMacFrameCounter failed below the saved value\n");
+    aKeyManager.IncrementMacFrameCounter();
+    VerifyOrQuit(aKeyManager.CheckMacFrameCounter() == kThreadError_Busy,
+                 "CheckMacFrameCounter allowed the saved value\n");
+
+    aKeyManager.IncrementMleFrameCounter();
+    SuccessOrQuit(aKeyManager.CheckMleFrameCounter(), "CheckMleFrameCounter failed below the saved value\n");
+    aKeyManager.IncrementMleFrameCounter();
+    VerifyOrQuit(aKeyManager.CheckMleFrameCounter() == kThreadError_Busy,
+                 "CheckMleFrameCounter allowed the saved value\n");
+
+    // saving again releases the frame counters
+    aKeyManager.SetStoredFrameCounters(101 + KeyManager::kStoreFrameCounterAhead,
+                                       102 + KeyManager::kStoreFrameCounterAhead);
+    SuccessOrQuit(aKeyManager.CheckMacFrameCounter(), "CheckMacFrameCounter failed after saving\n");
+    SuccessOrQuit(aKeyManager.CheckMleFrameCounter(), "CheckMleFrameCounter failed after saving\n");
+
+    aKeyManager.ClearStoredFrameCounters();
+    aKeyManager.SetMacFrameCounter(0);
+    aKeyManager.SetMleFrameCounter(0);
+}
+
+static void AttachChildren(MleRouterTest &aTest, uint16_t aNumChildren)
+{
+    Mac::ExtAddress macAddr;
+    Child *child;
+
+    // the child table steps of a Parent Request followed by a Child ID Request, as for router id 0
+    for (uint16_t i = 0; i < aNumChildren; i++)
+    {
+        InitChildExtAddress(macAddr, i);
+        VerifyOrQuit((child = aTest.FindChild(macAddr)) != NULL || (child = aTest.NewChild()) != NULL,
+                     "NewChild failed\n");
+        memset(child, 0, sizeof(*child));
+        memcpy(&child->mMacAddr, &macAddr, sizeof(child->mMacAddr));
+        aTest.AddChildToHash(*child);
+        child->mValid.mRloc16 = i + 1;
+        child->mMode = ModeTlv::kModeFFD;
+        child->mState = Neighbor::kStateValid;
+    }
+}
+
+void TestChildTableBenchmark(MleRouterTest &aTest, Mle::MleRouter &aMle)
+{
+    static const uint16_t kNumChildren[] = { 32, 128, 256 };
+    Mac::ExtAddress macAddr;
+    double attach;
+    double poll;
+    double forward;
+    double start;
+
+    // every child resolves by extended address and RLOC16 in a full table
+    aTest.ClearChildTable();
+    AttachChildren(aTest, kMaxChildren);
+
+    for (uint16_t i = 0; i < kMaxChildren; i++)
+    {
+        InitChildExtAddress(macAddr, i);
+        VerifyOrQuit(aMle.GetChild(macAddr) == &aTest.GetChild(i), "GetChild(ExtAddress) found the wrong child\n");
+        VerifyOrQuit(aMle.GetChild(static_cast<uint16_t>(i + 1)) == &aTest.GetChild(i),
+                     "GetChild(Rloc16) found the wrong child\n");
+    }
+
+    // the table size is fixed at build time, e.g. CPPFLAGS=-DOPENTHREAD_CONFIG_MAX_CHILDREN=256 for every row
+    for (size_t n = 0; n < sizeof(kNumChildren) / sizeof(kNumChildren[0]); n++)
+    {
+        if (kNumChildren[n] > kMaxChildren)
+        {
+            printf("%d children: skipped, OPENTHREAD_CONFIG_MAX_CHILDREN is %d\n", kNumChildren[n], kMaxChildren);
+            continue;
+        }
+
+        attach = 0;
+
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            aTest.ClearChildTable();
+            start = GetNanoseconds();
+            AttachChildren(aTest, kNumChildren[n]);
+            attach += GetNanoseconds() - start;
+        }
+
+        start = GetNanoseconds();
+
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            for (uint16_t i = 0; i < kNumChildren[n]; i++)
+            {
+                InitChildExtAddress(macAddr, i);
+                VerifyOrQuit(aMle.GetChild(macAddr) != NULL, "GetChild(ExtAddress) failed\n");
+            }
+        }
+
+        poll = GetNanoseconds() - start;
+        start = GetNanoseconds();
+
+        for (int round = 0; round < kNumRounds; round++)
+        {
+            for (uint16_t i = 0; i < kNumChildren[n]; i++)
+            {
+                VerifyOrQuit(aMle.GetChild(static_cast<uint16_t>(i + 1)) != NULL, "GetChild(Rloc16) failed\n");
+            }
+        }
+
+        forward = GetNanoseconds() - start;
+
+        printf("%d children: attach %.1f ns, poll %.1f ns, forward %.1f ns per child\n", kNumChildren[n],
+               attach / (kNumRounds * kNumChildren[n]), poll / (kNumRounds * kNumChildren[n]),
+               forward / (kNumRounds * kNumChildren[n]));
+    }
+
+    aTest.ClearChildTable();
+}
+
+int main(void)
+{
+    ThreadNetif *netif;
+
+    Message::Init();
+    netif = new(sThreadNetifRaw) ThreadNetif;
+
+    MleRouterTest test(netif->GetMle());
+
+    TestUpdateRoutesLine(test);
+    TestUpdateRoutesMatchesFixedPoint(test);
+    TestChildAddressPrefixTableFull(test);
+    TestChildAddressHash(test);
+    TestChildTableBenchmark(test, netif->GetMle());
+    TestFrameCounterReservation(netif->GetKeyManager());
+
+    netif->~ThreadNetif();
+
+    printf("All tests passed\n");
+    return 0;
+}
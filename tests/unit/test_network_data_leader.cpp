@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.h"
+#include <string.h>
+#include <time.h>
+#include <new>
+
+#include <openthread.h>
+#include <cmdline.h>
+#include <common/message.hpp>
+#include <thread/network_data_leader.hpp>
+#include <thread/network_data_tlvs.hpp>
+#include <thread/thread_netif.hpp>
+
+using namespace Thread;
+using namespace Thread::NetworkData;
+
+enum
+{
+    kNumPrefixes = 16,
+    kNumBorderRouters = 8,
+    kNumIterations = 100000,
+};
+
+struct gengetopt_args_info args_info;
+
+extern"C" void otSignalTaskletPending(void)
+{
+}
+
+static uint8_t sThreadNetifRaw[sizeof(ThreadNetif)] __attribute__((aligned(8)));
+
+static uint16_t GetBorderRouterRloc16(int aPrefix)
+{
+    return static_cast<uint16_t>((aPrefix % kNumBorderRouters) << 10);
+}
+
+static uint16_t BuildNetworkData(uint8_t *aData)
+{
+    uint8_t prefix[4] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint16_t length = 0;
+    PrefixTlv *prefixTlv;
+    BorderRouterTlv *borderRouter;
+    BorderRouterEntry *entry;
+    ContextTlv *context;
+
+    // /32 prefixes, each with a default route from one of the border routers
+    for (int i = 0; i < kNumPrefixes; i++)
+    {
+        prefix[3] = static_cast<uint8_t>(0xb8 + i);
+        prefixTlv = reinterpret_cast<PrefixTlv *>(aData + length);
+        prefixTlv->Init(0, 32, prefix);
+
+        borderRouter = reinterpret_cast<BorderRouterTlv *>(prefixTlv->GetSubTlvs());
+        borderRouter->Init();
+        borderRouter->SetLength(sizeof(BorderRouterEntry));
+        entry = borderRouter->GetEntry(0);
+        entry->Init();
+        entry->SetRloc(GetBorderRouterRloc16(i));
+        entry->SetFlags(BorderRouterEntry::kPreferredFlag | BorderRouterEntry::kValidFlag |
+                        BorderRouterEntry::kDefaultRouteFlag);
+        prefixTlv->SetSubTlvsLength(sizeof(NetworkDataTlv) + borderRouter->GetLength());
+
+        // the last prefix also carries a 6LoWPAN context
+        if (i == kNumPrefixes - 1)
+        {
+            context = reinterpret_cast<ContextTlv *>(borderRouter->GetNext());
+            context->Init();
+            context->SetCompress();
+            context->SetContextId(1);
+            context->SetContextLength(32);
+            prefixTlv->SetSubTlvsLength(prefixTlv->GetSubTlvsLength() + sizeof(NetworkDataTlv) + context->GetLength());
+        }
+
+        length += sizeof(NetworkDataTlv) + prefixTlv->GetLength();
+    }
+
+    return length;
+}
+
+static double GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+void TestNetworkDataLookups(void)
+{
+    ThreadNetif *netif;
+    uint8_t data[Leader::kMaxSize];
+    uint16_t length;
+    Ip6::Address onMesh;
+    Ip6::Address offMesh;
+    Lowpan::Context context;
+    uint16_t rloc16;
+    volatile int sink = 0;
+    double start;
+    double isOnMeshMiss;
+    double isOnMeshHit;
+    double routeLookup;
+    double getContext;
+
+    Message::Init();
+    netif = new(sThreadNetifRaw) ThreadNetif;
+    Leader &leader = netif->GetNetworkDataLeader();
+
+    length = BuildNetworkData(data);
+    VerifyOrQuit(length <= sizeof(data), "BuildNetworkData overflowed\n");
+    leader.SetNetworkData(1, 1, false, data, length);
+
+    SuccessOrQuit(onMesh.FromString("2001:dc7::1"), "Ip6::Address::FromString failed\n");
+    SuccessOrQuit(offMesh.FromString("fd00::1"), "Ip6::Address::FromString failed\n");
+
+    // the lookups resolve against the last Prefix TLV, so the whole index is walked
+    VerifyOrQuit(leader.IsOnMesh(onMesh), "Leader::IsOnMesh missed an on-mesh prefix\n");
+    VerifyOrQuit(!leader.IsOnMesh(offMesh), "Leader::IsOnMesh matched an off-mesh address\n");
+
+    SuccessOrQuit(leader.RouteLookup(onMesh, offMesh, NULL, &rloc16), "Leader::RouteLookup failed\n");
+    VerifyOrQuit(rloc16 == GetBorderRouterRloc16(kNumPrefixes - 1), "Leader::RouteLookup chose the wrong border router\n");
+    VerifyOrQuit(leader.RouteLookup(offMesh, onMesh, NULL, &rloc16) == kThreadError_NoRoute,
+                 "Leader::RouteLookup routed an unknown source\n");
+
+    SuccessOrQuit(leader.GetContext(onMesh, context), "Leader::GetContext failed\n");
+    VerifyOrQuit(context.mContextId == 1 && context.mPrefixLength == 32, "Leader::GetContext returned the wrong context\n");
+    VerifyOrQuit(leader.GetContext(offMesh, context) != kThreadError_None,
+                 "Leader::GetContext matched an address without context\n");
+
+    // per-packet cost of the forwarding path lookups
+    start = GetNanoseconds();
+
+    for (int i = 0; i < kNumIterations; i++)
+    {
+        sink += leader.IsOnMesh(offMesh);
+    }
+
+    isOnMeshMiss = (GetNanoseconds() - start) / kNumIterations;
+    start = GetNanoseconds();
+
+    for (int i = 0; i < kNumIterations; i++)
+    {
+        sink += leader.IsOnMesh(onMesh);
+    }
+
+    isOnMeshHit = (GetNanoseconds() - start) / kNumIterations;
+    start = GetNanoseconds();
+
+    for (int i = 0; i < kNumIterations; i++)
+    {
+        sink += leader.RouteLookup(onMesh, offMesh, NULL, &rloc16);
+    }
+
+    routeLookup = (GetNanoseconds() - start) / kNumIterations;
+    start = GetNanoseconds();
+
+    for (int i = 0; i < kNumIterations; i++)
+    {
+        sink += leader.GetContext(onMesh, context);
+    }
+
+    getContext = (GetNanoseconds() - start) / kNumIterations;
+
+    printf("%d prefixes, %d border routers\n", kNumPrefixes, kNumBorderRouters);
+    printf("IsOnMesh (miss) %.1f ns\n", isOnMeshMiss);
+    printf("IsOnMesh (hit)  %.1f ns\n", isOnMeshHit);
+    printf("RouteLookup     %.1f ns\n", routeLookup);
+    printf("GetContext      %.1f ns\n", getContext);
+
+    netif->~ThreadNetif();
+}
+
+int main(void)
+{
+    TestNetworkDataLookups();
+    printf("All tests passed\n");
+    return 0;
+}
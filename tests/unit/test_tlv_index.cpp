@@ -0,0 +1,257 @@
+/*
+ *  Copyright (c) 2016, Nest Labs, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "test_util.h"
+#include <openthread.h>
+#include <common/debug.hpp>
+#include <common/message.hpp>
+#include <common/tlv_index.hpp>
+#include <thread/mle_tlvs.hpp>
+#include <platform/random.h>
+#include <string.h>
+
+extern"C" void otSignalTaskletPending(void)
+{
+}
+
+extern"C" uint32_t otPlatRandomGet(void)
+{
+    return random();
+}
+
+enum
+{
+    kNumTypes = 24,
+};
+
+static void AppendTlv(Thread::Message &aMessage, uint8_t aType, uint16_t aLength, bool aExtended)
+{
+    uint8_t header[4];
+    uint8_t headerLength;
+    uint8_t value = aType;
+
+    header[0] = aType;
+
+    if (!aExtended)
+    {
+        header[1] = static_cast<uint8_t>(aLength);
+        headerLength = 2;
+    }
+    else
+    {
+        header[1] = 255;
+        header[2] = static_cast<uint8_t>(aLength >> 8);
+        header[3] = static_cast<uint8_t>(aLength);
+        headerLength = 4;
+    }
+
+    SuccessOrQuit(aMessage.Append(header, headerLength), "Message::Append failed\n");
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        SuccessOrQuit(aMessage.Append(&value, sizeof(value)), "Message::Append failed\n");
+    }
+}
+
+void TestTlvIndex(void)
+{
+    Thread::Message *message;
+    Thread::TlvIndex index;
+    uint16_t offset;
+    uint16_t valueOffset;
+    uint16_t length;
+    uint16_t expected;
+    uint8_t value;
+
+    Thread::Message::Init();
+
+    VerifyOrQuit((message = Thread::Message::New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+
+    // leading byte that is not part of the TLVs
+    value = 0xff;
+    SuccessOrQuit(message->Append(&value, sizeof(value)), "Message::Append failed\n");
+    message->SetOffset(sizeof(value));
+
+    // more distinct types than the index holds, one of them extended and one repeated
+    for (uint8_t type = 0; type < kNumTypes; type++)
+    {
+        AppendTlv(*message, type, type == 5 ? 300 : type, type == 5);
+    }
+
+    AppendTlv(*message, 3, 7, false);
+
+    index.Init(*message, 5);
+    expected = sizeof(value);
+
+    for (uint8_t type = 0; type < kNumTypes; type++)
+    {
+        SuccessOrQuit(index.Find(type, offset, valueOffset, length), "TlvIndex::Find failed\n");
+        VerifyOrQuit(offset == expected, "TlvIndex::Find returned wrong offset\n");
+        VerifyOrQuit(length == (type == 5 ? 300 : type), "TlvIndex::Find returned wrong length\n");
+        VerifyOrQuit(valueOffset == offset + (type == 5 ? 4 : 2), "TlvIndex::Find returned wrong value offset\n");
+
+        SuccessOrQuit(Thread::TlvIndex::Find(*message, type, 5, offset, valueOffset, length),
+                      "TlvIndex::Find without index failed\n");
+        VerifyOrQuit(offset == expected, "TlvIndex::Find without index returned wrong offset\n");
+
+        if (length > 0)
+        {
+            message->Read(valueOffset + length - 1, sizeof(value), &value);
+            VerifyOrQuit(value == type, "TlvIndex::Find returned wrong value\n");
+        }
+
+        expected = valueOffset + length;
+    }
+
+    VerifyOrQuit(index.Find(kNumTypes, offset, valueOffset, length) == kThreadError_Parse,
+                 "TlvIndex::Find found missing TLV\n");
+
+    // a truncated TLV ends the index
+    SuccessOrQuit(message->SetLength(message->GetLength() - 3), "Message::SetLength failed\n");
+    index.Init(*message, 5);
+
+    SuccessOrQuit(index.Find(kNumTypes - 1, offset, valueOffset, length), "TlvIndex::Find failed\n");
+    VerifyOrQuit(index.Find(3, offset, valueOffset, length) == kThreadError_None && length == 3,
+                 "TlvIndex::Find did not return the first TLV\n");
+
+    SuccessOrQuit(message->SetLength(expected - 1), "Message::SetLength failed\n");
+    index.Init(*message, 5);
+
+    VerifyOrQuit(index.Find(kNumTypes - 1, offset, valueOffset, length) == kThreadError_Parse,
+                 "TlvIndex::Find accepted truncated TLV\n");
+
+    SuccessOrQuit(Thread::Message::Free(*message),
+                  "Message::Free failed\n");
+}
+
+void TestTlvIndexOneByteLength(void)
+{
+    Thread::Message *message;
+    Thread::TlvIndex index;
+    uint16_t offset;
+    uint16_t valueOffset;
+    uint16_t length;
+
+    VerifyOrQuit((message = Thread::Message::New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+
+    // a Length of 255 followed by a value that does not hold a valid 16-bit Length
+    AppendTlv(*message, 0xf0, 255, false);
+    AppendTlv(*message, 2, 4, false);
+
+    index.Init(*message);
+
+    SuccessOrQuit(index.Find(0xf0, offset, valueOffset, length), "TlvIndex::Find failed\n");
+    VerifyOrQuit(offset == 0 && valueOffset == 2 && length == 255,
+                 "TlvIndex::Find did not use the one-byte Length\n");
+    SuccessOrQuit(index.Find(2, offset, valueOffset, length), "TlvIndex::Find failed\n");
+    VerifyOrQuit(offset == 257 && length == 4, "TlvIndex::Find returned wrong offset\n");
+
+    SuccessOrQuit(Thread::TlvIndex::Find(*message, 2, offset, valueOffset, length),
+                  "TlvIndex::Find without index failed\n");
+    VerifyOrQuit(offset == 257 && length == 4, "TlvIndex::Find without index returned wrong offset\n");
+
+    // only the extended Type uses the extended Length
+    index.Init(*message, 2);
+    SuccessOrQuit(index.Find(2, offset, valueOffset, length), "TlvIndex::Find failed\n");
+    VerifyOrQuit(offset == 257 && length == 4, "TlvIndex::Find returned wrong offset\n");
+
+    index.Init(*message, 0xf0);
+    VerifyOrQuit(index.Find(0xf0, offset, valueOffset, length) == kThreadError_Parse,
+                 "TlvIndex::Find accepted invalid extended Length\n");
+
+    SuccessOrQuit(Thread::Message::Free(*message),
+                  "Message::Free failed\n");
+}
+
+void TestMleTlvMaxLength(void)
+{
+    Thread::Message *message;
+    Thread::TlvIndex index;
+    uint8_t value[255];
+    uint8_t header[2];
+    uint16_t offset;
+    uint16_t length;
+
+    VerifyOrQuit((message = Thread::Message::New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+
+    for (uint16_t i = 0; i < sizeof(value); i++)
+    {
+        value[i] = static_cast<uint8_t>(i);
+    }
+
+    SuccessOrQuit(Thread::Mle::Tlv::Append(*message, Thread::Mle::Tlv::kNetworkData, value, sizeof(value)),
+                  "Tlv::Append failed\n");
+    SuccessOrQuit(Thread::Mle::Tlv::Append(*message, Thread::Mle::Tlv::kRoute, value, sizeof(value)),
+                  "Tlv::Append failed\n");
+    VerifyOrQuit(Thread::Mle::Tlv::Append(*message, Thread::Mle::Tlv::kRoute, value, sizeof(value) + 1) ==
+                 kThreadError_InvalidArgs, "Tlv::Append accepted a Length over 255\n");
+
+    message->Read(0, sizeof(header), header);
+    VerifyOrQuit(header[0] == Thread::Mle::Tlv::kNetworkData && header[1] == 255, "Tlv::Append wrote wrong header\n");
+
+#if OPENTHREAD_CONFIG_NETWORK_DATA_MAX_SIZE > 255
+    VerifyOrQuit(message->GetLength() == 4 + sizeof(value) + 2 + sizeof(value),
+                 "Tlv::Append did not use the extended Length\n");
+#else
+    VerifyOrQuit(message->GetLength() == 2 + sizeof(value) + 2 + sizeof(value),
+                 "Tlv::Append used the extended Length\n");
+#endif
+
+    Thread::Mle::Tlv::InitIndex(index, *message);
+
+    SuccessOrQuit(Thread::Mle::Tlv::GetValueOffset(index, Thread::Mle::Tlv::kNetworkData, offset, length),
+                  "Tlv::GetValueOffset failed\n");
+    VerifyOrQuit(length == sizeof(value), "Tlv::GetValueOffset returned wrong length\n");
+
+    for (uint16_t i = 0; i < sizeof(value); i++)
+    {
+        uint8_t byte;
+
+        message->Read(offset + i, sizeof(byte), &byte);
+        VerifyOrQuit(byte == value[i], "Tlv::GetValueOffset returned wrong value\n");
+    }
+
+    SuccessOrQuit(Thread::Mle::Tlv::GetValueOffset(*message, Thread::Mle::Tlv::kRoute, offset, length),
+                  "Tlv::GetValueOffset failed\n");
+    VerifyOrQuit(length == sizeof(value) && offset == message->GetLength() - sizeof(value),
+                 "Tlv::GetValueOffset returned wrong offset\n");
+
+    SuccessOrQuit(Thread::Message::Free(*message),
+                  "Message::Free failed\n");
+}
+
+int main(void)
+{
+    TestTlvIndex();
+    TestTlvIndexOneByteLength();
+    TestMleTlvMaxLength();
+    printf("All tests passed\n");
+    return 0;
+}